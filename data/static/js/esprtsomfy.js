@@ -5,6 +5,7 @@ endpointRemoteCreate = () => baseUrl + "api/v1/remotes";
 endpointRemoteUpdate = (remoteId) => baseUrl + `api/v1/remotes/${remoteId}`;
 endpointRemoteDelete = (remoteId) => baseUrl + `api/v1/remotes/${remoteId}`;
 endpointRemoteAction = (remoteId) => baseUrl + `api/v1/remotes/${remoteId}/action`;
+endpointEvents = () => baseUrl + "api/v1/events";
 
 endpointNetworksFetch = () => baseUrl + "api/v1/wifi/networks";
 endpointNetworkFetch = () => baseUrl + "api/v1/wifi/config";
@@ -69,6 +70,43 @@ function loadRemotes() {
     getRequest(endpointRemotesFetch(), onRemotesFetched);
 }
 
+function reloadRemotes() {
+    document.getElementById("blind-list").innerHTML = "";
+    loadRemotes();
+}
+
+function subscribeEvents() {
+    const source = new EventSource(endpointEvents());
+    source.addEventListener("remote", onRemoteChanged);
+    source.addEventListener("resync", reloadRemotes);
+}
+
+function onRemoteChanged(event) {
+    const change = JSON.parse(event.data);
+    const remoteElements = document.querySelectorAll('.remote-element[data-remote-id="' + change.id + '"]');
+
+    if (change.created) {
+        if (remoteElements.length === 0) {
+            reloadRemotes();
+        }
+        return;
+    }
+
+    remoteElements.forEach(element => {
+        if (change.deleted) {
+            element.parentNode.removeChild(element);
+            return;
+        }
+        if (change.rolling_code !== undefined) {
+            element.dataset.remoteRollingCode = change.rolling_code;
+        }
+        if (change.name !== undefined && element.dataset.remoteName !== change.name) {
+            element.dataset.remoteName = change.name;
+            element.querySelector("p").textContent = change.name;
+        }
+    });
+}
+
 function onRemotesFetched(data) {
     remoteListEl = document.getElementById("blind-list");
     for (const element of data) {
@@ -113,8 +151,6 @@ function initRemoteActionButtons() {
 
             let payload = { action: action };
             request(endpointRemoteAction(remoteId), "POST", payload); // TODO on fail
-
-            containerEl.dataset.remoteRollingCode = parseInt(containerEl.dataset.remoteRollingCode) + 1;
         });
     });
 }
@@ -188,6 +224,9 @@ function onNewRemoteFormSubmited() {
     let payload = { name: remoteName };
 
     request(endpointRemoteCreate(), "POST", payload, (data) => {
+        if (document.querySelector('.remote-element[data-remote-id="' + data.id + '"]')) {
+            return; // Already added by the events
+        }
         remoteListEl = document.getElementById("blind-list");
         remoteListEl.innerHTML += `
         <div class="table-row remote-element" data-remote-id="${data.id}" data-remote-rolling-code="${data.rolling_code}" data-remote-name="${data.name}">
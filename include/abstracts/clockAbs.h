@@ -0,0 +1,39 @@
+/**
+ * @file clockAbs.h
+ * @author Laurette Alexandre
+ * @brief Header of Clock abstraction.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <time.h>
+
+class ClockAbstract
+{
+  public:
+  virtual time_t now() = 0; // UTC epoch, lower than MIN_VALID_TIME while not synced
+  virtual void setTimezone(const char* timezone) = 0;
+  virtual void toLocalTime(const time_t& time, struct tm& local) = 0;
+  virtual time_t fromLocalTime(struct tm& local) = 0;
+};
@@ -28,6 +28,8 @@
 #pragma once
 
 #include <remote.h>
+#include <scene.h>
+#include <schedule.h>
 #include <networks.h>
 #include <mqttConfig.h>
 #include <systemInfos.h>
@@ -50,6 +52,21 @@ class DatabaseAbstract
   virtual bool updateRemote(const Remote& remote) = 0;
   virtual bool deleteRemote(const unsigned long& id) = 0;
 
+  // CRUD methods for scene
+  virtual Scene createScene(const Scene& scene) = 0;
+  virtual void getAllScenes(Scene scenes[]) = 0;
+  virtual Scene getScene(const unsigned short& id) = 0;
+  virtual bool deleteScene(const unsigned short& id) = 0;
+
+  // CRUD methods for schedule
+  virtual Schedule createSchedule(const Schedule& schedule) = 0;
+  virtual void getAllSchedules(Schedule schedules[]) = 0;
+  virtual Schedule getSchedule(const unsigned short& id) = 0;
+  virtual bool deleteSchedule(const unsigned short& id) = 0;
+
+  virtual Location getLocation() = 0;
+  virtual bool setLocation(const Location& location) = 0;
+
   virtual MQTTConfiguration getMQTTConfiguration() = 0;
   virtual bool setMQTTConfiguration(const MQTTConfiguration& mqttConfig) = 0;
 };
\ No newline at end of file
@@ -0,0 +1,49 @@
+/**
+ * @file mqttConnectionAbs.h
+ * @author Laurette Alexandre
+ * @brief Interface of the connection to the MQTT broker.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+typedef void (*MQTTReceiveCallback)(const char* topic, uint8_t* payload, uint32_t length);
+
+class MQTTConnectionAbstract
+{
+  public:
+  // The broker is not copied, it must outlive the connection
+  virtual void begin(const char* broker, const uint16_t port, MQTTReceiveCallback callback) = 0;
+  virtual bool isNetworkConnected() = 0; // The WiFi, the broker cannot be reached without it
+  virtual bool connect(const char* clientId, const char* username, const char* password) = 0;
+  virtual bool isConnected() = 0;
+  virtual int getState() = 0;
+  virtual void loop() = 0; // Calls back with the messages received
+  virtual bool subscribe(const char* filter) = 0;
+  virtual bool publish(const char* topic, const char* payload, const bool retained) = 0;
+  // The payload is written in the returned stream, nullptr if the publish cannot start
+  virtual Print* beginPublish(const char* topic, const size_t length, const bool retained) = 0;
+  virtual bool endPublish() = 0;
+};
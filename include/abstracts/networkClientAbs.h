@@ -38,5 +38,8 @@ class NetworkClientAbstract
   virtual String getMacAddress() = 0;
   virtual bool isConnected() = 0;
   virtual void scanNetworks() = 0;
+  virtual NetworkScan startScan() = 0;
+  virtual bool handleScan() = 0; // true when the networks of a scan are available
+  virtual NetworkScan getScan() = 0;
   virtual void getNetworks(Network networks[]) = 0;
 };
\ No newline at end of file
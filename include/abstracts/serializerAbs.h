@@ -29,9 +29,17 @@
 
 #include <Arduino.h>
 #include <remote.h>
+#include <remoteState.h>
+#include <scene.h>
+#include <event.h>
+#include <command.h>
+#include <schedule.h>
+#include <batch.h>
 #include <networks.h>
 #include <mqttConfig.h>
 #include <systemInfos.h>
+#include <loadStats.h>
+#include <update.h>
 
 class SerializerAbstract
 {
@@ -39,9 +47,32 @@ class SerializerAbstract
   virtual String serializeMessage(const char* message) = 0;
   virtual String serializeRemote(const Remote& remote) = 0;
   virtual String serializeRemotes(const Remote remotes[], int size) = 0;
+  virtual void serializeRemotes(Print& output, const Remote remotes[], int size) = 0;
+  virtual size_t serializeRemoteState(const RemoteState& state, char* output, size_t size) = 0;
+  virtual void serializeRemotesInventory(Print& output, const Remote remotes[], int size) = 0;
   virtual String serializeNetworkConfig(const NetworkConfiguration& networkConfig) = 0;
   virtual String serializeNetworks(const Network networks[], int size) = 0;
+  virtual void serializeNetworks(Print& output, const Network networks[], int size) = 0;
+  virtual String serializeNetworkScan(const NetworkScan& scan) = 0;
   virtual String serializeSystemInfos(const SystemInfos& infos) = 0;
   virtual String serializeSystemInfos(const SystemInfosExtended& infos) = 0;
+  virtual String serializeLoadStats(const LoadStats& stats) = 0;
+  virtual String serializeUpdateProgress(const UpdateProgress& progress) = 0;
   virtual String serializeMQTTConfig(const MQTTConfiguration& mqttConfig) = 0;
+  virtual String serializeScene(const Scene& scene) = 0;
+  virtual String serializeScenes(const Scene scenes[], int size) = 0;
+  virtual void serializeScenes(Print& output, const Scene scenes[], int size) = 0;
+  virtual String serializeBatchReport(const BatchReport& report) = 0;
+  virtual String serializeCommand(const Command& command) = 0;
+  virtual String serializeRemoteChange(const RemoteChange& change) = 0;
+  virtual String serializeSchedule(const Schedule& schedule) = 0;
+  virtual String serializeSchedules(const Schedule schedules[], int size) = 0;
+  virtual void serializeSchedules(Print& output, const Schedule schedules[], int size) = 0;
+  virtual String serializeLocation(const Location& location) = 0;
+  virtual void serializeBatchResponse(Print& output, const BatchResponse& response) = 0;
+
+  virtual bool deserializeCommandRequest(const char* input, CommandRequest& request) = 0;
+  virtual bool deserializeFields(const char* input, BodyFields& fields) = 0;
+  virtual int deserializeBatchRequests(
+      const char* input, int size, BatchRequestCallback callback) = 0;
 };
\ No newline at end of file
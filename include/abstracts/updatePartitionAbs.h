@@ -0,0 +1,42 @@
+/**
+ * @file updatePartitionAbs.h
+ * @author Laurette Alexandre
+ * @brief Interface of the flash partition receiving an update.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <update.h>
+
+class UpdatePartitionAbstract
+{
+  public:
+  virtual bool begin(const UpdateTarget target, const size_t size) = 0;
+  virtual size_t write(const uint8_t* data, const size_t length) = 0;
+  virtual bool end() = 0; // The image is installed at the next boot
+  virtual void abort() = 0; // The current image is kept
+};
@@ -0,0 +1,72 @@
+/**
+ * @file admissionControl.h
+ * @author Laurette Alexandre
+ * @brief Header of the admission control of the web server.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <stdint.h>
+
+enum class RequestPriority : uint8_t
+{
+  NORMAL, // Listings and static files
+  COMMAND, // Changes of the state, ie: an action on a remote
+};
+
+enum class Admission : uint8_t
+{
+  ADMITTED,
+  SHED_LIMIT, // Too many requests in flight
+  SHED_HEAP, // Not enough free heap
+};
+
+/**
+ * @brief Decide if the server can afford one more request. A request counts as in flight from
+ * its admission until release, so bursts are refused instead of exhausting the heap. Commands
+ * are shed last: they have reserved slots and a lower heap watermark.
+ *
+ */
+class AdmissionControl
+{
+  public:
+  AdmissionControl(const uint8_t maxInFlight, const uint8_t reservedForCommands,
+      const uint32_t minFreeHeap, const uint32_t minFreeHeapForCommands);
+
+  Admission admit(const RequestPriority priority, const uint32_t freeHeap);
+  void release();
+
+  uint8_t getInFlight() const;
+  uint32_t getShedByLimit() const;
+  uint32_t getShedByHeap() const;
+
+  private:
+  const uint8_t m_maxInFlight;
+  const uint8_t m_reservedForCommands;
+  const uint32_t m_minFreeHeap;
+  const uint32_t m_minFreeHeapForCommands;
+  uint8_t m_inFlight = 0;
+  uint32_t m_shedByLimit = 0; // Since boot
+  uint32_t m_shedByHeap = 0; // Since boot
+};
@@ -0,0 +1,50 @@
+/**
+ * @file admissionHandler.h
+ * @author Laurette Alexandre
+ * @brief Header of the web handler refusing requests the server cannot afford.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <ESPAsyncWebServer.h>
+
+#include <admissionControl.h>
+
+/**
+ * @brief First handler of the server. It lets admitted requests through to the next handlers and
+ * answers the shed ones with a 503 and a Retry-After.
+ *
+ */
+class AdmissionHandler : public AsyncWebHandler
+{
+  public:
+  AdmissionHandler(AdmissionControl& admission);
+
+  bool canHandle(AsyncWebServerRequest* request) override;
+  void handleRequest(AsyncWebServerRequest* request) override;
+  bool isRequestHandlerTrivial() override { return true; } // The body of a shed request is skipped
+
+  private:
+  AdmissionControl& m_admission;
+};
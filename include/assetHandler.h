@@ -0,0 +1,80 @@
+/**
+ * @file assetHandler.h
+ * @author Laurette Alexandre
+ * @brief Header of the handler of the pre-compressed static assets.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <FS.h>
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+
+#include <config.h>
+
+/**
+ * @brief An asset compiled into the firmware by scripts/build_assets.py, see embeddedAssets.h.
+ *
+ */
+struct EmbeddedAsset
+{
+  const char* path;
+  const char* etag;
+  const char* contentType;
+  unsigned long maxAge;
+  const uint8_t* content; // Gzipped, in flash (PROGMEM)
+  size_t length;
+};
+
+struct Asset
+{
+  char path[MAX_ASSET_PATH_LENGTH]; // ie: /static/js/esprtsomfy.1a2b3c4d.js
+  char etag[MAX_ETAG_LENGTH];       // Quoted hash of the uncompressed content
+  unsigned long maxAge;             // Seconds, 0 to revalidate each time
+  const EmbeddedAsset* embedded;    // nullptr if the asset is in the filesystem
+};
+
+/**
+ * @brief Serve the gzipped assets listed in the manifest, or embedded in the firmware. Every
+ * response has a strong ETag, so the browser revalidates with If-None-Match and gets a 304
+ * without reading the filesystem. Content-hashed assets never change and are cached for a year.
+ *
+ */
+class AssetHandler : public AsyncWebHandler
+{
+  public:
+  AssetHandler(fs::FS& fs);
+  unsigned short load(const char* manifestPath);
+  unsigned short load(const EmbeddedAsset assets[], const unsigned short size);
+
+  bool canHandle(AsyncWebServerRequest* request) override;
+  void handleRequest(AsyncWebServerRequest* request) override;
+
+  private:
+  fs::FS& m_fs;
+  Asset m_assets[MAX_ASSETS];
+  unsigned short m_size = 0;
+
+  const Asset* find(const String& url);
+};
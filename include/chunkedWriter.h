@@ -0,0 +1,58 @@
+/**
+ * @file chunkedWriter.h
+ * @author Laurette Alexandre
+ * @brief Header for ChunkedWriter.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <functional>
+
+#include <Arduino.h>
+
+/**
+ * @brief The body of a chunked response, written item by item as the client acknowledges the
+ * chunks. Only the item being sent is held in RAM, whatever the length of the body.
+ *
+ */
+class ChunkedWriter
+{
+  public:
+  // Writes an item of the body, returns false past the last one
+  typedef std::function<bool(Print& output, const uint8_t item)> ItemWriter;
+  // Serializes an element of a listing, an empty String for an empty slot
+  typedef std::function<String(const uint8_t index)> ElementSerializer;
+
+  ChunkedWriter(); // An empty body
+  ChunkedWriter(ItemWriter writer);
+  static ChunkedWriter jsonArray(const uint8_t size, ElementSerializer serializer);
+
+  size_t fill(uint8_t* buffer, const size_t maxLength);
+
+  private:
+  ItemWriter m_writer;
+  uint8_t m_item = 0;
+  String m_pending; // The item being sent
+  size_t m_offset = 0;
+};
@@ -28,12 +28,52 @@
 #pragma once
 
 const char APP_NAME[] = "ESP-RTSomfy";
-const char FIRMWARE_VERSION[] = "2.1.1";
+const char FIRMWARE_VERSION[] = "2.2.0";
 
 const char AP_SSID[] = "ESP-RTSomfy Fallback Hotspot";
 const char AP_PASSWORD[] = "5cKErSRCyQzy";
 
 const unsigned short SERVER_PORT = 80;
+// Web clients listening to /api/v1/events
+const unsigned short MAX_EVENT_CLIENTS = 4;
+// Above this average of messages waiting per client, changes are not pushed anymore. The
+// clients are asked to reload the remotes once they caught up.
+const unsigned short MAX_EVENT_CLIENT_PENDING = 8;
+// Static assets listed by the manifest of scripts/build_assets.py
+const char ASSETS_MANIFEST[] = "/assets.manifest";
+const unsigned short MAX_ASSETS = 8;
+const unsigned short MAX_ASSET_PATH_LENGTH = 48;
+const unsigned short MAX_ETAG_LENGTH = 19; // 16 hex chars between quotes + 1 (\0)
+// Larger application/json bodies are refused with 413
+const unsigned short MAX_JSON_BODY_SIZE = 2048;
+const unsigned short MAX_BODY_FIELDS = 8; // Read from a JSON body, the next ones are ignored
+const unsigned short MAX_BATCH_REQUESTS = 16; // Sub-requests of POST /api/v1/batch
+const unsigned short MAX_BATCH_METHOD_LENGTH = 8; // "DELETE" + 1 (\0)
+const unsigned short MAX_BATCH_PATH_LENGTH = 48;
+// Admission control of the web server. Listings and static files are refused first, commands
+// (POST, PUT, PATCH and DELETE) keep extra slots and a lower heap watermark.
+const unsigned short MAX_IN_FLIGHT_REQUESTS = 4;
+const unsigned short RESERVED_COMMAND_REQUESTS = 2; // In flight above MAX_IN_FLIGHT_REQUESTS
+const unsigned long MIN_FREE_HEAP = 12288; // Bytes, below it only commands are served
+const unsigned long MIN_FREE_HEAP_COMMAND = 6144; // Bytes, below it nothing is served
+const unsigned short SHED_RETRY_AFTER_SECONDS = 2; // Retry-After of the 503
+
+// A boot is confirmed once the main loop ran this long. After MAX_FAILED_BOOTS boots in a row
+// without confirmation, the firmware starts in safe mode: access point and OTA only.
+const unsigned long BOOT_CONFIRM_DELAY_MS = 30000;
+const unsigned short MAX_FAILED_BOOTS = 3;
+// An update receiving no chunk for this long is aborted by the next one
+const unsigned long OTA_IDLE_TIMEOUT_MS = 30000;
+// Credentials of the uploads to /api/v1/ota, asked with HTTP digest authentication. The password
+// comes from the ESPRTSOMFY_OTA_PASSWORD environment variable at build time (see platformio.ini),
+// the firmware does not build without it: the SHA-256 is given by the uploader, it proves the
+// image is intact, not who sent it, and the uploads are all the safe mode serves.
+#ifndef ESPRTSOMFY_OTA_PASSWORD
+#define ESPRTSOMFY_OTA_PASSWORD ""
+#endif
+const char OTA_USERNAME[] = "admin";
+const char OTA_PASSWORD[] = ESPRTSOMFY_OTA_PASSWORD;
+const char OTA_REALM[] = "esprtsomfy";
 
 const unsigned short MAX_NETWORK_SCAN = 15;
 
@@ -44,4 +84,61 @@ const unsigned short MAX_REMOTE_NAME_LENGTH = 17;  // 16 chars + 1 (\0)
 const unsigned short MAX_REMOTES = 16;
 const unsigned long REMOTE_BASE_ADDRESS = 0x100000;
 
-const unsigned short DEFAULT_MQTT_PORT = 1883;
\ No newline at end of file
+// Warning: Increase these values will take more space in the database.
+const unsigned short MAX_SCENE_NAME_LENGTH = 17; // 16 chars + 1 (\0)
+const unsigned short MAX_SCENES = 8;
+const unsigned short MAX_BATCH_OPERATIONS = 16; // Also the max operations stored in a scene
+const unsigned short MAX_SCHEDULES = 32;
+const unsigned short MAX_CRON_LENGTH = 24; // "minute hour day month weekday" + 1 (\0)
+const unsigned short MAX_TIMEZONE_LENGTH = 41; // POSIX TZ string + 1 (\0)
+
+const char NTP_SERVER[] = "pool.ntp.org";
+const char DEFAULT_TIMEZONE[] = "UTC0";
+const unsigned long MIN_VALID_TIME = 1700000000; // Before this epoch, the clock is not synced yet
+
+// Submitted commands kept in RAM, pending ones and the last completed ones. A full batch of
+// actions fits in the queue.
+const unsigned short MAX_COMMANDS = MAX_BATCH_REQUESTS;
+// Identical commands on the same remote within this window are sent only once. The window of a
+// new remote, each remote can change its own. 0 to disable.
+const unsigned short DEFAULT_DEDUP_WINDOW_MS = 1000;
+const unsigned short MAX_IDEMPOTENCY_KEY_LENGTH = 37; // An UUID + 1 (\0)
+
+// Events waiting to be delivered from the main loop. Must be a power of 2.
+const unsigned short EVENT_BUS_CAPACITY = 32;
+
+const unsigned short DEFAULT_MQTT_PORT = 1883;
+const unsigned short MAX_MQTT_PAYLOAD_LENGTH = 256; // Incoming payloads, including \0
+// Wait between two connection attempts to the broker, doubled after each failure
+const unsigned long MQTT_RECONNECT_MIN_DELAY_MS = 1000;
+const unsigned long MQTT_RECONNECT_MAX_DELAY_MS = 60000;
+// Bound each blocking step of a connection attempt, well below the watchdog: the DNS lookup of the
+// broker (only until it is resolved), the TCP connection, then the CONNACK, in seconds as
+// PubSubClient counts it. An attempt blocks the loop at most 2 s, 1.5 s once resolved.
+const unsigned short MQTT_DNS_TIMEOUT_MS = 500;
+const unsigned short MQTT_CONNECT_TIMEOUT_MS = 500;
+const unsigned short MQTT_CONNACK_TIMEOUT_S = 1;
+// Messages kept while disconnected from the broker, in bytes: each message takes the length of
+// its topic and its payload. The retained states keep the last value of each topic, about 50 bytes
+// per field of a remote. The events (acks, last actions) are all kept, about 200 bytes per ack.
+const unsigned short MQTT_OUTBOX_STATES_SIZE = 1024;
+const unsigned short MQTT_OUTBOX_EVENTS_SIZE = 1024;
+// Outgoing topics, including \0. The longest is a metric: esprtsomfy/system/metrics/<name>
+const unsigned short MAX_MQTT_TOPIC_LENGTH = 72;
+// The longest discovery config and a failed command ack with its timings fit, including \0
+const unsigned short MAX_MQTT_OUTBOX_PAYLOAD_LENGTH = 300;
+// When a queue of the outbox is full: true drops its oldest messages, false refuses the new one
+const bool MQTT_OUTBOX_DROP_OLDEST = true;
+// After a reconnection, the state then the outbox are published at most one message per interval
+const unsigned long MQTT_OUTBOX_DRAIN_INTERVAL_MS = 20;
+// Packets sent and received by PubSubClient, a discovery config fits
+const unsigned short MQTT_BUFFER_SIZE = 512;
+// One retained JSON state per remote on esprtsomfy/remotes/<id>/state and the list of the remotes
+// on esprtsomfy/remotes, instead of a topic per field
+const bool MQTT_JSON_STATE = false;
+// Home Assistant MQTT discovery, one retained config per remote
+const bool HOME_ASSISTANT_DISCOVERY = true;
+const char HOME_ASSISTANT_DISCOVERY_PREFIX[] = "homeassistant";
+const unsigned short MAX_DISCOVERY_PAYLOAD_LENGTH = 400; // Including \0
+// Metrics summary published on esprtsomfy/system/metrics/<name>. 0 to disable.
+const unsigned long METRICS_PUBLISH_INTERVAL_MS = 0;
\ No newline at end of file
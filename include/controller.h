@@ -28,14 +28,18 @@
 #pragma once
 
 #include <result.h>
-#include <observer.h>
+#include <scene.h>
+#include <command.h>
+#include <schedule.h>
+#include <eventBus.h>
+#include <remoteAction.h>
 #include <databaseAbs.h>
 #include <serializerAbs.h>
 #include <transmitterAbs.h>
 #include <systemManagerAbs.h>
 #include <networkClientAbs.h>
 
-class Controller : public Subject
+class Controller : public EventBus
 {
   public:
   Controller(DatabaseAbstract* database, NetworkClientAbstract* networkClient, TransmitterAbstract* transmitter, SystemManagerAbstract* systemManager);
@@ -47,10 +51,36 @@ class Controller : public Subject
   Result<Remote[MAX_REMOTES]> fetchAllRemotes();
   Result<Remote> createRemote(const char* name);
   Result<Remote> deleteRemote(const unsigned long id);
-  Result<Remote> updateRemote(const unsigned long id, const char* name, const unsigned int rollingCode);
+  Result<Remote> updateRemote(const unsigned long id, const char* name,
+      const unsigned int rollingCode, const long dedupWindow = DEDUP_WINDOW_UNCHANGED);
   Result<String> operateRemote(const unsigned long id, const char* action);
+  Result<String> operateRemote(const unsigned long id, const RemoteAction action);
+  Result<BatchReport> operateBatch(const RemoteOperation operations[], const unsigned short size);
+
+  Result<Command> submitCommand(
+      const unsigned long id, const RemoteAction action, const char* idempotencyKey = nullptr);
+  Result<Command> fetchCommand(const unsigned long requestId);
+  void handleCommands();
+
+  Result<Scene[MAX_SCENES]> fetchAllScenes();
+  Result<Scene> createScene(
+      const char* name, const RemoteOperation operations[], const unsigned short size);
+  Result<Scene> deleteScene(const unsigned short id);
+  Result<BatchReport> operateScene(const unsigned short id);
+
+  Result<Schedule[MAX_SCHEDULES]> fetchAllSchedules();
+  Result<Schedule> createSchedule(const unsigned long remoteId, const RemoteAction action,
+      const ScheduleTrigger trigger, const short offset, const char* cron);
+  Result<Schedule> deleteSchedule(const unsigned short id);
+  Result<Location> fetchLocation();
+  Result<Location> updateLocation(const float latitude, const float longitude, const char* timezone);
+  unsigned long getSchedulesRevision();
+  unsigned long getStateVersion();
 
   Result<Network[MAX_NETWORK_SCAN]> fetchScannedNetworks();
+  Result<NetworkScan> scanNetworks();
+  Result<NetworkScan> fetchNetworkScan();
+  void handleNetworkScan();
   Result<NetworkConfiguration> fetchNetworkConfiguration();
   Result<NetworkConfiguration> updateNetworkConfiguration(const char* ssid, const char* password);
 
@@ -62,4 +92,20 @@ class Controller : public Subject
   NetworkClientAbstract* m_networkClient;
   TransmitterAbstract* m_transmitter;
   SystemManagerAbstract* m_systemManager;
+
+  // Ring of submitted commands, indexed by requestId % MAX_COMMANDS. Commands from
+  // m_nextExecutedId to m_nextRequestId - 1 are pending, the others are completed.
+  Command m_commands[MAX_COMMANDS] = {};
+  unsigned long m_nextRequestId = 1;
+  unsigned long m_nextExecutedId = 1;
+  unsigned long m_suppressedCommands = 0;
+  unsigned long m_schedulesRevision = 0; // Incremented on each change of schedules or location
+  unsigned long m_stateVersion = 0; // Incremented on each change visible through the API
+
+  const Command* findLastCommand(const unsigned long remoteId);
+  const Command* findCommand(const char* idempotencyKey);
+  Command& enqueueCommand(const unsigned long remoteId, const RemoteAction action);
+  String checkOperations(
+      const RemoteOperation operations[], const unsigned short size, const Remote remotes[]);
+  Result<String> sendAction(Remote& remote, const RemoteAction action, CommandTimings& timings);
 };
\ No newline at end of file
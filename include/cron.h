@@ -0,0 +1,55 @@
+/**
+ * @file cron.h
+ * @author Laurette Alexandre
+ * @brief Parsing of schedule rules: cron expressions and triggers.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <time.h>
+#include <Arduino.h>
+
+#include <schedule.h>
+
+const uint32_t CRON_ALL_DAYS = 0xFFFFFFFE; // 1 to 31
+const uint8_t CRON_ALL_WEEKDAYS = 0x7F; // 0 (sunday) to 6
+
+/**
+ * @brief A cron expression "minute hour day month weekday" parsed as one bit per allowed value.
+ * Each field accepts *, a value, a range (1-5), a step (0-30/10, 5/15) and lists of them.
+ */
+struct CronMasks
+{
+  uint64_t minutes; // 0 to 59
+  uint32_t hours; // 0 to 23
+  uint32_t days; // 1 to 31
+  uint16_t months; // 1 to 12
+  uint8_t weekdays; // 0 (sunday) to 6, 7 is also accepted for sunday
+};
+
+bool parseCronExpression(const char* expression, CronMasks& masks);
+bool cronMatchesDay(const CronMasks& masks, const struct tm& local);
+
+ScheduleTrigger parseScheduleTrigger(const char* name);
+const char* getScheduleTriggerName(const ScheduleTrigger trigger);
@@ -0,0 +1,106 @@
+/**
+ * @file batch.h
+ * @author Laurette Alexandre
+ * @brief Structures of the sub-requests of a batch.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <functional>
+
+#include <Arduino.h>
+
+#include <config.h>
+
+/**
+ * @brief The fields of a JSON object body, parsed once per request. Strings are kept as is, other
+ * values as JSON, ie: 42 gives "42" and true gives "true", so they read as form params.
+ *
+ */
+struct BodyFields
+{
+  uint8_t size = 0;
+  String names[MAX_BODY_FIELDS];
+  String values[MAX_BODY_FIELDS];
+
+  bool get(const char* name, String& value) const
+  {
+    for (uint8_t i = 0; i < this->size; i++)
+    {
+      if (this->names[i] == name)
+      {
+        value = this->values[i];
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Replace the field, or add it if there is room left
+  bool set(const char* name, const String& value)
+  {
+    for (uint8_t i = 0; i < this->size; i++)
+    {
+      if (this->names[i] == name)
+      {
+        this->values[i] = value;
+        return true;
+      }
+    }
+    if (this->size == MAX_BODY_FIELDS)
+    {
+      return false;
+    }
+    this->names[this->size] = name;
+    this->values[this->size++] = value;
+    return true;
+  }
+};
+
+/**
+ * @brief A sub-request of POST /api/v1/batch, ie:
+ * {"method":"PATCH","path":"/api/v1/remotes/1","body":{"name":"foo"}}
+ *
+ */
+struct BatchRequest
+{
+  char method[MAX_BATCH_METHOD_LENGTH];
+  char path[MAX_BATCH_PATH_LENGTH];
+  BodyFields body; // Empty if not provided
+};
+
+/**
+ * @brief The result of a request of the REST API. A sub-request of a batch gets the same result
+ * as it would have alone.
+ *
+ */
+struct BatchResponse
+{
+  unsigned short status;
+  String body; // JSON
+  String location; // The Location header, empty if none. Not part of a batch response.
+};
+
+// Runs a sub-request as soon as it is read, the next ones are read after it
+typedef std::function<void(const BatchRequest& request)> BatchRequestCallback;
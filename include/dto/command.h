@@ -0,0 +1,92 @@
+/**
+ * @file command.h
+ * @author Laurette Alexandre
+ * @brief Definition of an asynchronous command operated on a remote.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <config.h>
+#include <remoteAction.h>
+
+enum class CommandStatus : uint8_t
+{
+  PENDING = 0,
+  DONE,
+  FAILED,
+};
+
+enum class CommandError : uint8_t
+{
+  NONE = 0,
+  INVALID_PAYLOAD, // The request cannot be parsed
+  INVALID_REMOTE, // No remote id
+  INVALID_ACTION,
+  REMOTE_NOT_FOUND,
+  INVALID_IDEMPOTENCY_KEY, // Too long
+  IDEMPOTENCY_CONFLICT, // The key is used by another command
+  QUEUE_FULL,
+  COMMIT_FAILED, // Sent, but the rolling code is not saved
+};
+
+/**
+ * @brief Where the time of an executed command went, in microseconds.
+ *
+ */
+struct CommandTimings
+{
+  uint32_t queue; // From the submission to the execution
+  uint32_t transmit; // The RTS frames
+  uint32_t commit; // The rolling code saved in EEPROM
+  uint32_t total; // From the submission to the completion
+};
+
+/**
+ * @brief A command submitted on a remote. It is queued and executed later by the controller,
+ * its request id allows to follow it until completion. It is not stored in the database.
+ *
+ */
+struct Command
+{
+  unsigned long requestId;
+  unsigned long remoteId;
+  RemoteAction action;
+  CommandStatus status;
+  unsigned int rollingCode; // Rolling code of the remote once the command is done
+  unsigned long submittedAt; // millis()
+  char idempotencyKey[MAX_IDEMPOTENCY_KEY_LENGTH]; // Empty if not provided by the client
+  CommandError error; // Why the command was refused or failed
+  uint32_t submittedAtMicros; // micros(), for the timings
+  CommandTimings timings; // Once done or failed
+};
+
+/**
+ * @brief A command as requested by a client, before it is submitted.
+ *
+ */
+struct CommandRequest
+{
+  RemoteAction action;
+  char idempotencyKey[MAX_IDEMPOTENCY_KEY_LENGTH];
+};
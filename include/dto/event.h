@@ -0,0 +1,77 @@
+/**
+ * @file event.h
+ * @author Laurette Alexandre
+ * @brief Definition of the events delivered by the event bus.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <remote.h>
+#include <command.h>
+#include <remoteAction.h>
+
+enum class EventType : uint8_t
+{
+  REMOTE = 0, // A remote was created, updated, deleted or operated. Coalesced per remote.
+  COMMAND, // A queued command is completed
+};
+
+// Filters of the subscribers, one bit per EventType
+const uint8_t EVENT_FILTER_REMOTE = 1 << static_cast<uint8_t>(EventType::REMOTE);
+const uint8_t EVENT_FILTER_COMMAND = 1 << static_cast<uint8_t>(EventType::COMMAND);
+const uint8_t EVENT_FILTER_ALL = 0xFF;
+
+// Fields of a remote changed by an event, one bit each
+const uint8_t REMOTE_CHANGE_CREATED = 1 << 0;
+const uint8_t REMOTE_CHANGE_DELETED = 1 << 1;
+const uint8_t REMOTE_CHANGE_NAME = 1 << 2;
+const uint8_t REMOTE_CHANGE_ROLLING_CODE = 1 << 3;
+const uint8_t REMOTE_CHANGE_LAST_ACTION = 1 << 4;
+const uint8_t REMOTE_CHANGE_DEDUP_WINDOW = 1 << 5;
+
+/**
+ * @brief A delta on the state of a remote. Only the fields flagged in changes are meaningful for
+ * subscribers, the other ones are only the current state.
+ *
+ */
+struct RemoteChange
+{
+  uint8_t changes;
+  RemoteAction lastAction; // With REMOTE_CHANGE_LAST_ACTION
+  Remote remote; // State of the remote after the changes
+};
+
+/**
+ * @brief An event published by the controller. The payload depends on the type.
+ *
+ */
+struct Event
+{
+  EventType type;
+  union
+  {
+    RemoteChange remote; // EventType::REMOTE
+    Command command; // EventType::COMMAND
+  };
+};
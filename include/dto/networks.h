@@ -33,6 +33,19 @@ struct Network
   int RSSI;
 };
 
+/**
+ * @brief The state of the scan of the networks. The networks of the last scan are kept until the
+ * next one is done.
+ *
+ */
+struct NetworkScan
+{
+  bool scanning; // A scan is running in the background
+  bool scanned; // The networks of a scan are available
+  unsigned long age; // Seconds since the end of the last scan
+  unsigned short count; // Networks found by the last scan
+};
+
 struct NetworkConfiguration
 {
   char ssid[33];
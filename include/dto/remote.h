@@ -34,4 +34,9 @@ struct Remote
   unsigned long id;
   unsigned int rollingCode;
   char name[MAX_REMOTE_NAME_LENGTH];
+  // Milliseconds, the same command repeated within it is sent once. 0 disables it. It fits in the
+  // padding after the name, so the remotes keep their place in the database.
+  unsigned short dedupWindow;
 };
+
+const long DEDUP_WINDOW_UNCHANGED = -1; // For an update keeping the window of the remote
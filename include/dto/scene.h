@@ -0,0 +1,56 @@
+/**
+ * @file scene.h
+ * @author Laurette Alexandre
+ * @brief Header for Scene and Batch DTO.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <config.h>
+#include <remote.h>
+#include <remoteAction.h>
+
+/**
+ * @brief A named list of operations, stored in the database.
+ *
+ */
+struct Scene
+{
+  unsigned short id;
+  char name[MAX_SCENE_NAME_LENGTH];
+  unsigned short size;
+  RemoteOperation operations[MAX_BATCH_OPERATIONS];
+};
+
+/**
+ * @brief Outcome of a batch. Each operation is queued as a command, its request id allows to
+ * follow it until completion. It is not stored in the database.
+ *
+ */
+struct BatchReport
+{
+  unsigned short size;
+  RemoteOperation operations[MAX_BATCH_OPERATIONS];
+  unsigned long requestIds[MAX_BATCH_OPERATIONS];
+};
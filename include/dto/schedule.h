@@ -0,0 +1,65 @@
+/**
+ * @file schedule.h
+ * @author Laurette Alexandre
+ * @brief Definition of schedules and of the location used for sun events.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <config.h>
+#include <remoteAction.h>
+
+enum class ScheduleTrigger : uint8_t
+{
+  TIME = 0, // At the minute and hour of the cron expression
+  SUNRISE, // At sunrise + offset, on the days of the cron expression
+  SUNSET, // At sunset + offset, on the days of the cron expression
+  UNKNOWN,
+};
+
+/**
+ * @brief A command operated on a remote at a given time, stored in the database.
+ *
+ */
+struct Schedule
+{
+  unsigned short id;
+  unsigned long remoteId;
+  RemoteAction action;
+  ScheduleTrigger trigger;
+  short offset; // Minutes, only for sun events
+  char cron[MAX_CRON_LENGTH]; // "minute hour day month weekday"
+};
+
+/**
+ * @brief Location of the device, stored in the database. It is used to compute sun events and to
+ * convert schedules to local time.
+ *
+ */
+struct Location
+{
+  float latitude;
+  float longitude;
+  char timezone[MAX_TIMEZONE_LENGTH]; // POSIX TZ, ie: CET-1CEST,M3.5.0,M10.5.0/3
+};
@@ -48,4 +48,5 @@ struct SystemInfosExtended
   char version[8]; // Allow x.xx.xx
   String macAddress;
   String ipAddress;
+  unsigned long suppressedCommands; // Duplicated commands not sent since boot
 };
\ No newline at end of file
@@ -0,0 +1,57 @@
+/**
+ * @file update.h
+ * @author Laurette Alexandre
+ * @brief Firmware and filesystem updates.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+enum class UpdateTarget : uint8_t
+{
+  FIRMWARE,
+  FILESYSTEM, // The LittleFS image
+};
+
+enum class UpdateState : uint8_t
+{
+  IDLE,
+  RUNNING,
+  DONE, // Installed at the next boot
+  FAILED,
+};
+
+/**
+ * @brief UpdateProgress struct reports the running or the last update.
+ *
+ */
+struct UpdateProgress
+{
+  UpdateTarget target;
+  UpdateState state;
+  size_t written; // Bytes
+  size_t total; // Bytes announced when it began, an upper bound for a multipart upload
+};
@@ -31,6 +31,8 @@
 
 #include <networks.h>
 #include <remote.h>
+#include <scene.h>
+#include <schedule.h>
 #include <mqttConfig.h>
 #include <systemInfos.h>
 #include <databaseAbs.h>
@@ -58,6 +60,22 @@ class EEPROMDatabase : public DatabaseAbstract
   bool updateRemote(const Remote& remote);
   bool deleteRemote(const unsigned long& id);
 
+  // Scenes CRUD
+  Scene createScene(const Scene& scene);
+  void getAllScenes(Scene scenes[]);
+  Scene getScene(const unsigned short& id);
+  bool deleteScene(const unsigned short& id);
+
+  // Schedules CRUD
+  Schedule createSchedule(const Schedule& schedule);
+  void getAllSchedules(Schedule schedules[]);
+  Schedule getSchedule(const unsigned short& id);
+  bool deleteSchedule(const unsigned short& id);
+
+  // Location
+  Location getLocation();
+  bool setLocation(const Location& location);
+
   // MQTT Configuration
   MQTTConfiguration getMQTTConfiguration();
   bool setMQTTConfiguration(const MQTTConfiguration& mqttConfig);
@@ -67,12 +85,22 @@ class EEPROMDatabase : public DatabaseAbstract
   int m_networkConfigAddressStart = sizeof(SystemInfos);
   int m_mqttConfigAddressStart = sizeof(SystemInfos) + sizeof(NetworkConfiguration);
   int m_remotesAddressStart = sizeof(SystemInfos) + sizeof(NetworkConfiguration) + sizeof(MQTTConfiguration);
+  int m_scenesAddressStart = m_remotesAddressStart + sizeof(Remote) * MAX_REMOTES;
+  int m_locationAddressStart = m_scenesAddressStart + sizeof(Scene) * MAX_SCENES;
+  int m_schedulesAddressStart = m_locationAddressStart + sizeof(Location);
+  int m_endAddress = m_schedulesAddressStart + sizeof(Schedule) * MAX_SCHEDULES;
   unsigned long m_remoteBaseAddress = REMOTE_BASE_ADDRESS;
 
   bool migrate();
+  bool commit();
   bool stringIsAscii(const char* data);
   int getRemoteIndex(const unsigned long& id);
+  bool sceneIsValid(const Scene& scene, const unsigned short& index);
+  bool scheduleIsValid(const Schedule& schedule, const unsigned short& index);
+  bool locationIsValid(const Location& location);
+  bool versionIsLower(const char* version, const char* reference);
 
   // Migrations
   void applyUpdate_2_1_0();
+  void applyUpdate_2_2_0();
 };
\ No newline at end of file
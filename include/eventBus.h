@@ -0,0 +1,88 @@
+/**
+ * @file eventBus.h
+ * @author Laurette Alexandre
+ * @brief Header for the event bus.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <atomic>
+#include <Arduino.h>
+
+#include <event.h>
+#include <config.h>
+#include <remote.h>
+#include <command.h>
+#include <remoteAction.h>
+
+/**
+ * @brief Receive the events of an EventBus. Events are delivered from the main loop, never from
+ * the context which published them.
+ *
+ */
+class EventSubscriber
+{
+  public:
+  virtual void notified(const Event& event) = 0;
+
+  private:
+  friend class EventBus;
+  EventSubscriber* m_nextSubscriber = nullptr;
+  uint8_t m_eventFilter = 0;
+};
+
+/**
+ * @brief Events are queued in a fixed ring buffer and delivered later by dispatchEvents().
+ * The ring is lock-free for one producer and one consumer: only publish() writes the head and
+ * only dispatchEvents() writes the tail. When the ring is full, new events are dropped.
+ * All the changes of a remote queued between two dispatches are merged into a single delta.
+ *
+ */
+class EventBus
+{
+  public:
+  void subscribe(EventSubscriber* subscriber, const uint8_t filter = EVENT_FILTER_ALL);
+  void unsubscribe(EventSubscriber* subscriber);
+  bool publish(const Event& event);
+  bool publish(const RemoteChange& change);
+  bool publish(const Command& command);
+  void dispatchEvents();
+  unsigned long getDroppedEvents();
+
+  private:
+  static_assert((EVENT_BUS_CAPACITY & (EVENT_BUS_CAPACITY - 1)) == 0,
+      "EVENT_BUS_CAPACITY must be a power of 2.");
+
+  Event m_events[EVENT_BUS_CAPACITY];
+  std::atomic<uint16_t> m_head { 0 }; // Next event to write, free running
+  std::atomic<uint16_t> m_tail { 0 }; // Next event to read, free running
+  EventSubscriber* m_subscribers = nullptr;
+  unsigned long m_droppedEvents = 0;
+  RemoteChange m_changes[MAX_REMOTES]; // Remote changes being coalesced by dispatchEvents()
+  unsigned short m_changesCount = 0;
+
+  void deliver(const Event& event);
+  void coalesce(const RemoteChange& change);
+  void flushChanges();
+};
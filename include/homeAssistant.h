@@ -1,11 +1,11 @@
 /**
- * @file observer.h
+ * @file homeAssistant.h
  * @author Laurette Alexandre
- * @brief Header for Observer pattern.
- * @version 2.1.1
- * @date 2024-06-06
+ * @brief Header for the Home Assistant MQTT discovery.
+ * @version 2.2.0
+ * @date 2026-10-19
  *
- * @copyright (c) 2024 Laurette Alexandre
+ * @copyright (c) 2026 Laurette Alexandre
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -27,23 +27,13 @@
  */
 #pragma once
 
-#include <Arduino.h>
+#include <stddef.h>
 
 #include <remote.h>
 
-class Observer
-{
-  public:
-  virtual void notified(const char* action, const Remote& remote) = 0;
-};
+const unsigned short MAX_DEVICE_ID_LENGTH = 24; // esprtsomfy_ + 12 hex digits + 1 (\0)
 
-class Subject
-{
-  public:
-  void attach(Observer* observer);
-  void deattach(Observer* observer);
-  void notify(const char* action, const Remote& remote);
-
-  private:
-  Observer* m_observers[2] = { nullptr, nullptr }; // Allow only 2 observers (MQTT and WebServer)
-};
\ No newline at end of file
+void formatDeviceId(char* deviceId, const char* macAddress);
+size_t formatCoverDiscoveryTopic(char* topic, const size_t size, const unsigned long remoteId);
+size_t writeCoverDiscovery(
+    char* buffer, const size_t size, const Remote& remote, const char* deviceId);
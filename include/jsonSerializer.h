@@ -31,8 +31,16 @@
 #include <ArduinoJson.h>
 
 #include <remote.h>
+#include <remoteState.h>
+#include <scene.h>
+#include <event.h>
+#include <command.h>
+#include <schedule.h>
+#include <batch.h>
 #include <networks.h>
 #include <systemInfos.h>
+#include <loadStats.h>
+#include <update.h>
 #include <serializerAbs.h>
 
 class JSONSerializer : public SerializerAbstract
@@ -41,12 +49,37 @@ class JSONSerializer : public SerializerAbstract
   String serializeMessage(const char* message);
   String serializeRemote(const Remote& remote);
   String serializeRemotes(const Remote remotes[], int size);
+  void serializeRemotes(Print& output, const Remote remotes[], int size);
+  size_t serializeRemoteState(const RemoteState& state, char* output, size_t size);
+  void serializeRemotesInventory(Print& output, const Remote remotes[], int size);
   String serializeNetworkConfig(const NetworkConfiguration& networkConfig);
   String serializeNetworks(const Network networks[], int size);
+  void serializeNetworks(Print& output, const Network networks[], int size);
+  String serializeNetworkScan(const NetworkScan& scan);
   String serializeSystemInfos(const SystemInfos& infos);
   String serializeSystemInfos(const SystemInfosExtended& infos);
+  String serializeLoadStats(const LoadStats& stats);
+  String serializeUpdateProgress(const UpdateProgress& progress);
   String serializeMQTTConfig(const MQTTConfiguration& mqttConfig);
+  String serializeScene(const Scene& scene);
+  String serializeScenes(const Scene scenes[], int size);
+  void serializeScenes(Print& output, const Scene scenes[], int size);
+  String serializeBatchReport(const BatchReport& report);
+  String serializeCommand(const Command& command);
+  String serializeRemoteChange(const RemoteChange& change);
+  String serializeSchedule(const Schedule& schedule);
+  String serializeSchedules(const Schedule schedules[], int size);
+  void serializeSchedules(Print& output, const Schedule schedules[], int size);
+  String serializeLocation(const Location& location);
+  void serializeBatchResponse(Print& output, const BatchResponse& response);
+
+  bool deserializeCommandRequest(const char* input, CommandRequest& request);
+  bool deserializeFields(const char* input, BodyFields& fields);
+  int deserializeBatchRequests(const char* input, int size, BatchRequestCallback callback);
 
   private:
   void serializeRemote(JsonObject object, const Remote& remote);
+  void serializeScene(JsonObject object, const Scene& scene);
+  void serializeSchedule(JsonObject object, const Schedule& schedule);
+  void deserializeFields(JsonObjectConst object, BodyFields& fields);
 };
\ No newline at end of file
@@ -0,0 +1,129 @@
+/**
+ * @file metrics.h
+ * @author Laurette Alexandre
+ * @brief Header of the metrics recorded in static memory.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+const uint8_t METRIC_BUCKETS = 7; // The last one is +Inf
+
+/**
+ * @brief Durations in fixed buckets, each one counts the durations up to its bound.
+ *
+ */
+struct Histogram
+{
+  uint32_t buckets[METRIC_BUCKETS] = {}; // Not cumulative
+  uint32_t count = 0;
+  uint64_t sum = 0; // Microseconds
+
+  void observe(const uint32_t duration);
+};
+
+enum class HistogramId : uint8_t
+{
+  COMMAND, // A queued command, from its execution to its completion published
+  TRANSMIT, // The RTS frames of a command
+  DATABASE_COMMIT,
+  MQTT_PUBLISH,
+  COUNT,
+};
+
+enum class CounterId : uint8_t
+{
+  COMMANDS_DONE,
+  COMMANDS_FAILED,
+  DATABASE_COMMIT_FAILURES,
+  MQTT_MESSAGES_RECEIVED,
+  MQTT_PUBLISH_FAILURES,
+  MQTT_CONNECT_FAILURES,
+  MQTT_RECONNECTS, // Connections recovered after a loss
+  MQTT_DISCONNECTED_SECONDS, // Time to recover, summed over the reconnections
+  MQTT_OUTBOX_COMPACTED, // Messages replaced by a newer value of their topic
+  MQTT_OUTBOX_DROPPED, // Messages lost because the outbox was full
+  COUNT,
+};
+
+enum class GaugeId : uint8_t
+{
+  MQTT_OUTBOX_DEPTH,
+  COUNT,
+};
+
+/**
+ * @brief Registry of the histograms, counters and gauges, in static memory. Recording is a few integer
+ * operations, so it stays enabled in production builds.
+ *
+ */
+class Metrics
+{
+  public:
+  static void observe(const HistogramId id, const uint32_t duration);
+  static void increment(const CounterId id);
+  static void add(const CounterId id, const uint32_t value);
+  static void set(const GaugeId id, const uint32_t value);
+  static const Histogram& getHistogram(const HistogramId id);
+  static uint32_t getCounter(const CounterId id);
+  static uint32_t getGauge(const GaugeId id);
+  static const char* getName(const HistogramId id);
+  static const char* getName(const CounterId id);
+  static const char* getName(const GaugeId id);
+  static void reset();
+
+  // Each histogram, counter and gauge is an item of the output, so it can be written by parts.
+  static const uint8_t ITEMS = static_cast<uint8_t>(HistogramId::COUNT)
+      + static_cast<uint8_t>(CounterId::COUNT) + static_cast<uint8_t>(GaugeId::COUNT);
+  static void write(Print& output, const uint8_t item);
+  static void writeHistogram(
+      Print& output, const char* name, const char* labels, const Histogram& histogram);
+  static void writeCounter(Print& output, const char* name, const uint32_t value);
+  static void writeGauge(Print& output, const char* name, const uint32_t value);
+
+  private:
+  static Histogram m_histograms[static_cast<uint8_t>(HistogramId::COUNT)];
+  static uint32_t m_counters[static_cast<uint8_t>(CounterId::COUNT)];
+  static uint32_t m_gauges[static_cast<uint8_t>(GaugeId::COUNT)];
+};
+
+/**
+ * @brief Observe the duration of a scope, ie: `MetricTimer timer(HistogramId::TRANSMIT);`
+ *
+ */
+class MetricTimer
+{
+  public:
+  MetricTimer(const HistogramId id)
+      : m_id(id)
+      , m_start(micros())
+  {
+  }
+  ~MetricTimer() { Metrics::observe(this->m_id, micros() - this->m_start); }
+
+  private:
+  const HistogramId m_id;
+  const uint32_t m_start;
+};
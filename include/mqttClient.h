@@ -28,32 +28,84 @@
 #pragma once
 
 #include <Arduino.h>
-#include <PubSubClient.h>
 
 #include <remote.h>
-#include <observer.h>
+#include <remoteState.h>
+#include <scene.h>
+#include <command.h>
+#include <event.h>
+#include <eventBus.h>
 #include <controller.h>
+#include <clockAbs.h>
 #include <mqttConfig.h>
+#include <mqttOutbox.h>
+#include <homeAssistant.h>
+#include <reconnectBackoff.h>
 #include <serializerAbs.h>
+#include <mqttConnectionAbs.h>
 
 void callback(char* topic, byte* payload, unsigned int length);
 
-class MQTTClient : public Observer
+// The retained state published again after a connection, one message at a time
+enum class RepublishStep : uint8_t
+{
+  VERSION,
+  MAC,
+  IP,
+  REMOTE_STATE, // Its JSON state, or its rolling code
+  REMOTE_NAME,
+  REMOTE_DISCOVERY,
+  INVENTORY,
+  DONE,
+};
+
+class MQTTClient : public EventSubscriber
 {
   public:
-  MQTTClient(Controller* controller, SerializerAbstract* serializer);
+  MQTTClient(Controller* controller, SerializerAbstract* serializer, ClockAbstract* clock,
+      MQTTConnectionAbstract* connection);
   static MQTTClient* getInstance();
   bool connect(const MQTTConfiguration& conf);
   void handleMessages();
   bool isConnected();
 
-  void notified(const char* action, const Remote& remote); // from observer
+  void notified(const Event& event); // from event bus
 
   private:
   static MQTTClient* m_instance;
   Controller* m_controller = nullptr;
   SerializerAbstract* m_serializer;
+  ClockAbstract* m_clock;
+  MQTTConnectionAbstract* m_connection;
+  MQTTConfiguration m_config; // The broker is not copied by PubSubClient
+  ReconnectBackoff m_backoff;
+  MQTTOutbox m_outbox; // Changes published while disconnected or republishing
+  unsigned long m_lastDrain = 0;
+  RepublishStep m_republish = RepublishStep::DONE;
+  unsigned short m_republishSlot = 0; // The remote republished, its slot in the database
+  Remote m_republishRemote = {}; // Read once for all its messages
+  char m_deviceId[MAX_DEVICE_ID_LENGTH] = "";
+  char m_payload[MAX_DISCOVERY_PAYLOAD_LENGTH]; // Reused by the discovery configs and the states
+  RemoteState m_states[MAX_REMOTES] = {}; // With MQTT_JSON_STATE, the last action of each remote
+  bool m_enabled = false;
+  unsigned long m_lastMetricsPublish = 0;
 
   static void receive(const char* topic, byte* payload, uint32_t length);
+  bool attemptConnection();
+  void republishNext();
+  RepublishStep findRepublishRemote();
+  void publishRemote(const RemoteChange& change);
+  void publishRemoteState(const RemoteChange& change);
+  void publishInventory(const Remote remotes[]);
+  RemoteState* trackState(const Remote& remote);
+  void forgetStates(const Remote remotes[]);
+  bool writeDiscovery(char* topic, const size_t size, const Remote& remote);
+  void publishDiscovery(const Remote& remote);
+  void removeDiscovery(const unsigned long remoteId);
+  void publishCommand(const Command& command);
+  void publishMetrics();
+  void drainOutbox();
+  bool deliver(const char* topic, const char* payload, const bool retained = false);
+  bool publish(const char* topic, const char* payload, const bool retained = false);
   String getClientIdentifier();
 };
\ No newline at end of file
@@ -0,0 +1,97 @@
+/**
+ * @file mqttOutbox.h
+ * @author Laurette Alexandre
+ * @brief Header for the outbox of the MQTT client.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <config.h>
+
+/**
+ * @brief A message of the outbox. The topic and the payload point in the outbox, until the next
+ * push or pop.
+ *
+ */
+struct MQTTMessage
+{
+  const char* topic;
+  const char* payload;
+  bool retained;
+};
+
+/**
+ * @brief Messages packed one after the other in a fixed buffer, as "<topic>\0<payload>\0", so
+ * each one takes only its own length. The oldest one is at the start.
+ *
+ */
+class MQTTMessageBuffer
+{
+  public:
+  MQTTMessageBuffer(char* buffer, const size_t capacity);
+
+  bool hasRoom(const size_t length) const;
+  void push(const char* topic, const char* payload);
+  bool peek(MQTTMessage& message) const;
+  void pop();
+  bool remove(const char* topic);
+  unsigned short size() const;
+
+  private:
+  char* m_buffer;
+  const size_t m_capacity;
+  size_t m_used = 0;
+  unsigned short m_count = 0;
+
+  size_t getLength(const size_t offset) const;
+  void erase(const size_t offset);
+};
+
+/**
+ * @brief Messages waiting for the broker. The retained states keep only the last value of each
+ * topic: a newer value replaces the queued one, so they compact instead of growing. The other
+ * messages, the command acks and the last actions, are all kept in order and published first.
+ * When a queue is full, either its oldest messages or the new one are dropped.
+ *
+ */
+class MQTTOutbox
+{
+  public:
+  MQTTOutbox(const bool dropOldest);
+
+  bool push(const char* topic, const char* payload, const bool retained);
+  bool peek(MQTTMessage& message) const;
+  void pop();
+  unsigned short size() const;
+
+  private:
+  char m_statesBuffer[MQTT_OUTBOX_STATES_SIZE];
+  char m_eventsBuffer[MQTT_OUTBOX_EVENTS_SIZE];
+  MQTTMessageBuffer m_states; // Retained, the last value of each topic
+  MQTTMessageBuffer m_events; // Not retained, in order
+  const bool m_dropOldest;
+};
@@ -0,0 +1,67 @@
+/**
+ * @file mqttTopic.h
+ * @author Laurette Alexandre
+ * @brief Parse the topics of the incoming MQTT messages.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <stdint.h>
+
+const uint8_t MAX_MQTT_TOPIC_SEGMENTS = 8;
+
+enum class MQTTTopicType : uint8_t
+{
+  UNKNOWN,
+  REMOTE_NAME,
+  REMOTE_ACTION,
+  REMOTES_ACTIONS,
+  SCENE_RUN
+};
+
+struct MQTTTopic
+{
+  MQTTTopicType type = MQTTTopicType::UNKNOWN;
+  uint32_t id = 0; // The remote or the scene of the topic, if any
+};
+
+/**
+ * @brief A topic subscribed by the client. A "+" level captures a number, the id.
+ *
+ */
+struct MQTTTopicFilter
+{
+  const char* filter;
+  MQTTTopicType type;
+};
+
+const MQTTTopicFilter MQTT_SUBSCRIPTIONS[] = {
+  { "esprtsomfy/remotes/+/set/name", MQTTTopicType::REMOTE_NAME },
+  { "esprtsomfy/remotes/+/set/action", MQTTTopicType::REMOTE_ACTION },
+  { "esprtsomfy/remotes/set/actions", MQTTTopicType::REMOTES_ACTIONS },
+  { "esprtsomfy/scenes/+/set/run", MQTTTopicType::SCENE_RUN },
+};
+const uint8_t MQTT_SUBSCRIPTIONS_COUNT = sizeof(MQTT_SUBSCRIPTIONS) / sizeof(MQTT_SUBSCRIPTIONS[0]);
+
+bool parseMQTTTopic(const char* topic, MQTTTopic& parsed);
@@ -0,0 +1,64 @@
+/**
+ * @file otaUpdater.h
+ * @author Laurette Alexandre
+ * @brief Header of the OTA updater.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include <result.h>
+#include <update.h>
+#include <sha256.h>
+#include <updatePartitionAbs.h>
+
+/**
+ * @brief Stream an update into its partition, chunk by chunk as it is received, so the image is
+ * never buffered. Its SHA-256 is computed on the fly and checked before the image is marked to
+ * be installed: a corrupted or truncated image is discarded and the current one kept.
+ *
+ */
+class OtaUpdater
+{
+  public:
+  OtaUpdater(UpdatePartitionAbstract* partition);
+
+  Result<UpdateProgress> begin(const UpdateTarget target, const char* sha256, const size_t total);
+  Result<UpdateProgress> write(const uint8_t* data, const size_t length);
+  Result<UpdateProgress> end();
+  void abort();
+
+  const UpdateProgress& getProgress() const;
+  const String& getError() const;
+
+  private:
+  UpdatePartitionAbstract* m_partition = nullptr;
+  Sha256 m_sha256;
+  char m_expectedSha256[SHA256_HEX_LENGTH] = "";
+  UpdateProgress m_progress = { UpdateTarget::FIRMWARE, UpdateState::IDLE, 0, 0 };
+  String m_error; // Why the last update failed
+
+  Result<UpdateProgress> fail(const String& error);
+};
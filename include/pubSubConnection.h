@@ -0,0 +1,64 @@
+/**
+ * @file pubSubConnection.h
+ * @author Laurette Alexandre
+ * @brief Header of the connection to the MQTT broker with PubSubClient.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include <PubSubClient.h>
+
+#include <mqttConnectionAbs.h>
+
+/**
+ * @brief PubSubClient over WiFi. The broker is resolved once and its IP is kept, even after a
+ * failed attempt: WiFiClient would resolve a hostname at each attempt, adding the timeout of the
+ * lookup to each. It is resolved again when the configuration changes.
+ *
+ */
+class PubSubConnection : public MQTTConnectionAbstract
+{
+  public:
+  PubSubConnection();
+
+  void begin(const char* broker, const uint16_t port, MQTTReceiveCallback callback);
+  bool isNetworkConnected();
+  bool connect(const char* clientId, const char* username, const char* password);
+  bool isConnected();
+  int getState();
+  void loop();
+  bool subscribe(const char* filter);
+  bool publish(const char* topic, const char* payload, const bool retained);
+  Print* beginPublish(const char* topic, const size_t length, const bool retained);
+  bool endPublish();
+
+  private:
+  WiFiClient m_wifiClient;
+  PubSubClient m_client;
+  const char* m_broker = nullptr;
+  uint16_t m_port = 0;
+  bool m_resolved = false; // The IP of the broker is set in m_client
+};
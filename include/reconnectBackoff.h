@@ -0,0 +1,63 @@
+/**
+ * @file reconnectBackoff.h
+ * @author Laurette Alexandre
+ * @brief Header for the reconnection backoff.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief When to try to connect again. The wait doubles after each failed attempt, from the min
+ * delay up to the max delay, and is drawn in its upper half so the clients of a broker coming
+ * back do not reconnect all at once. The times are in milliseconds and may wrap.
+ *
+ */
+class ReconnectBackoff
+{
+  public:
+  ReconnectBackoff(const uint32_t minDelay, const uint32_t maxDelay);
+
+  void begin(const uint32_t now);
+  bool isDue(const uint32_t now) const;
+  void succeeded(const uint32_t now);
+  void failed(const uint32_t now, const uint16_t jitter);
+  void lost(const uint32_t now);
+
+  bool isConnected() const;
+  uint32_t getWait() const;
+  uint32_t getFailures() const;
+
+  private:
+  const uint32_t m_minDelay;
+  const uint32_t m_maxDelay;
+  uint32_t m_delay; // Doubled after each failure
+  uint32_t m_wait = 0; // Before the next attempt, the delay with its jitter
+  uint32_t m_lastAttempt = 0;
+  uint32_t m_lostAt = 0;
+  uint32_t m_failures = 0; // In a row
+  bool m_connected = false;
+  bool m_recovering = false; // Lost after being connected, the next success is a reconnection
+};
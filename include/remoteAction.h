@@ -0,0 +1,102 @@
+/**
+ * @file remoteAction.h
+ * @author Laurette Alexandre
+ * @brief Header for Remote actions and events.
+ * @version 2.1.1
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include <transmitterAbs.h>
+
+/**
+ * @brief Actions that can be operated through a remote.
+ * The string form is parsed once at the edge (REST, MQTT), then only this type is used.
+ * UNKNOWN must stay the last one, it is also the number of valid actions.
+ */
+enum class RemoteAction : uint8_t
+{
+  UP = 0,
+  STOP,
+  DOWN,
+  PAIR,
+  RESET,
+  UNKNOWN
+};
+
+/**
+ * @brief An action to operate with a given remote. Used by batches and scenes.
+ */
+struct RemoteOperation
+{
+  unsigned long remoteId;
+  RemoteAction action;
+};
+
+typedef bool (TransmitterAbstract::*TransmitterCommand)(
+    const unsigned long remoteId, const unsigned int rollingCode);
+
+struct RemoteActionDescriptor
+{
+  RemoteAction action;
+  const char* name; // Name used by REST/MQTT, also published as last_action
+  TransmitterCommand command; // nullptr if nothing has to be transmitted
+  bool resetRollingCode; // Otherwise, the rolling code is incremented after the command
+  const char* message;
+};
+
+const unsigned short REMOTE_ACTIONS_COUNT = static_cast<unsigned short>(RemoteAction::UNKNOWN);
+
+// Adding an action (my, tilt, ...) only requires a new entry here, in the RemoteAction order.
+constexpr RemoteActionDescriptor REMOTE_ACTIONS[REMOTE_ACTIONS_COUNT] = {
+  { RemoteAction::UP, "up", &TransmitterAbstract::sendUpCmd, false, "Command UP sent." },
+  { RemoteAction::STOP, "stop", &TransmitterAbstract::sendStopCmd, false, "Command STOP sent." },
+  { RemoteAction::DOWN, "down", &TransmitterAbstract::sendDownCmd, false, "Command DOWN sent." },
+  { RemoteAction::PAIR, "pair", &TransmitterAbstract::sendProgCmd, false, "Command PAIR sent." },
+  { RemoteAction::RESET, "reset", nullptr, true, "Rolling code reseted." },
+};
+
+constexpr bool remoteActionsAreOrdered(const unsigned short index = 0)
+{
+  return index >= REMOTE_ACTIONS_COUNT
+      || (static_cast<unsigned short>(REMOTE_ACTIONS[index].action) == index
+          && remoteActionsAreOrdered(index + 1));
+}
+static_assert(remoteActionsAreOrdered(), "REMOTE_ACTIONS must follow the RemoteAction order.");
+
+/**
+ * @brief Get the descriptor of a valid action. The lookup is a simple index.
+ *
+ * @param action The action, it cannot be RemoteAction::UNKNOWN.
+ * @return const RemoteActionDescriptor&
+ */
+constexpr const RemoteActionDescriptor& getRemoteActionDescriptor(const RemoteAction action)
+{
+  return REMOTE_ACTIONS[static_cast<unsigned short>(action)];
+}
+
+RemoteAction parseRemoteAction(const char* name);
+int parseRemoteOperations(
+    const char* input, RemoteOperation operations[], const unsigned short maxSize);
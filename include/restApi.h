@@ -0,0 +1,78 @@
+/**
+ * @file restApi.h
+ * @author Laurette Alexandre
+ * @brief Header for RestApi.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <Arduino.h>
+
+#include <result.h>
+#include <batch.h>
+#include <router.h>
+#include <chunkedWriter.h>
+#include <controller.h>
+#include <serializerAbs.h>
+
+class RestApi;
+
+// A route of the REST API: the numbers captured by its path and the fields of the body.
+typedef BatchResponse (RestApi::*ApiHandler)(const RouteMatch& match, const BodyFields& body);
+
+/**
+ * @brief The resources of the REST API: remotes, commands, scenes, schedules and location. It
+ * only knows the controller and the serializer, the web server adds what is HTTP (ETags,
+ * conditional GETs, chunked listings) and the load test calls the same code on the host.
+ *
+ */
+class RestApi
+{
+  public:
+  RestApi(Controller* controller, SerializerAbstract* serializer);
+
+  BatchResponse fetchSystemInfos(const RouteMatch& match, const BodyFields& body);
+  Result<ChunkedWriter> fetchAllRemotes();
+  BatchResponse fetchRemote(const RouteMatch& match, const BodyFields& body);
+  BatchResponse createRemote(const RouteMatch& match, const BodyFields& body);
+  BatchResponse updateRemote(const RouteMatch& match, const BodyFields& body);
+  BatchResponse deleteRemote(const RouteMatch& match, const BodyFields& body);
+  BatchResponse actionRemote(const RouteMatch& match, const BodyFields& body);
+  BatchResponse fetchCommand(const RouteMatch& match, const BodyFields& body);
+  BatchResponse operateBatch(const RouteMatch& match, const BodyFields& body);
+  Result<ChunkedWriter> fetchAllScenes();
+  BatchResponse createScene(const RouteMatch& match, const BodyFields& body);
+  BatchResponse deleteScene(const RouteMatch& match, const BodyFields& body);
+  Result<ChunkedWriter> fetchAllSchedules();
+  BatchResponse createSchedule(const RouteMatch& match, const BodyFields& body);
+  BatchResponse deleteSchedule(const RouteMatch& match, const BodyFields& body);
+  BatchResponse fetchLocation(const RouteMatch& match, const BodyFields& body);
+  BatchResponse updateLocation(const RouteMatch& match, const BodyFields& body);
+
+  private:
+  Controller* m_controller = nullptr;
+  SerializerAbstract* m_serializer = nullptr;
+
+  BatchResponse fail(const char* message);
+};
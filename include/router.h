@@ -0,0 +1,92 @@
+/**
+ * @file router.h
+ * @author Laurette Alexandre
+ * @brief Header of the route table of the REST API.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <stdint.h>
+
+const uint8_t MAX_ROUTES = 48;
+const uint8_t MAX_ROUTE_NODES = 48; // One per distinct path segment
+const uint8_t MAX_ROUTE_PARAMS = 2;
+const int8_t ROUTE_NOT_FOUND = -1;
+
+// Request headers read by the handlers. ESPAsyncWebServer drops a header no handler asked for, so
+// each one must be listed here.
+const char IF_NONE_MATCH_HEADER[] = "If-None-Match";
+const char IDEMPOTENCY_KEY_HEADER[] = "Idempotency-Key";
+const char* const ROUTE_HEADERS[] = { IF_NONE_MATCH_HEADER, IDEMPOTENCY_KEY_HEADER };
+const uint8_t ROUTE_HEADERS_COUNT = sizeof(ROUTE_HEADERS) / sizeof(ROUTE_HEADERS[0]);
+
+/**
+ * @brief A segment of the routes. Children and routes are linked lists of indexes, so the table
+ * is a few arrays filled at setup and never allocates.
+ *
+ */
+struct RouteNode
+{
+  const char* segment = nullptr; // Points in the pattern, not terminated
+  uint8_t length = 0;
+  bool isParam = false; // Matches any number
+  int8_t firstChild = ROUTE_NOT_FOUND;
+  int8_t nextSibling = ROUTE_NOT_FOUND;
+  int8_t firstRoute = ROUTE_NOT_FOUND; // Routes ending on this segment
+};
+
+struct RouteEntry
+{
+  uint8_t methods = 0; // Mask of the methods, ie: HTTP_GET | HTTP_POST
+  int8_t nextRoute = ROUTE_NOT_FOUND; // Same path, other methods
+};
+
+struct RouteMatch
+{
+  int8_t route = ROUTE_NOT_FOUND;
+  uint8_t paramsCount = 0;
+  uint32_t params[MAX_ROUTE_PARAMS] = {}; // Numeric captures, in the order of the path
+};
+
+/**
+ * @brief Route table compiled into a trie of path segments. A "{name}" segment captures a number,
+ * ie: "/api/v1/remotes/{id}/action". Matching a path walks it once, whatever the number of routes,
+ * and a literal segment is preferred to a capture.
+ *
+ */
+class Router
+{
+  public:
+  int8_t addRoute(const char* pattern, const uint8_t methods);
+  bool match(const char* path, const uint8_t method, RouteMatch& match) const;
+
+  private:
+  RouteNode m_nodes[MAX_ROUTE_NODES];
+  RouteEntry m_routes[MAX_ROUTES];
+  uint8_t m_nodesCount = 1; // The root
+  uint8_t m_routesCount = 0;
+
+  int8_t findChild(const int8_t parent, const char* segment, const uint8_t length) const;
+  int8_t addChild(const int8_t parent, const char* segment, const uint8_t length);
+};
@@ -0,0 +1,83 @@
+/**
+ * @file routerHandler.h
+ * @author Laurette Alexandre
+ * @brief Header of the web handler dispatching the REST API through the router.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <ESPAsyncWebServer.h>
+
+#include <batch.h>
+#include <router.h>
+#include <metrics.h>
+#include <restApi.h>
+
+typedef void (*RouteRequestHandler)(AsyncWebServerRequest* request);
+// Runs the same route for a sub-request of a batch, with the fields of its body.
+typedef ApiHandler RouteBatchHandler;
+
+/**
+ * @brief What the router knows about a request, while its handler runs.
+ *
+ */
+struct RouteContext
+{
+  RouteMatch match;
+  const char* body; // The application/json body, nullptr if none
+  BodyFields fields; // Of the body, parsed on the first read
+  bool parsed;
+};
+
+/**
+ * @brief A single handler for all the routes of the REST API, in place of a regex handler per
+ * route. The numbers captured by the route are read with getPathParam. An application/json body
+ * is accumulated up to MAX_JSON_BODY_SIZE and read with getJsonBody.
+ *
+ */
+class RouterHandler : public AsyncWebHandler
+{
+  public:
+  bool on(const char* pattern, const WebRequestMethodComposite methods,
+      RouteRequestHandler handler, RouteBatchHandler batchHandler = nullptr);
+  RouteBatchHandler findBatchHandler(const BatchRequest& request, RouteMatch& match) const;
+  static unsigned long getPathParam(AsyncWebServerRequest* request, const uint8_t index);
+  static const char* getJsonBody(AsyncWebServerRequest* request);
+  static RouteContext* getContext(AsyncWebServerRequest* request);
+  bool writeMetrics(Print& output, const uint8_t route) const;
+
+  bool canHandle(AsyncWebServerRequest* request) override;
+  void handleRequest(AsyncWebServerRequest* request) override;
+  void handleBody(AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index,
+      size_t total) override;
+  bool isRequestHandlerTrivial() override { return false; }
+
+  private:
+  Router m_router;
+  RouteRequestHandler m_handlers[MAX_ROUTES] = {};
+  RouteBatchHandler m_batchHandlers[MAX_ROUTES] = {}; // nullptr if not allowed in a batch
+  const char* m_patterns[MAX_ROUTES] = {};
+  WebRequestMethodComposite m_methods[MAX_ROUTES] = {};
+  Histogram m_durations[MAX_ROUTES]; // Of the handlers, the response sent afterwards excluded
+};
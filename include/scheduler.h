@@ -0,0 +1,74 @@
+/**
+ * @file scheduler.h
+ * @author Laurette Alexandre
+ * @brief Header of the schedule engine.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <time.h>
+
+#include <cron.h>
+#include <config.h>
+#include <schedule.h>
+#include <clockAbs.h>
+#include <controller.h>
+#include <timerWheel.h>
+
+// A cron expression may match rarely (29 of february on a monday...), the search stops here.
+const unsigned short MAX_SCHEDULE_SEARCH_DAYS = 4 * 366;
+
+long daysFromCivil(const int year, const unsigned int month, const unsigned int day);
+bool computeSunEvent(const int year, const unsigned int month, const unsigned int day,
+    const float latitude, const float longitude, const bool sunrise, int& minutes);
+time_t computeNextRun(const Schedule& schedule, const CronMasks& masks, const Location& location,
+    ClockAbstract* clock, const time_t from);
+
+/**
+ * @brief Run the schedules of the database on the device. Each schedule is a timer of a timing
+ * wheel ticking every second, so the cost of a tick does not depend on the number of schedules.
+ * Schedules are reloaded when the controller reports a change.
+ *
+ */
+class Scheduler
+{
+  public:
+  Scheduler(Controller* controller, ClockAbstract* clock);
+  void handleSchedules();
+
+  private:
+  Controller* m_controller;
+  ClockAbstract* m_clock;
+  TimerWheel m_wheel;
+  Schedule m_schedules[MAX_SCHEDULES];
+  CronMasks m_masks[MAX_SCHEDULES];
+  TimerNode m_timers[MAX_SCHEDULES];
+  Location m_location;
+  unsigned long m_revision = 0;
+  bool m_loaded = false;
+
+  void reload(const time_t now);
+  void arm(const unsigned short index, const time_t from);
+  void run(const unsigned short index, const time_t now);
+};
@@ -0,0 +1,56 @@
+/**
+ * @file sha256.h
+ * @author Laurette Alexandre
+ * @brief Header of the SHA-256 computed on the fly.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+const uint8_t SHA256_SIZE = 32;
+const uint8_t SHA256_HEX_LENGTH = 65; // 64 hex chars + 1 (\0)
+
+/**
+ * @brief SHA-256 of a stream, fed chunk by chunk so the data is never held whole.
+ *
+ */
+class Sha256
+{
+  public:
+  Sha256();
+  void reset();
+  void update(const uint8_t* data, size_t length);
+  void finish(uint8_t digest[SHA256_SIZE]);
+  void finishHex(char hex[SHA256_HEX_LENGTH]);
+
+  private:
+  uint32_t m_state[8];
+  uint8_t m_block[64];
+  uint8_t m_blockLength = 0;
+  uint64_t m_length = 0; // Bytes
+
+  void transform();
+};
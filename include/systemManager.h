@@ -31,10 +31,14 @@
 
 class SystemManager : public SystemManagerAbstract {
     public:
+    bool beginBoot();
     void handleActions();
     void requestRestart();
 
     private:
     bool m_restartRequested = false;
+    bool m_bootConfirmed = false;
     unsigned long m_lastHandled = 0;
+
+    void writeFailedBoots(const uint32_t failedBoots);
 };
\ No newline at end of file
@@ -0,0 +1,73 @@
+/**
+ * @file timerWheel.h
+ * @author Laurette Alexandre
+ * @brief Header of the hierarchical timing wheel.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <stdint.h>
+
+const uint8_t TIMER_WHEEL_LEVELS = 4;
+const uint8_t TIMER_WHEEL_BITS = 6;
+const uint16_t TIMER_WHEEL_SLOTS = 1 << TIMER_WHEEL_BITS;
+const uint16_t TIMER_WHEEL_MASK = TIMER_WHEEL_SLOTS - 1;
+
+/**
+ * @brief A timer of the wheel. It is owned by the caller and linked in place, the wheel never
+ * allocates memory.
+ *
+ */
+struct TimerNode
+{
+  TimerNode* next = nullptr;
+  TimerNode** pprev = nullptr; // nullptr while the timer is not armed
+  uint32_t expires = 0; // Tick
+  unsigned short id = 0; // Free for the owner
+};
+
+/**
+ * @brief Hierarchical timing wheel. Arming and cancelling a timer is O(1). A tick costs O(1) plus
+ * the timers expiring in it and, every 64 ticks, the timers cascading from an upper level.
+ * 4 levels of 64 slots cover 2^24 ticks, farther timers go round the last level until they are
+ * in range.
+ *
+ */
+class TimerWheel
+{
+  public:
+  void begin(const uint32_t now);
+  void schedule(TimerNode* node, const uint32_t expires);
+  void cancel(TimerNode* node);
+  TimerNode* advance(const uint32_t now);
+
+  private:
+  TimerNode* m_slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS] = {};
+  uint32_t m_current = 0; // Next tick to process
+
+  void insert(TimerNode* node);
+  uint16_t cascade(const uint8_t level);
+  TimerNode* detachSlot(const uint8_t level, const uint16_t index);
+  void rebase(const uint32_t now);
+};
@@ -28,4 +28,7 @@
 
 #pragma once
 
-unsigned long macToLong(const char* macAddress);
\ No newline at end of file
+#include <stdint.h>
+
+unsigned long macToLong(const char* macAddress);
+bool parseNumber(const char* segment, const uint8_t length, uint32_t& value);
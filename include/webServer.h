@@ -31,32 +31,78 @@
 
 #include <config.h>
 #include <remote.h>
-#include <observer.h>
+#include <scene.h>
+#include <command.h>
+#include <schedule.h>
+#include <batch.h>
+#include <router.h>
+#include <loadStats.h>
+#include <metrics.h>
+#include <update.h>
+#include <event.h>
+#include <eventBus.h>
 #include <controller.h>
+#include <restApi.h>
+#include <routerHandler.h>
+#include <chunkedWriter.h>
+#include <admissionControl.h>
+#include <otaUpdater.h>
 #include <serializerAbs.h>
 
-class WebServer : public Observer
+class WebServer : public EventSubscriber
 {
   public:
-  WebServer(const unsigned short port, Controller* controller, SerializerAbstract* serializer);
+  WebServer(const unsigned short port, Controller* controller, SerializerAbstract* serializer,
+      OtaUpdater* updater);
   ~WebServer();
   static WebServer* getInstance();
 
   void setup();
+  void setupSafeMode();
   void begin();
+  void handleEvents();
 
-  void notified(const char* action, const Remote& remote); // from observer
+  void notified(const Event& event); // from event bus
 
   private:
   static WebServer* m_instance;
   AsyncWebServer* m_server = nullptr;
   Controller* m_controller = nullptr;
   SerializerAbstract* m_serializer;
+  RestApi m_api;
+  AsyncEventSource* m_events = nullptr;
+  unsigned long m_lastEventId = 0;
+  bool m_resyncPending = false; // Changes were dropped for slow clients
+  uint32_t m_bootId = 0; // Random, part of the ETags
+  RouterHandler* m_router = nullptr;
+  AdmissionControl m_admission;
+  OtaUpdater* m_updater = nullptr;
+  String m_otaCredentials; // "<username>:<realm>:<hash>", only a digest authentication matches
+  AsyncWebServerRequest* m_otaRequest = nullptr; // The upload writing the update
+  unsigned long m_otaLastChunk = 0;
+  uint8_t m_otaReportedStep = 0; // Tens of percent pushed to the events
+
+  String getStateETag();
+  static bool handleNotModified(AsyncWebServerRequest* request, const String& etag);
+  static void sendChunked(AsyncWebServerRequest* request, const char* contentType,
+      ChunkedWriter writer, const String& etag = "");
+  static bool getBodyParam(AsyncWebServerRequest* request, const char* name, String& value);
+  static BodyFields& getBodyFields(AsyncWebServerRequest* request);
+  static void runApi(AsyncWebServerRequest* request, ApiHandler handler, const String& etag = "");
+  static void sendListing(
+      AsyncWebServerRequest* request, const Result<ChunkedWriter>& result, const String& etag);
+  bool writeMetrics(Print& output, const uint8_t item);
+  void pushEvent(const char* name, const String& data);
+  void setupOta();
 
   // API REST
   static void handleSystemRestart(AsyncWebServerRequest* request);
   static void handleFetchSystemInfos(AsyncWebServerRequest* request);
+  static void handleFetchSystemLoad(AsyncWebServerRequest* request);
+  static void handleFetchMetrics(AsyncWebServerRequest* request);
   static void handleFetchWifiNetworks(AsyncWebServerRequest* request);
+  static void handleFetchWifiScan(AsyncWebServerRequest* request);
+  static void handleScanWifiNetworks(AsyncWebServerRequest* request);
   static void handleFetchWifiConfiguration(AsyncWebServerRequest* request);
   static void handleUpdateWifiConfiguration(AsyncWebServerRequest* request);
   static void handleFetchMQTTConfiguration(AsyncWebServerRequest* request);
@@ -67,6 +113,22 @@ class WebServer : public Observer
   static void handleUpdateRemote(AsyncWebServerRequest* request);
   static void handleDeleteRemote(AsyncWebServerRequest* request);
   static void handleActionRemote(AsyncWebServerRequest* request);
+  static void handleFetchCommand(AsyncWebServerRequest* request);
+  static void handleOperateBatch(AsyncWebServerRequest* request);
+  static void handleFetchAllScenes(AsyncWebServerRequest* request);
+  static void handleCreateScene(AsyncWebServerRequest* request);
+  static void handleDeleteScene(AsyncWebServerRequest* request);
+  static void handleFetchAllSchedules(AsyncWebServerRequest* request);
+  static void handleCreateSchedule(AsyncWebServerRequest* request);
+  static void handleDeleteSchedule(AsyncWebServerRequest* request);
+  static void handleFetchLocation(AsyncWebServerRequest* request);
+  static void handleUpdateLocation(AsyncWebServerRequest* request);
+  static void handleBatch(AsyncWebServerRequest* request);
+  static void handleFetchOta(AsyncWebServerRequest* request);
+  static void handleOtaUpload(AsyncWebServerRequest* request, const String& filename,
+      size_t index, uint8_t* data, size_t length, bool final);
+  static void handleOtaDone(AsyncWebServerRequest* request);
+  static void handleEventsConnect(AsyncEventSourceClient* client);
   // HTML
   static void handleHTMLHomePage(AsyncWebServerRequest* request);
   static void handleHTMLNotFoundPage(AsyncWebServerRequest* request);
@@ -40,8 +40,17 @@ class NetworkWifiClient : public NetworkClientAbstract
   String getMacAddress();
   bool isConnected();
   void scanNetworks();
+  NetworkScan startScan();
+  bool handleScan();
+  NetworkScan getScan();
   void getNetworks(Network networks[]);
 
   private:
-  Network m_networks[MAX_NETWORK_SCAN];
+  Network m_networks[MAX_NETWORK_SCAN] = {};
+  unsigned short m_count = 0;
+  bool m_scanning = false;
+  bool m_scanned = false;
+  unsigned long m_scannedAt = 0;
+
+  void storeNetworks(const int count);
 };
\ No newline at end of file
@@ -0,0 +1,143 @@
+"""
+Build the LittleFS image from data/ instead of copying it as is:
+
+- files of data/static/ are renamed with the hash of their content, ie:
+  static/js/esprtsomfy.js -> static/js/esprtsomfy.1a2b3c4d.js, and the html files are rewritten
+  to reference the new names. These files can be cached forever by the browsers.
+- every file is gzipped, only the .gz is written to the image.
+- assets.manifest lists the assets with their ETag and max-age, it is loaded by AssetHandler.
+- embeddedAssets.h holds the same gzipped files as PROGMEM arrays, with their length, ETag and
+  content type. Built with -D EMBED_ASSETS, the firmware serves them from flash and does not
+  mount LittleFS. The html, css and js files are minified first, in both outputs.
+
+Registered as a pre script in platformio.ini, the image and the header are generated in the
+build directory.
+"""
+
+import gzip
+import hashlib
+import mimetypes
+import os
+import shutil
+
+Import("env")  # noqa: F821
+
+STATIC_DIR = "static"
+MANIFEST = "assets.manifest"
+IMMUTABLE_MAX_AGE = 365 * 24 * 3600
+HASH_LENGTH = 8
+ETAG_LENGTH = 16
+HEADER = "embeddedAssets.h"
+MINIFIED_EXTENSIONS = (".html", ".css", ".js")
+
+
+def digest(content):
+    return hashlib.sha256(content).hexdigest()
+
+
+def hashed_name(path, content):
+    root, extension = os.path.splitext(path)
+    return "%s.%s%s" % (root, digest(content)[:HASH_LENGTH], extension)
+
+
+def minify(path, content):
+    """Drop the indentation and the blank lines. The line breaks are kept, js relies on them when
+    a semicolon is missing. Not for a <pre> or a whitespace sensitive template string."""
+    if not path.endswith(MINIFIED_EXTENSIONS):
+        return content
+    lines = (line.strip() for line in content.splitlines())
+    return b"\n".join(line for line in lines if line) + b"\n"
+
+
+def content_type(path):
+    guessed, _ = mimetypes.guess_type(path)
+    return guessed or "application/octet-stream"
+
+
+def write_header(assets, path):
+    lines = [
+        "// Generated by scripts/build_assets.py from data/, do not edit.",
+        "#pragma once",
+        "",
+        "#include <Arduino.h>",
+        "",
+        "#include <assetHandler.h>",
+        "",
+    ]
+    for index, (_, _, _, _, gzipped) in enumerate(assets):
+        lines.append("static const uint8_t ASSET_%d[] PROGMEM = {" % index)
+        for start in range(0, len(gzipped), 16):
+            chunk = gzipped[start:start + 16]
+            lines.append("  " + ", ".join("0x%02x" % byte for byte in chunk) + ",")
+        lines.append("};")
+    lines.append("")
+    lines.append("const EmbeddedAsset EMBEDDED_ASSETS[] = {")
+    for index, (asset_path, etag, max_age, asset_type, _) in enumerate(assets):
+        lines.append(
+            '  { "%s", "%s", "%s", %d, ASSET_%d, sizeof(ASSET_%d) },'
+            % (asset_path, etag.replace('"', '\\"'), asset_type, max_age, index, index)
+        )
+    lines.append("};")
+    lines.append("const unsigned short EMBEDDED_ASSETS_COUNT = %d;" % len(assets))
+
+    with open(path, "w") as file:
+        file.write("\n".join(lines) + "\n")
+
+
+def collect(source_dir):
+    files = {}
+    for directory, _, names in os.walk(source_dir):
+        for name in names:
+            path = os.path.join(directory, name)
+            relative = os.path.relpath(path, source_dir).replace(os.sep, "/")
+            with open(path, "rb") as file:
+                files[relative] = file.read()
+    return files
+
+
+def build(source_dir, output_dir, header_dir):
+    files = {path: minify(path, content) for path, content in collect(source_dir).items()}
+
+    renamed = {}
+    for path, content in files.items():
+        if path.startswith(STATIC_DIR + "/"):
+            renamed[path] = hashed_name(path, content)
+
+    if os.path.isdir(output_dir):
+        shutil.rmtree(output_dir)
+
+    manifest = []
+    embedded = []
+    for path, content in sorted(files.items()):
+        if path.endswith(".html"):
+            for original, hashed in renamed.items():
+                content = content.replace(original.encode(), hashed.encode())
+
+        output_path = renamed.get(path, path)
+        destination = os.path.join(output_dir, output_path + ".gz")
+        os.makedirs(os.path.dirname(destination), exist_ok=True)
+        # mtime=0 so an unchanged asset gives the same image
+        gzipped = gzip.compress(content, compresslevel=9, mtime=0)
+        with open(destination, "wb") as file:
+            file.write(gzipped)
+
+        max_age = IMMUTABLE_MAX_AGE if path in renamed else 0
+        etag = '"%s"' % digest(content)[:ETAG_LENGTH]
+        manifest.append("/%s %s %d" % (output_path, etag, max_age))
+        embedded.append(("/" + output_path, etag, max_age, content_type(path), gzipped))
+
+    with open(os.path.join(output_dir, MANIFEST), "w") as file:
+        file.write("\n".join(manifest) + "\n")
+
+    os.makedirs(header_dir, exist_ok=True)
+    write_header(embedded, os.path.join(header_dir, HEADER))
+
+    print("Assets: %d files gzipped into %s and %s" % (len(files), output_dir, HEADER))
+
+
+source_dir = env.subst("$PROJECT_DATA_DIR")  # noqa: F821
+output_dir = os.path.join(env.subst("$BUILD_DIR"), "data")  # noqa: F821
+header_dir = os.path.join(env.subst("$BUILD_DIR"), "generated")  # noqa: F821
+build(source_dir, output_dir, header_dir)
+env.Replace(PROJECT_DATA_DIR=output_dir)  # noqa: F821
+env.Append(CPPPATH=[header_dir])  # noqa: F821
@@ -28,6 +28,7 @@
 #include <Arduino.h>
 #include <DebugLog.h>
 
+#include <metrics.h>
 #include <RTSTransmitter.h>
 
 #define PORT_TX D1
@@ -117,6 +118,7 @@ void RTSTransmitter::buildFrame(const unsigned long remoteId, const unsigned int
 
 void RTSTransmitter::sendCommand()
 {
+  MetricTimer timer(HistogramId::TRANSMIT);
   this->sendCommand(2);
   for (int i = 0; i < 2; i++)
   {
@@ -0,0 +1,84 @@
+/**
+ * @file admissionControl.cpp
+ * @author Laurette Alexandre
+ * @brief Admission control of the web server.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stdint.h>
+
+#include <admissionControl.h>
+
+AdmissionControl::AdmissionControl(const uint8_t maxInFlight, const uint8_t reservedForCommands,
+    const uint32_t minFreeHeap, const uint32_t minFreeHeapForCommands)
+    : m_maxInFlight(maxInFlight)
+    , m_reservedForCommands(reservedForCommands)
+    , m_minFreeHeap(minFreeHeap)
+    , m_minFreeHeapForCommands(minFreeHeapForCommands)
+{
+}
+
+/**
+ * @brief Admit a request or tell why it is shed. An admitted request must be released once
+ * answered.
+ *
+ * @param priority The priority of the request
+ * @param freeHeap The free heap right now, in bytes
+ * @return ADMITTED, or the reason to refuse the request.
+ */
+Admission AdmissionControl::admit(const RequestPriority priority, const uint32_t freeHeap)
+{
+  const bool isCommand = priority == RequestPriority::COMMAND;
+
+  const uint32_t minFreeHeap = isCommand ? this->m_minFreeHeapForCommands : this->m_minFreeHeap;
+  if (freeHeap < minFreeHeap)
+  {
+    this->m_shedByHeap++;
+    return Admission::SHED_HEAP;
+  }
+
+  const uint16_t maxInFlight
+      = isCommand ? this->m_maxInFlight + this->m_reservedForCommands : this->m_maxInFlight;
+  if (this->m_inFlight >= maxInFlight)
+  {
+    this->m_shedByLimit++;
+    return Admission::SHED_LIMIT;
+  }
+
+  this->m_inFlight++;
+  return Admission::ADMITTED;
+}
+
+void AdmissionControl::release()
+{
+  if (this->m_inFlight > 0)
+  {
+    this->m_inFlight--;
+  }
+}
+
+uint8_t AdmissionControl::getInFlight() const { return this->m_inFlight; }
+
+uint32_t AdmissionControl::getShedByLimit() const { return this->m_shedByLimit; }
+
+uint32_t AdmissionControl::getShedByHeap() const { return this->m_shedByHeap; }
@@ -0,0 +1,78 @@
+/**
+ * @file admissionHandler.cpp
+ * @author Laurette Alexandre
+ * @brief Web handler refusing requests the server cannot afford.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <DebugLog.h>
+#include <ESPAsyncWebServer.h>
+
+#include <config.h>
+#include <admissionControl.h>
+#include <admissionHandler.h>
+
+AdmissionHandler::AdmissionHandler(AdmissionControl& admission)
+    : m_admission(admission)
+{
+}
+
+/**
+ * @brief Admit the request, it is then released when its connection closes.
+ *
+ * @return true if the request is shed, so it is answered here.
+ */
+bool AdmissionHandler::canHandle(AsyncWebServerRequest* request)
+{
+  // The events keep their connection open, their clients are limited by MAX_EVENT_CLIENTS.
+  if (request->url() == "/api/v1/events")
+  {
+    return false;
+  }
+
+  const WebRequestMethodComposite commandMethods = HTTP_POST | HTTP_PUT | HTTP_PATCH | HTTP_DELETE;
+  const RequestPriority priority = (request->method() & commandMethods) != 0
+      ? RequestPriority::COMMAND
+      : RequestPriority::NORMAL;
+
+  const Admission admission = this->m_admission.admit(priority, ESP.getFreeHeap());
+  if (admission == Admission::ADMITTED)
+  {
+    AdmissionControl* control = &this->m_admission;
+    request->onDisconnect([control]() { control->release(); });
+    return false;
+  }
+
+  LOG_WARN("Request shed,", admission == Admission::SHED_HEAP ? "heap too low:" : "too many:",
+      request->url());
+  return true;
+}
+
+void AdmissionHandler::handleRequest(AsyncWebServerRequest* request)
+{
+  AsyncWebServerResponse* response = request->beginResponse(
+      503, "application/json", "{\"message\":\"The device is busy, retry later.\"}");
+  response->addHeader("Retry-After", String(SHED_RETRY_AFTER_SECONDS));
+  request->send(response);
+}
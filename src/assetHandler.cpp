@@ -0,0 +1,181 @@
+/**
+ * @file assetHandler.cpp
+ * @author Laurette Alexandre
+ * @brief Implementation of the handler of the pre-compressed static assets.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <FS.h>
+#include <Arduino.h>
+#include <DebugLog.h>
+#include <ESPAsyncWebServer.h>
+
+#include <config.h>
+#include <assetHandler.h>
+
+AssetHandler::AssetHandler(fs::FS& fs) : m_fs(fs)
+{
+}
+
+/**
+ * @brief Load the manifest, one asset per line: "<path> <etag> <max-age>".
+ *
+ * @param manifestPath The manifest in the filesystem
+ * @return The number of assets loaded, 0 if the filesystem was not built by
+ * scripts/build_assets.py.
+ */
+unsigned short AssetHandler::load(const char* manifestPath)
+{
+  this->m_size = 0;
+
+  File manifest = this->m_fs.open(manifestPath, "r");
+  if (!manifest)
+  {
+    LOG_WARN("No assets manifest, assets are served as is.");
+    return 0;
+  }
+
+  while (manifest.available() && this->m_size < MAX_ASSETS)
+  {
+    String line = manifest.readStringUntil('\n');
+    Asset& asset = this->m_assets[this->m_size];
+    if (sscanf(line.c_str(), "%47s %18s %lu", asset.path, asset.etag, &asset.maxAge) == 3)
+    {
+      asset.embedded = nullptr;
+      this->m_size++;
+    }
+  }
+  if (manifest.available())
+  {
+    LOG_WARN("Too many assets in the manifest, the others are served as is.");
+  }
+  manifest.close();
+
+  LOG_INFO("Assets loaded:", this->m_size);
+  return this->m_size;
+}
+
+/**
+ * @brief Use the assets compiled into the firmware, in place of a manifest. Their content stays
+ * in flash, it is read from there by each response.
+ *
+ * @param assets The assets, from embeddedAssets.h
+ * @param size The number of assets
+ * @return The number of assets loaded.
+ */
+unsigned short AssetHandler::load(const EmbeddedAsset assets[], const unsigned short size)
+{
+  this->m_size = 0;
+
+  for (unsigned short i = 0; i < size && this->m_size < MAX_ASSETS; i++)
+  {
+    if (strlen(assets[i].path) >= MAX_ASSET_PATH_LENGTH
+        || strlen(assets[i].etag) >= MAX_ETAG_LENGTH)
+    {
+      LOG_WARN("Embedded asset skipped, its path or its ETag is too long:", assets[i].path);
+      continue;
+    }
+    Asset& asset = this->m_assets[this->m_size++];
+    strcpy(asset.path, assets[i].path);
+    strcpy(asset.etag, assets[i].etag);
+    asset.maxAge = assets[i].maxAge;
+    asset.embedded = &assets[i];
+  }
+  if (size > MAX_ASSETS)
+  {
+    LOG_WARN("Too many embedded assets, the others are not served.");
+  }
+
+  LOG_INFO("Embedded assets loaded:", this->m_size);
+  return this->m_size;
+}
+
+bool AssetHandler::canHandle(AsyncWebServerRequest* request)
+{
+  if (request->method() != HTTP_GET)
+  {
+    return false;
+  }
+  if (this->find(request->url()) == nullptr)
+  {
+    return false;
+  }
+  // Other headers are dropped by the server
+  request->addInterestingHeader("If-None-Match");
+  return true;
+}
+
+void AssetHandler::handleRequest(AsyncWebServerRequest* request)
+{
+  const Asset* asset = this->find(request->url());
+  if (asset == nullptr)
+  {
+    request->send(404);
+    return;
+  }
+
+  AsyncWebServerResponse* response;
+  if (request->hasHeader("If-None-Match") && request->header("If-None-Match") == asset->etag)
+  {
+    response = request->beginResponse(304);
+  }
+  else if (asset->embedded != nullptr)
+  {
+    // Sent by chunks straight from flash, the content is never copied whole in RAM.
+    const EmbeddedAsset* embedded = asset->embedded;
+    response = request->beginResponse_P(
+        200, embedded->contentType, embedded->content, embedded->length);
+    response->addHeader("Content-Encoding", "gzip");
+  }
+  else
+  {
+    // Only the .gz is in the filesystem, the response adds the Content-Encoding.
+    response = request->beginResponse(this->m_fs, asset->path, String());
+  }
+
+  response->addHeader("ETag", asset->etag);
+  if (asset->maxAge > 0)
+  {
+    response->addHeader("Cache-Control", "public, max-age=" + String(asset->maxAge) + ", immutable");
+  }
+  else
+  {
+    response->addHeader("Cache-Control", "no-cache");
+  }
+  request->send(response);
+}
+
+// PRIVATE
+
+const Asset* AssetHandler::find(const String& url)
+{
+  const char* path = url == "/" ? "/index.html" : url.c_str();
+  for (unsigned short i = 0; i < this->m_size; i++)
+  {
+    if (strcmp(this->m_assets[i].path, path) == 0)
+    {
+      return &this->m_assets[i];
+    }
+  }
+  return nullptr;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file chunkedWriter.cpp
+ * @author Laurette Alexandre
+ * @brief Implementation of ChunkedWriter.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <StreamString.h>
+
+#include <chunkedWriter.h>
+
+ChunkedWriter::ChunkedWriter()
+    : m_writer([](Print&, const uint8_t) { return false; })
+{
+}
+
+ChunkedWriter::ChunkedWriter(ItemWriter writer)
+    : m_writer(writer)
+{
+}
+
+/**
+ * @brief A JSON array, one element per item: "[" first, then the elements, then "]".
+ *
+ * @param size The number of elements, empty slots included
+ * @param serializer Called once per element, when it is sent
+ * @return The writer
+ */
+ChunkedWriter ChunkedWriter::jsonArray(const uint8_t size, ElementSerializer serializer)
+{
+  return ChunkedWriter(
+      [size, serializer, first = true](Print& output, const uint8_t item) mutable -> bool
+      {
+        if (item == 0)
+        {
+          output.print('[');
+          return true;
+        }
+        if (item <= size)
+        {
+          const String element = serializer(item - 1);
+          if (element.length() > 0)
+          {
+            if (!first)
+            {
+              output.print(',');
+            }
+            first = false;
+            output.print(element.c_str());
+          }
+          return true;
+        }
+        if (item == size + 1)
+        {
+          output.print(']');
+          return true;
+        }
+        return false;
+      });
+}
+
+/**
+ * @brief Fill the next chunk. Items are rendered as the previous ones are sent.
+ *
+ * @param buffer The chunk
+ * @param maxLength The size of the chunk
+ * @return The length written, 0 once the body is complete.
+ */
+size_t ChunkedWriter::fill(uint8_t* buffer, const size_t maxLength)
+{
+  size_t length = 0;
+  while (length < maxLength)
+  {
+    if (this->m_offset == this->m_pending.length())
+    {
+      StreamString rendered;
+      if (!this->m_writer(rendered, this->m_item++))
+      {
+        this->m_pending = String();
+        this->m_offset = 0;
+        --this->m_item; // Past the last item, it stays there
+        break;
+      }
+      this->m_pending = rendered;
+      this->m_offset = 0;
+      continue;
+    }
+    const size_t size = std::min(maxLength - length, this->m_pending.length() - this->m_offset);
+    memcpy(buffer + length, this->m_pending.c_str() + this->m_offset, size);
+    this->m_offset += size;
+    length += size;
+  }
+  return length;
+}
@@ -32,8 +32,15 @@
 
 #include <config.h>
 #include <remote.h>
+#include <scene.h>
 #include <result.h>
+#include <event.h>
+#include <command.h>
+#include <schedule.h>
 #include <networks.h>
+#include <cron.h>
+#include <metrics.h>
+#include <remoteAction.h>
 #include <systemInfos.h>
 #include <databaseAbs.h>
 #include <serializerAbs.h>
@@ -61,6 +68,7 @@ Result<SystemInfosExtended> Controller::fetchSystemInfos()
   SystemInfosExtended infosExtended;
   infosExtended.macAddress = macAddress;
   infosExtended.ipAddress = ipAddress;
+  infosExtended.suppressedCommands = this->m_suppressedCommands;
   strcpy(infosExtended.version, infos.version);
 
   result.isSuccess = true;
@@ -115,9 +123,7 @@ Result<Remote[MAX_REMOTES]> Controller::fetchAllRemotes()
   Result<Remote[MAX_REMOTES]> result;
   for (unsigned short i = 0; i < MAX_REMOTES; ++i)
   {
-    result.data[i].id = remotes[i].id;
-    strcpy(result.data[i].name, remotes[i].name);
-    result.data[i].rollingCode = remotes[i].rollingCode;
+    result.data[i] = remotes[i];
   }
   result.errorMsg = "";
   result.isSuccess = true;
@@ -164,10 +170,12 @@ Result<Remote> Controller::createRemote(const char* name)
     return result;
   }
 
+  ++this->m_stateVersion;
   result.isSuccess = true;
   result.data = remote;
 
-  this->notify("remote-create", remote);
+  const uint8_t changes = REMOTE_CHANGE_CREATED | REMOTE_CHANGE_NAME | REMOTE_CHANGE_ROLLING_CODE;
+  this->publish(RemoteChange { changes, RemoteAction::UNKNOWN, remote });
 
   LOG_DEBUG("Remote created.");
   return result;
@@ -202,17 +210,18 @@ Result<Remote> Controller::deleteRemote(const unsigned long id)
     return result;
   }
 
+  ++this->m_stateVersion;
   result.isSuccess = true;
   result.data = remote;
 
-  this->notify("remote-delete", remote);
+  this->publish(RemoteChange { REMOTE_CHANGE_DELETED, RemoteAction::UNKNOWN, remote });
 
   LOG_DEBUG("Remote deleted.");
   return result;
 }
 
-Result<Remote> Controller::updateRemote(
-    const unsigned long id, const char* name, const unsigned int rollingCode)
+Result<Remote> Controller::updateRemote(const unsigned long id, const char* name,
+    const unsigned int rollingCode, const long dedupWindow)
 {
   LOG_DEBUG("Updating Remote...");
   Result<Remote> result;
@@ -233,6 +242,7 @@ Result<Remote> Controller::updateRemote(
     return result;
   }
 
+  uint8_t changes = 0;
   if (name != nullptr)
   {
     if (strlen(name) > MAX_REMOTE_NAME_LENGTH)
@@ -243,10 +253,11 @@ Result<Remote> Controller::updateRemote(
       result.errorMsg = error;
       return result;
     }
-    if (strlen(name) != 0)
+    if (strlen(name) != 0 && strcmp(remote.name, name) != 0)
     {
       LOG_DEBUG("The name of the remote will be updated.");
       strcpy(remote.name, name);
+      changes |= REMOTE_CHANGE_NAME;
     }
   }
   else
@@ -265,6 +276,22 @@ Result<Remote> Controller::updateRemote(
     LOG_DEBUG("The rolling code of the remote is not specified. It will not change.");
   }
 
+  if (dedupWindow != DEDUP_WINDOW_UNCHANGED)
+  {
+    if (dedupWindow < 0 || dedupWindow > UINT16_MAX)
+    {
+      LOG_ERROR("The dedup window is out of range.");
+      result.errorMsg = "The dedup window should be between 0 and " + String(UINT16_MAX) + " ms.";
+      return result;
+    }
+    if (dedupWindow != remote.dedupWindow)
+    {
+      LOG_DEBUG("The dedup window of the remote will be updated.");
+      remote.dedupWindow = dedupWindow;
+      changes |= REMOTE_CHANGE_DEDUP_WINDOW;
+    }
+  }
+
   bool isUpdated = this->m_database->updateRemote(remote);
 
   if (!isUpdated)
@@ -273,11 +300,15 @@ Result<Remote> Controller::updateRemote(
     result.errorMsg = "Something went wrong while updating the remote.";
     return result;
   }
+  ++this->m_stateVersion;
 
   result.isSuccess = true;
   result.data = remote;
 
-  this->notify("remote-update", remote);
+  if (changes != 0)
+  {
+    this->publish(RemoteChange { changes, RemoteAction::UNKNOWN, remote });
+  }
 
   LOG_DEBUG("Remote updated.");
   return result;
@@ -285,15 +316,7 @@ Result<Remote> Controller::updateRemote(
 
 Result<String> Controller::operateRemote(const unsigned long id, const char* action)
 {
-  LOG_INFO("Operating a command with the Remote", id);
   Result<String> result;
-  if (id == 0)
-  {
-    LOG_ERROR("The remote id should be specified.");
-    result.errorMsg = "The remote id should be specified.";
-    return result;
-  }
-
   if (action == nullptr)
   {
     LOG_ERROR("The action should be specified. Allowed actions: up, down, stop, pair, reset.");
@@ -310,6 +333,27 @@ Result<String> Controller::operateRemote(const unsigned long id, const char* act
     return result;
   }
 
+  return this->operateRemote(id, parseRemoteAction(action));
+}
+
+Result<String> Controller::operateRemote(const unsigned long id, const RemoteAction action)
+{
+  LOG_INFO("Operating a command with the Remote", id);
+  Result<String> result;
+  if (id == 0)
+  {
+    LOG_ERROR("The remote id should be specified.");
+    result.errorMsg = "The remote id should be specified.";
+    return result;
+  }
+
+  if (action == RemoteAction::UNKNOWN)
+  {
+    LOG_WARN("The action is not valid.");
+    result.errorMsg = "The action is not valid. Allowed actions: up, down, stop, pair, reset.";
+    return result;
+  }
+
   Remote remote = this->m_database->getRemote(id);
 
   if (remote.id == 0)
@@ -319,62 +363,519 @@ Result<String> Controller::operateRemote(const unsigned long id, const char* act
     return result;
   }
 
-  if (strcmp(action, "up") == 0)
+  CommandTimings timings = {};
+  return this->sendAction(remote, action, timings);
+}
+
+/**
+ * @brief Queue each operation of a batch as a command, in order. The commands are executed one
+ * per loop by handleCommands, so a long batch never blocks the caller. Nothing is queued if one
+ * of the operations is invalid or if the queue cannot hold the whole batch.
+ *
+ */
+Result<BatchReport> Controller::operateBatch(
+    const RemoteOperation operations[], const unsigned short size)
+{
+  LOG_INFO("Queuing a batch of commands:", size);
+  Result<BatchReport> result;
+  BatchReport& report = result.data;
+  report.size = 0;
+
+  Remote remotes[MAX_REMOTES];
+  this->m_database->getAllRemotes(remotes);
+  String error = this->checkOperations(operations, size, remotes);
+  if (error.length() != 0)
+  {
+    LOG_ERROR(error);
+    result.errorMsg = error;
+    return result;
+  }
+
+  if (this->m_nextRequestId - this->m_nextExecutedId + size > MAX_COMMANDS)
   {
-    LOG_INFO("Operate 'UP'.");
-    this->m_transmitter->sendUpCmd(remote.id, remote.rollingCode);
-    this->notify("remote-up", remote);
-    result.data = "Command UP sent.";
+    LOG_ERROR("Too many pending commands for the batch.");
+    result.errorMsg = "Too many pending commands. Retry later.";
+    return result;
   }
-  else if (strcmp(action, "stop") == 0)
+
+  for (unsigned short i = 0; i < size; ++i)
   {
-    LOG_INFO("Operate 'STOP'.");
-    this->m_transmitter->sendStopCmd(remote.id, remote.rollingCode);
-    this->notify("remote-stop", remote);
-    result.data = "Command STOP sent.";
+    report.operations[i] = operations[i];
+    report.requestIds[i] = this->enqueueCommand(operations[i].remoteId, operations[i].action)
+                               .requestId;
   }
-  else if (strcmp(action, "down") == 0)
+  report.size = size;
+
+  result.isSuccess = true;
+  LOG_INFO("Batch of commands queued.");
+  return result;
+}
+
+Result<Command> Controller::submitCommand(
+    const unsigned long id, const RemoteAction action, const char* idempotencyKey)
+{
+  LOG_DEBUG("Submitting a command for the Remote", id);
+  Result<Command> result;
+  result.data = Command { 0, id, action, CommandStatus::FAILED, 0, 0, "" };
+  if (id == 0)
   {
-    LOG_INFO("Operate 'DOWN'.");
-    this->m_transmitter->sendDownCmd(remote.id, remote.rollingCode);
-    this->notify("remote-down", remote);
-    result.data = "Command DOWN sent.";
+    LOG_ERROR("The remote id should be specified.");
+    result.errorMsg = "The remote id should be specified.";
+    result.data.error = CommandError::INVALID_REMOTE;
+    return result;
   }
-  else if (strcmp(action, "pair") == 0)
+
+  if (action == RemoteAction::UNKNOWN)
   {
-    LOG_INFO("Operate 'PAIR'.");
-    this->m_transmitter->sendProgCmd(remote.id, remote.rollingCode);
-    this->notify("remote-pair", remote);
-    result.data = "Command PAIR sent.";
+    LOG_WARN("The action is not valid.");
+    result.errorMsg = "The action is not valid. Allowed actions: up, down, stop, pair, reset.";
+    result.data.error = CommandError::INVALID_ACTION;
+    return result;
   }
-  else if (strcmp(action, "reset") == 0)
+
+  Remote remote = this->m_database->getRemote(id);
+  if (remote.id == 0)
   {
-    LOG_INFO("Operate 'RESET'.");
-    remote.rollingCode = 0;
-    this->notify("remote-reset", remote);
-    this->m_database->updateRemote(remote);
-    this->notify("remote-update", remote);
+    LOG_ERROR("The remote doesn't exist. It cannot be operate.");
+    result.errorMsg = "The remote doesn't exist. It cannot be operate.";
+    result.data.error = CommandError::REMOTE_NOT_FOUND;
+    return result;
+  }
+
+  bool hasIdempotencyKey = idempotencyKey != nullptr && strlen(idempotencyKey) != 0;
+  if (hasIdempotencyKey)
+  {
+    if (strlen(idempotencyKey) >= MAX_IDEMPOTENCY_KEY_LENGTH)
+    {
+      LOG_ERROR("The idempotency key is too long.");
+      result.errorMsg = "The idempotency key is too long. It can contain only "
+          + String(MAX_IDEMPOTENCY_KEY_LENGTH - 1) + " chars.";
+      result.data.error = CommandError::INVALID_IDEMPOTENCY_KEY;
+      return result;
+    }
+
+    // A retried request gets the command already submitted with the same key.
+    const Command* previous = this->findCommand(idempotencyKey);
+    if (previous != nullptr)
+    {
+      if (previous->remoteId != id || previous->action != action)
+      {
+        LOG_ERROR("The idempotency key is already used by another command.");
+        result.errorMsg = "The idempotency key is already used by another command.";
+        result.data.error = CommandError::IDEMPOTENCY_CONFLICT;
+        return result;
+      }
+      ++this->m_suppressedCommands;
+      ++this->m_stateVersion;
+      LOG_INFO("Command", previous->requestId, "replayed for the same idempotency key.");
+      result.isSuccess = true;
+      result.data = *previous;
+      return result;
+    }
+  }
+
+  // The same command repeated on a remote within the window is merged with the previous one.
+  const Command* previous = this->findLastCommand(id);
+  if (previous != nullptr && previous->action == action
+      && previous->status != CommandStatus::FAILED
+      && millis() - previous->submittedAt < remote.dedupWindow)
+  {
+    ++this->m_suppressedCommands;
+    ++this->m_stateVersion;
+    LOG_INFO("Duplicated command merged with the command", previous->requestId);
     result.isSuccess = true;
-    result.data = "Rolling code reseted.";
+    result.data = *previous;
+    return result;
+  }
+
+  if (this->m_nextRequestId - this->m_nextExecutedId >= MAX_COMMANDS)
+  {
+    LOG_ERROR("Too many pending commands.");
+    result.errorMsg = "Too many pending commands. Retry later.";
+    result.data.error = CommandError::QUEUE_FULL;
+    return result;
+  }
+
+  Command& command = this->enqueueCommand(id, action);
+  if (hasIdempotencyKey)
+  {
+    strcpy(command.idempotencyKey, idempotencyKey);
+  }
+
+  result.isSuccess = true;
+  result.data = command;
+  LOG_DEBUG("Command submitted:", command.requestId);
+  return result;
+}
+
+Result<Command> Controller::fetchCommand(const unsigned long requestId)
+{
+  LOG_DEBUG("Fetching Command...");
+  Result<Command> result;
+  result.data = Command { 0, 0, RemoteAction::UNKNOWN, CommandStatus::FAILED, 0, 0, "" };
+
+  const Command& command = this->m_commands[requestId % MAX_COMMANDS];
+  if (requestId == 0 || command.requestId != requestId)
+  {
+    LOG_ERROR("This command doesn't exist or has expired.");
+    result.errorMsg = "This command doesn't exist or has expired.";
     return result;
   }
+
+  result.isSuccess = true;
+  result.data = command;
+  return result;
+}
+
+/**
+ * @brief Execute the oldest pending command, if any. Called from the main loop so the RF
+ * transmission and the EEPROM commit never run inside a network callback.
+ *
+ */
+void Controller::handleCommands()
+{
+  if (this->m_nextExecutedId == this->m_nextRequestId)
+  {
+    return; // Nothing pending
+  }
+
+  MetricTimer timer(HistogramId::COMMAND);
+  Command& command = this->m_commands[this->m_nextExecutedId % MAX_COMMANDS];
+  ++this->m_nextExecutedId;
+  command.timings.queue = micros() - command.submittedAtMicros;
+
+  LOG_INFO("Operating a command with the Remote", command.remoteId);
+  Remote remote = this->m_database->getRemote(command.remoteId);
+  if (remote.id == 0)
+  {
+    // Deleted since the submission
+    LOG_ERROR("Command", command.requestId, "failed: the remote doesn't exist.");
+    command.status = CommandStatus::FAILED;
+    command.error = CommandError::REMOTE_NOT_FOUND;
+    Metrics::increment(CounterId::COMMANDS_FAILED);
+  }
   else
   {
-    LOG_WARN("The action is not valid.");
+    Result<String> result = this->sendAction(remote, command.action, command.timings);
+    if (result.isSuccess)
+    {
+      command.status = CommandStatus::DONE;
+      command.rollingCode = this->m_database->getRemote(command.remoteId).rollingCode;
+      Metrics::increment(CounterId::COMMANDS_DONE);
+    }
+    else
+    {
+      LOG_ERROR("Command", command.requestId, "failed:", result.errorMsg);
+      command.status = CommandStatus::FAILED;
+      command.error = CommandError::COMMIT_FAILED;
+      Metrics::increment(CounterId::COMMANDS_FAILED);
+    }
+  }
+  command.timings.total = micros() - command.submittedAtMicros;
+
+  this->publish(command);
+}
+
+Result<Scene[MAX_SCENES]> Controller::fetchAllScenes()
+{
+  LOG_DEBUG("Fetching all scenes...");
+  Result<Scene[MAX_SCENES]> result;
+  this->m_database->getAllScenes(result.data);
+  result.isSuccess = true;
+
+  LOG_DEBUG("All Scenes fetched.");
+  return result;
+}
+
+Result<Scene> Controller::createScene(
+    const char* name, const RemoteOperation operations[], const unsigned short size)
+{
+  LOG_DEBUG("Creating a new Scene...");
+  Result<Scene> result;
+  result.data = Scene { 0, "", 0, {} };
+  if (name == nullptr || strlen(name) == 0)
+  {
+    LOG_ERROR("The name of the scene should be specified.");
+    result.errorMsg = "The name of the scene should be specified.";
+    return result;
+  }
+
+  if (strlen(name) >= MAX_SCENE_NAME_LENGTH)
+  {
+    LOG_ERROR("The name is too long.");
+    String error = "The name is too long. It can contain only " + String(MAX_SCENE_NAME_LENGTH - 1)
+        + " chars.";
+    result.errorMsg = error;
+    return result;
+  }
+
+  Remote remotes[MAX_REMOTES];
+  this->m_database->getAllRemotes(remotes);
+  String error = this->checkOperations(operations, size, remotes);
+  if (error.length() != 0)
+  {
+    LOG_ERROR(error);
+    result.errorMsg = error;
+    return result;
+  }
+
+  Scene scene = { 0, "", size, {} };
+  strcpy(scene.name, name);
+  for (unsigned short i = 0; i < size; ++i)
+  {
+    scene.operations[i] = operations[i];
+  }
+
+  scene = this->m_database->createScene(scene);
+  if (scene.id == 0)
+  {
+    LOG_ERROR("No space left on the device for a new scene.");
+    result.errorMsg = "No space left on the device for a new scene.";
+    return result;
+  }
+  ++this->m_stateVersion;
+
+  result.isSuccess = true;
+  result.data = scene;
+  LOG_DEBUG("Scene created.");
+  return result;
+}
+
+Result<Scene> Controller::deleteScene(const unsigned short id)
+{
+  LOG_DEBUG("Deleting Scene...");
+  Result<Scene> result;
+  result.data = Scene { 0, "", 0, {} };
+  if (id == 0)
+  {
+    LOG_ERROR("The scene id is not specified.");
+    result.errorMsg = "The scene id is not specified.";
+    return result;
+  }
+
+  Scene scene = this->m_database->getScene(id);
+  if (scene.id == 0 || !this->m_database->deleteScene(id))
+  {
+    LOG_ERROR("The given scene doesn't exist in the database.");
+    result.errorMsg = "The given scene doesn't exist in the database.";
+    return result;
+  }
+  ++this->m_stateVersion;
+
+  result.isSuccess = true;
+  result.data = scene;
+  LOG_DEBUG("Scene deleted.");
+  return result;
+}
+
+Result<BatchReport> Controller::operateScene(const unsigned short id)
+{
+  LOG_INFO("Operating the scene", id);
+  if (id == 0)
+  {
+    Result<BatchReport> result;
+    result.data.size = 0;
+    LOG_ERROR("The scene id is not specified.");
+    result.errorMsg = "The scene id is not specified.";
+    return result;
+  }
+
+  Scene scene = this->m_database->getScene(id);
+  if (scene.id == 0)
+  {
+    Result<BatchReport> result;
+    result.data.size = 0;
+    LOG_ERROR("The scene doesn't exist. It cannot be operate.");
+    result.errorMsg = "The scene doesn't exist. It cannot be operate.";
+    return result;
+  }
+
+  return this->operateBatch(scene.operations, scene.size);
+}
+
+Result<Schedule[MAX_SCHEDULES]> Controller::fetchAllSchedules()
+{
+  LOG_DEBUG("Fetching all schedules...");
+  Result<Schedule[MAX_SCHEDULES]> result;
+  this->m_database->getAllSchedules(result.data);
+  result.isSuccess = true;
+
+  LOG_DEBUG("All Schedules fetched.");
+  return result;
+}
+
+Result<Schedule> Controller::createSchedule(const unsigned long remoteId, const RemoteAction action,
+    const ScheduleTrigger trigger, const short offset, const char* cron)
+{
+  LOG_DEBUG("Creating a new Schedule...");
+  Result<Schedule> result;
+  result.data = Schedule { 0, 0, RemoteAction::UNKNOWN, ScheduleTrigger::UNKNOWN, 0, "" };
+
+  if (action >= RemoteAction::UNKNOWN)
+  {
+    LOG_ERROR("The action is not valid.");
     result.errorMsg = "The action is not valid. Allowed actions: up, down, stop, pair, reset.";
     return result;
   }
 
+  if (trigger >= ScheduleTrigger::UNKNOWN)
+  {
+    LOG_ERROR("The trigger is not valid.");
+    result.errorMsg = "The trigger is not valid. Allowed triggers: time, sunrise, sunset.";
+    return result;
+  }
+
+  if (trigger != ScheduleTrigger::TIME && (offset < -720 || offset > 720))
+  {
+    LOG_ERROR("The offset is not valid.");
+    result.errorMsg = "The offset should be between -720 and 720 minutes.";
+    return result;
+  }
+
+  CronMasks masks;
+  if (cron == nullptr || strlen(cron) >= MAX_CRON_LENGTH || !parseCronExpression(cron, masks))
+  {
+    LOG_ERROR("The cron expression is not valid.");
+    result.errorMsg = "The cron expression is not valid. Expected: minute hour day month weekday.";
+    return result;
+  }
+
+  Remote remote = this->m_database->getRemote(remoteId);
+  if (remoteId == 0 || remote.id == 0)
+  {
+    LOG_ERROR("The remote doesn't exist.");
+    result.errorMsg = "The remote doesn't exist.";
+    return result;
+  }
+
+  Schedule schedule = { 0, remoteId, action, trigger, 0, "" };
+  if (trigger != ScheduleTrigger::TIME)
+  {
+    schedule.offset = offset;
+  }
+  strcpy(schedule.cron, cron);
+
+  schedule = this->m_database->createSchedule(schedule);
+  if (schedule.id == 0)
+  {
+    LOG_ERROR("No space left on the device for a new schedule.");
+    result.errorMsg = "No space left on the device for a new schedule.";
+    return result;
+  }
+  ++this->m_schedulesRevision;
+  ++this->m_stateVersion;
+
   result.isSuccess = true;
-  remote.rollingCode += 1; // increment rollingCode
-  this->m_database->updateRemote(remote);
+  result.data = schedule;
+  LOG_DEBUG("Schedule created.");
+  return result;
+}
 
-  this->notify("remote-update", remote);
+Result<Schedule> Controller::deleteSchedule(const unsigned short id)
+{
+  LOG_DEBUG("Deleting Schedule...");
+  Result<Schedule> result;
+  result.data = Schedule { 0, 0, RemoteAction::UNKNOWN, ScheduleTrigger::UNKNOWN, 0, "" };
+  if (id == 0)
+  {
+    LOG_ERROR("The schedule id is not specified.");
+    result.errorMsg = "The schedule id is not specified.";
+    return result;
+  }
 
-  LOG_INFO("Command sent through the remote", remote.id);
+  Schedule schedule = this->m_database->getSchedule(id);
+  if (schedule.id == 0 || !this->m_database->deleteSchedule(id))
+  {
+    LOG_ERROR("The given schedule doesn't exist in the database.");
+    result.errorMsg = "The given schedule doesn't exist in the database.";
+    return result;
+  }
+  ++this->m_schedulesRevision;
+  ++this->m_stateVersion;
+
+  result.isSuccess = true;
+  result.data = schedule;
+  LOG_DEBUG("Schedule deleted.");
   return result;
 }
 
+Result<Location> Controller::fetchLocation()
+{
+  LOG_DEBUG("Fetching Location...");
+  Result<Location> result;
+
+  result.data = this->m_database->getLocation();
+  result.isSuccess = true;
+
+  return result;
+}
+
+Result<Location> Controller::updateLocation(
+    const float latitude, const float longitude, const char* timezone)
+{
+  LOG_DEBUG("Updating Location...");
+  Result<Location> result;
+  result.data = Location { 0, 0, "" };
+
+  if (!(latitude >= -90 && latitude <= 90) || !(longitude >= -180 && longitude <= 180))
+  {
+    LOG_ERROR("The coordinates are not valid.");
+    result.errorMsg
+        = "The latitude should be between -90 and 90, the longitude between -180 and 180.";
+    return result;
+  }
+
+  if (timezone == nullptr || strlen(timezone) == 0)
+  {
+    LOG_ERROR("The timezone should be specified.");
+    result.errorMsg = "The timezone should be specified. ie: CET-1CEST,M3.5.0,M10.5.0/3";
+    return result;
+  }
+
+  if (strlen(timezone) >= MAX_TIMEZONE_LENGTH)
+  {
+    LOG_ERROR("The timezone is too long.");
+    result.errorMsg = "The timezone is too long. It can contain only "
+        + String(MAX_TIMEZONE_LENGTH - 1) + " chars.";
+    return result;
+  }
+
+  result.data.latitude = latitude;
+  result.data.longitude = longitude;
+  strcpy(result.data.timezone, timezone);
+
+  bool isUpdated = this->m_database->setLocation(result.data);
+  if (!isUpdated)
+  {
+    LOG_ERROR("Something went wrong while updating the Location");
+    result.errorMsg = "Something went wrong while updating the Location";
+    return result;
+  }
+  ++this->m_schedulesRevision;
+  ++this->m_stateVersion;
+
+  result.isSuccess = true;
+  LOG_DEBUG("Location updated.");
+  return result;
+}
+
+/**
+ * @brief Get the revision of the schedules and of the location. It changes each time one of them
+ * is updated, so the scheduler knows when to reload them.
+ *
+ * @return unsigned long
+ */
+unsigned long Controller::getSchedulesRevision() { return this->m_schedulesRevision; }
+
+/**
+ * @brief Get the version of the state exposed by the API. It is incremented by every change of the
+ * remotes, scenes, schedules, configurations or counters, so an unchanged version means an
+ * unchanged response. It starts from 0 at each boot.
+ *
+ * @return unsigned long
+ */
+unsigned long Controller::getStateVersion() { return this->m_stateVersion; }
+
 Result<Network[MAX_NETWORK_SCAN]> Controller::fetchScannedNetworks()
 {
   LOG_DEBUG("Fetching scanned Networks...");
@@ -386,6 +887,46 @@ Result<Network[MAX_NETWORK_SCAN]> Controller::fetchScannedNetworks()
   return result;
 }
 
+/**
+ * @brief Scan the networks in the background. The networks already scanned are served until it is
+ * done, and a scan already running is shared.
+ *
+ * @return Result<NetworkScan>
+ */
+Result<NetworkScan> Controller::scanNetworks()
+{
+  LOG_DEBUG("Scanning Networks...");
+  Result<NetworkScan> result;
+
+  result.data = this->m_networkClient->startScan();
+  result.isSuccess = true;
+
+  return result;
+}
+
+Result<NetworkScan> Controller::fetchNetworkScan()
+{
+  LOG_DEBUG("Fetching the scan of the Networks...");
+  Result<NetworkScan> result;
+
+  result.data = this->m_networkClient->getScan();
+  result.isSuccess = true;
+
+  return result;
+}
+
+/**
+ * @brief Collect the networks of a scan once it is done. Called from the main loop.
+ *
+ */
+void Controller::handleNetworkScan()
+{
+  if (this->m_networkClient->handleScan())
+  {
+    ++this->m_stateVersion;
+  }
+}
+
 Result<NetworkConfiguration> Controller::fetchNetworkConfiguration()
 {
   LOG_DEBUG("Fetching Network Configuration...");
@@ -438,6 +979,7 @@ Result<NetworkConfiguration> Controller::updateNetworkConfiguration(
     result.errorMsg = "Something went wrong while updating the Network Configuration";
     return result;
   }
+  ++this->m_stateVersion;
 
   result.isSuccess = true;
   LOG_DEBUG("Network Configuration updated.");
@@ -512,8 +1054,159 @@ Result<MQTTConfiguration> Controller::updateMQTTConfiguration(const bool& enable
     result.errorMsg = "Something went wrong while updating the MQTT Configuration";
     return result;
   }
+  ++this->m_stateVersion;
 
   result.isSuccess = true;
   LOG_DEBUG("MQTT Configuration updated.");
   return result;
 }
+
+// PRIVATE
+
+/**
+ * @brief Find the most recent command submitted on a remote, among the commands kept in RAM.
+ *
+ * @param remoteId The id of the remote
+ * @return const Command* The command, nullptr if not found.
+ */
+const Command* Controller::findLastCommand(const unsigned long remoteId)
+{
+  for (unsigned long requestId = this->m_nextRequestId - 1;
+       requestId > 0 && requestId + MAX_COMMANDS >= this->m_nextRequestId; --requestId)
+  {
+    const Command& command = this->m_commands[requestId % MAX_COMMANDS];
+    if (command.remoteId == remoteId)
+    {
+      return &command;
+    }
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Find a command by its idempotency key, among the commands kept in RAM.
+ *
+ * @param idempotencyKey The key given by the client
+ * @return const Command* The command, nullptr if not found.
+ */
+const Command* Controller::findCommand(const char* idempotencyKey)
+{
+  for (unsigned short i = 0; i < MAX_COMMANDS; ++i)
+  {
+    const Command& command = this->m_commands[i];
+    if (command.requestId != 0 && strcmp(command.idempotencyKey, idempotencyKey) == 0)
+    {
+      return &command;
+    }
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Add a pending command at the end of the ring. The caller checks there is room for it.
+ *
+ * @return The queued command
+ */
+Command& Controller::enqueueCommand(const unsigned long remoteId, const RemoteAction action)
+{
+  Command& command = this->m_commands[this->m_nextRequestId % MAX_COMMANDS];
+  command = Command { this->m_nextRequestId, remoteId, action, CommandStatus::PENDING, 0, millis(),
+    "", CommandError::NONE, static_cast<uint32_t>(micros()) };
+  ++this->m_nextRequestId;
+  return command;
+}
+
+/**
+ * @brief Check a list of operations against the remotes of the database.
+ *
+ * @param operations The operations to check
+ * @param size Number of operations
+ * @param remotes All remotes of the database (MAX_REMOTES)
+ * @return String The error message, empty if all operations are valid.
+ */
+String Controller::checkOperations(
+    const RemoteOperation operations[], const unsigned short size, const Remote remotes[])
+{
+  if (operations == nullptr || size == 0)
+  {
+    return "At least one operation should be specified.";
+  }
+
+  if (size > MAX_BATCH_OPERATIONS)
+  {
+    return "Too many operations. It can contain only " + String(MAX_BATCH_OPERATIONS)
+        + " operations.";
+  }
+
+  for (unsigned short i = 0; i < size; ++i)
+  {
+    if (operations[i].action >= RemoteAction::UNKNOWN)
+    {
+      return "The action is not valid. Allowed actions: up, down, stop, pair, reset.";
+    }
+
+    bool found = false;
+    for (unsigned short j = 0; j < MAX_REMOTES && !found; ++j)
+    {
+      found = operations[i].remoteId != 0 && remotes[j].id == operations[i].remoteId;
+    }
+    if (!found)
+    {
+      return "The remote " + String(operations[i].remoteId) + " doesn't exist.";
+    }
+  }
+  return "";
+}
+
+/**
+ * @brief Transmit an action with an existing remote, then save its new rolling code.
+ *
+ * @param remote The remote, its rolling code is updated
+ * @param action A valid action
+ * @param timings Filled with the durations of the transmission and of the commit
+ * @return Result<String> The message of the action.
+ */
+Result<String> Controller::sendAction(
+    Remote& remote, const RemoteAction action, CommandTimings& timings)
+{
+  Result<String> result;
+  const RemoteActionDescriptor& descriptor = getRemoteActionDescriptor(action);
+  LOG_INFO("Operate:", descriptor.name);
+
+  uint32_t start = micros();
+  if (descriptor.command != nullptr)
+  {
+    (this->m_transmitter->*descriptor.command)(remote.id, remote.rollingCode);
+  }
+  timings.transmit = micros() - start;
+
+  if (descriptor.resetRollingCode)
+  {
+    remote.rollingCode = 0;
+  }
+  else
+  {
+    remote.rollingCode += 1; // increment rollingCode
+  }
+
+  start = micros();
+  bool isUpdated = this->m_database->updateRemote(remote);
+  timings.commit = micros() - start;
+  if (!isUpdated)
+  {
+    LOG_ERROR("Failed to save the rolling code of the remote.");
+    // The frame is sent anyway, but the new rolling code is not saved.
+    this->publish(RemoteChange { REMOTE_CHANGE_LAST_ACTION, action, remote });
+    result.errorMsg = "Command sent, but something went wrong while saving the rolling code.";
+    return result;
+  }
+  ++this->m_stateVersion;
+  this->publish(
+      RemoteChange { REMOTE_CHANGE_LAST_ACTION | REMOTE_CHANGE_ROLLING_CODE, action, remote });
+
+  result.isSuccess = true;
+  result.data = descriptor.message;
+
+  LOG_INFO("Command sent through the remote", remote.id);
+  return result;
+}
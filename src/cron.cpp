@@ -0,0 +1,212 @@
+/**
+ * @file cron.cpp
+ * @author Laurette Alexandre
+ * @brief Implementation of the parsing of schedule rules.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+
+#include <cron.h>
+#include <schedule.h>
+
+static const char* const SCHEDULE_TRIGGER_NAMES[] = { "time", "sunrise", "sunset" };
+
+/**
+ * @brief Parse one field of a cron expression.
+ *
+ * @param cursor Start of the field, moved after it
+ * @param min Lowest allowed value
+ * @param max Highest allowed value
+ * @param mask The allowed values, bit n for the value n
+ * @return true if the field is valid
+ * @return false otherwise
+ */
+static bool parseCronField(
+    const char*& cursor, const uint8_t min, const uint8_t max, uint64_t& mask)
+{
+  mask = 0;
+  while (true)
+  {
+    unsigned long start = min;
+    unsigned long end = max;
+    char* fieldEnd;
+    if (*cursor == '*')
+    {
+      ++cursor;
+    }
+    else
+    {
+      start = strtoul(cursor, &fieldEnd, 10);
+      if (fieldEnd == cursor)
+      {
+        return false;
+      }
+      cursor = fieldEnd;
+      end = start;
+      if (*cursor == '-')
+      {
+        ++cursor;
+        end = strtoul(cursor, &fieldEnd, 10);
+        if (fieldEnd == cursor)
+        {
+          return false;
+        }
+        cursor = fieldEnd;
+      }
+    }
+
+    unsigned long step = 1;
+    if (*cursor == '/')
+    {
+      ++cursor;
+      step = strtoul(cursor, &fieldEnd, 10);
+      if (fieldEnd == cursor || step == 0)
+      {
+        return false;
+      }
+      cursor = fieldEnd;
+      if (start == end)
+      {
+        end = max; // "5/15" means "5-max/15"
+      }
+    }
+
+    if (start < min || end > max || start > end)
+    {
+      return false;
+    }
+    for (unsigned long value = start; value <= end; value += step)
+    {
+      mask |= 1ULL << value;
+    }
+
+    if (*cursor != ',')
+    {
+      return *cursor == ' ' || *cursor == '\0';
+    }
+    ++cursor;
+  }
+}
+
+/**
+ * @brief Parse a cron expression: "minute hour day month weekday".
+ *
+ * @param expression The expression
+ * @param masks The parsed expression
+ * @return true if the expression is valid
+ * @return false otherwise
+ */
+bool parseCronExpression(const char* expression, CronMasks& masks)
+{
+  if (expression == nullptr)
+  {
+    return false;
+  }
+
+  const uint8_t mins[] = { 0, 0, 1, 1, 0 };
+  const uint8_t maxs[] = { 59, 23, 31, 12, 7 };
+  uint64_t fields[5];
+  const char* cursor = expression;
+  for (uint8_t i = 0; i < 5; ++i)
+  {
+    while (*cursor == ' ')
+    {
+      ++cursor;
+    }
+    if (!parseCronField(cursor, mins[i], maxs[i], fields[i]))
+    {
+      return false;
+    }
+  }
+  while (*cursor == ' ')
+  {
+    ++cursor;
+  }
+  if (*cursor != '\0')
+  {
+    return false;
+  }
+
+  masks.minutes = fields[0];
+  masks.hours = fields[1];
+  masks.days = fields[2];
+  masks.months = fields[3];
+  masks.weekdays = (fields[4] | fields[4] >> 7) & CRON_ALL_WEEKDAYS; // 7 is sunday too
+  return true;
+}
+
+/**
+ * @brief Check if the day of a local time is allowed by a cron expression. Like cron, when both
+ * the day and the weekday are restricted, one of them is enough.
+ *
+ * @param masks The parsed expression
+ * @param local The local time
+ * @return true if the day matches
+ * @return false otherwise
+ */
+bool cronMatchesDay(const CronMasks& masks, const struct tm& local)
+{
+  if (((masks.months >> (local.tm_mon + 1)) & 1) == 0)
+  {
+    return false;
+  }
+  bool dayMatches = (masks.days >> local.tm_mday) & 1;
+  bool weekdayMatches = (masks.weekdays >> local.tm_wday) & 1;
+  if (masks.days == CRON_ALL_DAYS || masks.weekdays == CRON_ALL_WEEKDAYS)
+  {
+    return dayMatches && weekdayMatches;
+  }
+  return dayMatches || weekdayMatches;
+}
+
+/**
+ * @brief Convert the name of a trigger to its typed value.
+ *
+ * @param name The name of the trigger (time, sunrise, sunset)
+ * @return ScheduleTrigger ScheduleTrigger::UNKNOWN if the name is null or not valid.
+ */
+ScheduleTrigger parseScheduleTrigger(const char* name)
+{
+  if (name == nullptr)
+  {
+    return ScheduleTrigger::UNKNOWN;
+  }
+  for (uint8_t i = 0; i < static_cast<uint8_t>(ScheduleTrigger::UNKNOWN); ++i)
+  {
+    if (strcmp(name, SCHEDULE_TRIGGER_NAMES[i]) == 0)
+    {
+      return static_cast<ScheduleTrigger>(i);
+    }
+  }
+  return ScheduleTrigger::UNKNOWN;
+}
+
+const char* getScheduleTriggerName(const ScheduleTrigger trigger)
+{
+  if (trigger >= ScheduleTrigger::UNKNOWN)
+  {
+    return "unknown";
+  }
+  return SCHEDULE_TRIGGER_NAMES[static_cast<uint8_t>(trigger)];
+}
@@ -32,8 +32,10 @@
 
 #include <config.h>
 #include <remote.h>
+#include <schedule.h>
 #include <networks.h>
 #include <systemInfos.h>
+#include <metrics.h>
 #include <eepromDatabase.h>
 
 EEPROMDatabase::EEPROMDatabase() { }
@@ -49,7 +51,7 @@ EEPROMDatabase::EEPROMDatabase(unsigned long remoteBaseAddress)
  */
 void EEPROMDatabase::init()
 {
-  size_t totalSize = sizeof(NetworkConfiguration) + sizeof(Remote) * MAX_REMOTES;
+  size_t totalSize = this->m_endAddress;
   LOG_DEBUG("Allocating EEPROM space: ", totalSize);
   EEPROM.begin(totalSize);
 
@@ -93,6 +95,46 @@ void EEPROMDatabase::fixIntegrity()
   }
   LOG_DEBUG("Corrupted Remotes detected and reseted: ", count);
 
+  LOG_DEBUG("Reseting all corrupted scenes...");
+  Scene sceneRead;
+  Scene emptyScene = { 0, "", 0, {} };
+  count = 0;
+  for (int index = 0; index < MAX_SCENES; ++index)
+  {
+    EEPROM.get(this->m_scenesAddressStart + index * sizeof(Scene), sceneRead);
+    if (!this->sceneIsValid(sceneRead, index))
+    {
+      EEPROM.put(this->m_scenesAddressStart + index * sizeof(Scene), emptyScene);
+      count++;
+    }
+  }
+  LOG_DEBUG("Corrupted Scenes detected and reseted: ", count);
+
+  LOG_DEBUG("Reseting all corrupted schedules...");
+  Schedule scheduleRead;
+  Schedule emptySchedule = { 0, 0, RemoteAction::UNKNOWN, ScheduleTrigger::UNKNOWN, 0, "" };
+  count = 0;
+  for (int index = 0; index < MAX_SCHEDULES; ++index)
+  {
+    EEPROM.get(this->m_schedulesAddressStart + index * sizeof(Schedule), scheduleRead);
+    if (!this->scheduleIsValid(scheduleRead, index))
+    {
+      EEPROM.put(this->m_schedulesAddressStart + index * sizeof(Schedule), emptySchedule);
+      count++;
+    }
+  }
+  LOG_DEBUG("Corrupted Schedules detected and reseted: ", count);
+
+  Location location;
+  EEPROM.get(this->m_locationAddressStart, location);
+  if (!this->locationIsValid(location))
+  {
+    LOG_WARN("The location is corrupted. It will be reseted.");
+    Location defaultLocation = { 0, 0, "" };
+    strcpy(defaultLocation.timezone, DEFAULT_TIMEZONE);
+    EEPROM.put(this->m_locationAddressStart, defaultLocation);
+  }
+
   LOG_DEBUG("Analyse for corrupted version number...");
   std::regex versionPattern("^[0-9]+\\.[0-9]+\\.[0-9]+$");
   SystemInfos infos;
@@ -103,7 +145,7 @@ void EEPROMDatabase::fixIntegrity()
     EEPROM.put(this->m_lastSystemInfosAddressStart, FIRMWARE_VERSION);
   }
 
-  EEPROM.commit();
+  this->commit();
 }
 
 /**
@@ -155,7 +197,10 @@ bool EEPROMDatabase::setNetworkConfiguration(const NetworkConfiguration& network
 {
   LOG_DEBUG("Saving new network configuration...");
   EEPROM.put(this->m_networkConfigAddressStart, networkConfig);
-  EEPROM.commit();
+  if (!this->commit())
+  {
+    return false;
+  }
   LOG_INFO("Network configuration saved.");
   return true;
 }
@@ -233,7 +278,10 @@ bool EEPROMDatabase::deleteRemote(const unsigned long& id)
   }
   Remote emptyRemote = { 0, 0, "" };
   EEPROM.put(this->m_remotesAddressStart + index * sizeof(Remote), emptyRemote);
-  EEPROM.commit();
+  if (!this->commit())
+  {
+    return false;
+  }
   LOG_DEBUG("The remote has been deleted.");
   return true;
 }
@@ -242,7 +290,7 @@ bool EEPROMDatabase::deleteRemote(const unsigned long& id)
  * @brief Add a new remote in the database.
  *
  * @param name The name of the remote.
- * @return Remote The created remote.
+ * @return Remote The created remote, or an empty remote if it could not be saved.
  */
 Remote EEPROMDatabase::createRemote(const char* name)
 {
@@ -255,15 +303,18 @@ Remote EEPROMDatabase::createRemote(const char* name)
     LOG_ERROR("No space left. Cannot add a new remote.");
     return emptyRemote;
   }
-  emptyRemote.id = this->m_remoteBaseAddress + index;
-  emptyRemote.rollingCode = 0;
-  strcpy(emptyRemote.name, name);
+  Remote newRemote = { this->m_remoteBaseAddress + index, 0, "" };
+  strcpy(newRemote.name, name);
+  newRemote.dedupWindow = DEFAULT_DEDUP_WINDOW_MS;
 
-  EEPROM.put(this->m_remotesAddressStart + index * sizeof(Remote), emptyRemote);
-  EEPROM.commit();
+  EEPROM.put(this->m_remotesAddressStart + index * sizeof(Remote), newRemote);
+  if (!this->commit())
+  {
+    return emptyRemote;
+  }
 
   LOG_DEBUG("A new remote has been added.");
-  return emptyRemote;
+  return newRemote;
 }
 
 /**
@@ -283,11 +334,229 @@ bool EEPROMDatabase::updateRemote(const Remote& remote)
     return false;
   }
   EEPROM.put(this->m_remotesAddressStart + index * sizeof(Remote), remote);
-  EEPROM.commit();
+  if (!this->commit())
+  {
+    return false;
+  }
   LOG_DEBUG("The remote has been updated.");
   return true;
 }
 
+/**
+ * @brief Add a new scene in the database.
+ *
+ * @param scene The scene to save. Its id is ignored.
+ * @return Scene The created scene, or an empty scene if it could not be saved.
+ */
+Scene EEPROMDatabase::createScene(const Scene& scene)
+{
+  LOG_DEBUG("Adding a new scene...");
+  Scene emptyScene = { 0, "", 0, {} };
+  Scene sceneRead;
+  for (int index = 0; index < MAX_SCENES; ++index)
+  {
+    EEPROM.get(this->m_scenesAddressStart + index * sizeof(Scene), sceneRead);
+    if (sceneRead.id != 0)
+    {
+      continue;
+    }
+    Scene newScene = scene;
+    newScene.id = index + 1;
+    EEPROM.put(this->m_scenesAddressStart + index * sizeof(Scene), newScene);
+    if (!this->commit())
+    {
+      return emptyScene;
+    }
+    LOG_DEBUG("A new scene has been added.");
+    return newScene;
+  }
+  LOG_ERROR("No space left. Cannot add a new scene.");
+  return emptyScene;
+}
+
+/**
+ * @brief Get all scenes in the database
+ *
+ * @param scenes Array for scenes. Should be an array with a size of MAX_SCENES, defined in the
+ * config file.
+ */
+void EEPROMDatabase::getAllScenes(Scene scenes[])
+{
+  LOG_DEBUG("Getting all scenes...");
+  for (int i = 0; i < MAX_SCENES; ++i)
+  {
+    EEPROM.get(this->m_scenesAddressStart + i * sizeof(Scene), scenes[i]);
+  }
+}
+
+/**
+ * @brief Get a specific scene
+ *
+ * @param id The id of the scene
+ * @return Scene The scene in the database or an empty scene if the given id is not found.
+ */
+Scene EEPROMDatabase::getScene(const unsigned short& id)
+{
+  LOG_DEBUG("Looking for the scene with the ID:", id);
+  Scene sceneRead = { 0, "", 0, {} };
+  if (id == 0 || id > MAX_SCENES)
+  {
+    LOG_WARN("No Scene found.");
+    return sceneRead;
+  }
+  EEPROM.get(this->m_scenesAddressStart + (id - 1) * sizeof(Scene), sceneRead);
+  return sceneRead;
+}
+
+/**
+ * @brief Remove a scene from the database
+ *
+ * @param id The id of the scene to delete.
+ * @return true if the scene has been deleted
+ * @return false otherwise
+ */
+bool EEPROMDatabase::deleteScene(const unsigned short& id)
+{
+  LOG_DEBUG("Removing scene with the ID:", id);
+  Scene scene = this->getScene(id);
+  if (scene.id == 0)
+  {
+    LOG_WARN("No Scene found for the given id. Nothing to remove.");
+    return false;
+  }
+  Scene emptyScene = { 0, "", 0, {} };
+  EEPROM.put(this->m_scenesAddressStart + (id - 1) * sizeof(Scene), emptyScene);
+  if (!this->commit())
+  {
+    return false;
+  }
+  LOG_DEBUG("The scene has been deleted.");
+  return true;
+}
+
+/**
+ * @brief Add a new schedule in the database.
+ *
+ * @param schedule The schedule to save. Its id is ignored.
+ * @return Schedule The created schedule, or an empty schedule if it could not be saved.
+ */
+Schedule EEPROMDatabase::createSchedule(const Schedule& schedule)
+{
+  LOG_DEBUG("Adding a new schedule...");
+  Schedule emptySchedule = { 0, 0, RemoteAction::UNKNOWN, ScheduleTrigger::UNKNOWN, 0, "" };
+  Schedule scheduleRead;
+  for (int index = 0; index < MAX_SCHEDULES; ++index)
+  {
+    EEPROM.get(this->m_schedulesAddressStart + index * sizeof(Schedule), scheduleRead);
+    if (scheduleRead.id != 0)
+    {
+      continue;
+    }
+    Schedule newSchedule = schedule;
+    newSchedule.id = index + 1;
+    EEPROM.put(this->m_schedulesAddressStart + index * sizeof(Schedule), newSchedule);
+    if (!this->commit())
+    {
+      return emptySchedule;
+    }
+    LOG_DEBUG("A new schedule has been added.");
+    return newSchedule;
+  }
+  LOG_ERROR("No space left. Cannot add a new schedule.");
+  return emptySchedule;
+}
+
+/**
+ * @brief Get all schedules in the database
+ *
+ * @param schedules Array for schedules. Should be an array with a size of MAX_SCHEDULES, defined
+ * in the config file.
+ */
+void EEPROMDatabase::getAllSchedules(Schedule schedules[])
+{
+  LOG_DEBUG("Getting all schedules...");
+  for (int i = 0; i < MAX_SCHEDULES; ++i)
+  {
+    EEPROM.get(this->m_schedulesAddressStart + i * sizeof(Schedule), schedules[i]);
+  }
+}
+
+/**
+ * @brief Get a specific schedule
+ *
+ * @param id The id of the schedule
+ * @return Schedule The schedule in the database or an empty schedule if the given id is not found.
+ */
+Schedule EEPROMDatabase::getSchedule(const unsigned short& id)
+{
+  LOG_DEBUG("Looking for the schedule with the ID:", id);
+  Schedule scheduleRead = { 0, 0, RemoteAction::UNKNOWN, ScheduleTrigger::UNKNOWN, 0, "" };
+  if (id == 0 || id > MAX_SCHEDULES)
+  {
+    LOG_WARN("No Schedule found.");
+    return scheduleRead;
+  }
+  EEPROM.get(this->m_schedulesAddressStart + (id - 1) * sizeof(Schedule), scheduleRead);
+  return scheduleRead;
+}
+
+/**
+ * @brief Remove a schedule from the database
+ *
+ * @param id The id of the schedule to delete.
+ * @return true if the schedule has been deleted
+ * @return false otherwise
+ */
+bool EEPROMDatabase::deleteSchedule(const unsigned short& id)
+{
+  LOG_DEBUG("Removing schedule with the ID:", id);
+  Schedule schedule = this->getSchedule(id);
+  if (schedule.id == 0)
+  {
+    LOG_WARN("No Schedule found for the given id. Nothing to remove.");
+    return false;
+  }
+  Schedule emptySchedule = { 0, 0, RemoteAction::UNKNOWN, ScheduleTrigger::UNKNOWN, 0, "" };
+  EEPROM.put(this->m_schedulesAddressStart + (id - 1) * sizeof(Schedule), emptySchedule);
+  if (!this->commit())
+  {
+    return false;
+  }
+  LOG_DEBUG("The schedule has been deleted.");
+  return true;
+}
+
+/**
+ * @brief Get the location of the device
+ *
+ * @return Location
+ */
+Location EEPROMDatabase::getLocation()
+{
+  Location location;
+  EEPROM.get(this->m_locationAddressStart, location);
+  return location;
+}
+
+/**
+ * @brief Update the location of the device
+ *
+ * @param location The new location to save
+ * @return true if the update was done
+ * @return false otherwise
+ */
+bool EEPROMDatabase::setLocation(const Location& location)
+{
+  LOG_DEBUG("Saving new location...");
+  EEPROM.put(this->m_locationAddressStart, location);
+  if (!this->commit())
+  {
+    return false;
+  }
+  LOG_INFO("Location saved.");
+  return true;
+}
+
 /**
  * @brief Get the MQTT configuration
  *
@@ -320,12 +589,32 @@ bool EEPROMDatabase::setMQTTConfiguration(const MQTTConfiguration& mqttConfig)
 {
   LOG_DEBUG("Saving new MQTT configuration...");
   EEPROM.put(this->m_mqttConfigAddressStart, mqttConfig);
-  EEPROM.commit();
+  if (!this->commit())
+  {
+    return false;
+  }
   LOG_INFO("MQTT configuration saved.");
   return true;
 }
 
 // PRIVATE
+/**
+ * @brief Write the EEPROM cache to the flash. It erases a whole sector, so it is timed.
+ *
+ * @return false if the flash could not be written.
+ */
+bool EEPROMDatabase::commit()
+{
+  MetricTimer timer(HistogramId::DATABASE_COMMIT);
+  if (!EEPROM.commit())
+  {
+    LOG_ERROR("The EEPROM could not be written.");
+    Metrics::increment(CounterId::DATABASE_COMMIT_FAILURES);
+    return false;
+  }
+  return true;
+}
+
 /**
  * @brief Check if a string (char*) contains non-ascii chars.
  *
@@ -361,6 +650,104 @@ int EEPROMDatabase::getRemoteIndex(const unsigned long& id)
   return -1;
 }
 
+/**
+ * @brief Check if a scene read from the EEPROM is coherent.
+ *
+ * @param scene The scene to check
+ * @param index Index of the scene in the table
+ * @return true if the scene is valid or empty
+ * @return false otherwise
+ */
+bool EEPROMDatabase::sceneIsValid(const Scene& scene, const unsigned short& index)
+{
+  if (scene.id == 0)
+  {
+    // It is an empty scene.
+    return true;
+  }
+  if (scene.id != index + 1 || scene.size > MAX_BATCH_OPERATIONS)
+  {
+    return false;
+  }
+  if (memchr(scene.name, '\0', MAX_SCENE_NAME_LENGTH) == nullptr || !stringIsAscii(scene.name))
+  {
+    return false;
+  }
+  for (unsigned short i = 0; i < scene.size; ++i)
+  {
+    if (scene.operations[i].action >= RemoteAction::UNKNOWN)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Check if a schedule read from the EEPROM is coherent.
+ *
+ * @param schedule The schedule to check
+ * @param index Index of the schedule in the table
+ * @return true if the schedule is valid or empty
+ * @return false otherwise
+ */
+bool EEPROMDatabase::scheduleIsValid(const Schedule& schedule, const unsigned short& index)
+{
+  if (schedule.id == 0)
+  {
+    // It is an empty schedule.
+    return true;
+  }
+  if (schedule.id != index + 1 || schedule.action >= RemoteAction::UNKNOWN
+      || schedule.trigger >= ScheduleTrigger::UNKNOWN)
+  {
+    return false;
+  }
+  return memchr(schedule.cron, '\0', MAX_CRON_LENGTH) != nullptr && stringIsAscii(schedule.cron);
+}
+
+/**
+ * @brief Check if the location read from the EEPROM is coherent.
+ *
+ * @param location The location to check
+ * @return true if the location is valid
+ * @return false otherwise
+ */
+bool EEPROMDatabase::locationIsValid(const Location& location)
+{
+  if (!(location.latitude >= -90 && location.latitude <= 90)
+      || !(location.longitude >= -180 && location.longitude <= 180))
+  {
+    return false; // Also false for NaN
+  }
+  return memchr(location.timezone, '\0', MAX_TIMEZONE_LENGTH) != nullptr
+      && strlen(location.timezone) != 0 && stringIsAscii(location.timezone);
+}
+
+/**
+ * @brief Compare two versions formatted as x.y.z
+ *
+ * @return true if version is lower than reference
+ * @return false otherwise
+ */
+bool EEPROMDatabase::versionIsLower(const char* version, const char* reference)
+{
+  char* versionEnd;
+  char* referenceEnd;
+  for (int i = 0; i < 3; ++i)
+  {
+    unsigned long versionPart = strtoul(version, &versionEnd, 10);
+    unsigned long referencePart = strtoul(reference, &referenceEnd, 10);
+    if (versionPart != referencePart)
+    {
+      return versionPart < referencePart;
+    }
+    version = *versionEnd == '.' ? versionEnd + 1 : versionEnd;
+    reference = *referenceEnd == '.' ? referenceEnd + 1 : referenceEnd;
+  }
+  return false;
+}
+
 /**
  * @brief Apply migration on the database.
  * Usefull for future versions releases if some parts change in the database.
@@ -377,15 +764,22 @@ bool EEPROMDatabase::migrate()
     LOG_INFO("No migration to apply.");
     return true;
   }
-  // Apply migrations here.
-  if (strcmp(FIRMWARE_VERSION, "2.1.0") == 0)
+  // Apply migrations here, from the oldest to the newest.
+  if (this->versionIsLower(infos.version, "2.1.0"))
   {
     this->applyUpdate_2_1_0();
   }
+  if (this->versionIsLower(infos.version, "2.2.0"))
+  {
+    this->applyUpdate_2_2_0();
+  }
 
   // Then, save new version
   EEPROM.put(this->m_lastSystemInfosAddressStart, FIRMWARE_VERSION);
-  EEPROM.commit();
+  if (!this->commit())
+  {
+    return false;
+  }
   LOG_INFO("Migration applied.");
   return true;
 }
@@ -414,6 +808,37 @@ void EEPROMDatabase::applyUpdate_2_1_0()
   // Create empty config for MQTT
   MQTTConfiguration mqttConfig = { false, "", DEFAULT_MQTT_PORT, "", "" };
   EEPROM.put(this->m_mqttConfigAddressStart, mqttConfig);
-  EEPROM.commit();
+  this->commit();
   LOG_INFO("2.1.0 patches applied.");
-}
\ No newline at end of file
+}
+/**
+ * @brief In this version, we introduce scenes, the location and schedules after the remotes.
+ * This area was never allocated before, so all of them are reseted. The remotes get the default
+ * dedup window, it takes their padding bytes.
+ */
+void EEPROMDatabase::applyUpdate_2_2_0()
+{
+  LOG_INFO("Applying 2.2.0 patches...");
+  for (int i = 0; i < MAX_REMOTES; ++i)
+  {
+    Remote remote;
+    EEPROM.get(this->m_remotesAddressStart + i * sizeof(Remote), remote);
+    remote.dedupWindow = DEFAULT_DEDUP_WINDOW_MS;
+    EEPROM.put(this->m_remotesAddressStart + i * sizeof(Remote), remote);
+  }
+  Scene emptyScene = { 0, "", 0, {} };
+  for (int i = 0; i < MAX_SCENES; ++i)
+  {
+    EEPROM.put(this->m_scenesAddressStart + i * sizeof(Scene), emptyScene);
+  }
+  Location location = { 0, 0, "" };
+  strcpy(location.timezone, DEFAULT_TIMEZONE);
+  EEPROM.put(this->m_locationAddressStart, location);
+  Schedule emptySchedule = { 0, 0, RemoteAction::UNKNOWN, ScheduleTrigger::UNKNOWN, 0, "" };
+  for (int i = 0; i < MAX_SCHEDULES; ++i)
+  {
+    EEPROM.put(this->m_schedulesAddressStart + i * sizeof(Schedule), emptySchedule);
+  }
+  this->commit();
+  LOG_INFO("2.2.0 patches applied.");
+}
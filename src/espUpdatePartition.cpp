@@ -0,0 +1,75 @@
+/**
+ * @file espUpdatePartition.cpp
+ * @author Laurette Alexandre
+ * @brief Update partitions of the ESP8266, written with the Updater of the core.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <DebugLog.h>
+#include <Updater.h>
+#include <flash_hal.h>
+
+#include <update.h>
+#include <espUpdatePartition.h>
+
+bool ESPUpdatePartition::begin(const UpdateTarget target, const size_t size)
+{
+  // Called from the web server callbacks, the Updater must not yield.
+  Update.runAsync(true);
+
+  // The whole partition is opened, the size is only an upper bound: it includes the multipart
+  // overhead of the upload. Writing past the partition fails instead.
+  bool isStarted;
+  if (target == UpdateTarget::FILESYSTEM)
+  {
+    isStarted = Update.begin(FS_end - FS_start, U_FS);
+  }
+  else
+  {
+    isStarted = Update.begin((ESP.getFreeSketchSpace() - 0x1000) & 0xFFFFF000, U_FLASH);
+  }
+  if (!isStarted)
+  {
+    LOG_ERROR("Updater error:", Update.getErrorString());
+  }
+  return isStarted;
+}
+
+size_t ESPUpdatePartition::write(const uint8_t* data, const size_t length)
+{
+  return Update.write(const_cast<uint8_t*>(data), length);
+}
+
+bool ESPUpdatePartition::end()
+{
+  // The partition was sized as an upper bound, the image is usually smaller.
+  if (!Update.end(true))
+  {
+    LOG_ERROR("Updater error:", Update.getErrorString());
+    return false;
+  }
+  return true;
+}
+
+void ESPUpdatePartition::abort() { Update.end(false); }
@@ -0,0 +1,212 @@
+/**
+ * @file eventBus.cpp
+ * @author Laurette Alexandre
+ * @brief Implementation of the event bus.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <DebugLog.h>
+
+#include <event.h>
+#include <config.h>
+#include <eventBus.h>
+
+/**
+ * @brief Add a subscriber. Any number of subscribers can be added, they are linked in place.
+ *
+ * @param subscriber The subscriber
+ * @param filter The types of events delivered to it, ie: EVENT_FILTER_REMOTE | EVENT_FILTER_COMMAND
+ */
+void EventBus::subscribe(EventSubscriber* subscriber, const uint8_t filter)
+{
+  subscriber->m_eventFilter = filter;
+  for (EventSubscriber* current = this->m_subscribers; current != nullptr;
+       current = current->m_nextSubscriber)
+  {
+    if (current == subscriber)
+    {
+      // Already subscribed, only the filter is updated
+      return;
+    }
+  }
+  subscriber->m_nextSubscriber = this->m_subscribers;
+  this->m_subscribers = subscriber;
+}
+
+void EventBus::unsubscribe(EventSubscriber* subscriber)
+{
+  EventSubscriber** link = &this->m_subscribers;
+  while (*link != nullptr)
+  {
+    if (*link == subscriber)
+    {
+      *link = subscriber->m_nextSubscriber;
+      subscriber->m_nextSubscriber = nullptr;
+      return;
+    }
+    link = &(*link)->m_nextSubscriber;
+  }
+}
+
+/**
+ * @brief Queue an event. It is delivered on the next call of dispatchEvents().
+ *
+ * @param event The event, copied in the ring
+ * @return true if the event is queued, false if the ring is full.
+ */
+bool EventBus::publish(const Event& event)
+{
+  uint16_t head = this->m_head.load(std::memory_order_relaxed);
+  uint16_t tail = this->m_tail.load(std::memory_order_acquire);
+  if (static_cast<uint16_t>(head - tail) >= EVENT_BUS_CAPACITY)
+  {
+    ++this->m_droppedEvents;
+    LOG_WARN("The event bus is full. An event is dropped.");
+    return false;
+  }
+  this->m_events[head & (EVENT_BUS_CAPACITY - 1)] = event;
+  this->m_head.store(head + 1, std::memory_order_release);
+  return true;
+}
+
+bool EventBus::publish(const RemoteChange& change)
+{
+  Event published;
+  published.type = EventType::REMOTE;
+  published.remote = change;
+  return this->publish(published);
+}
+
+bool EventBus::publish(const Command& command)
+{
+  Event published;
+  published.type = EventType::COMMAND;
+  published.command = command;
+  return this->publish(published);
+}
+
+/**
+ * @brief Deliver all queued events to the subscribers. Should be called from the main loop.
+ * The changes of each remote are merged and delivered first, in the order of their first change,
+ * then the other events in their publication order. Events published while dispatching are
+ * delivered on the next call.
+ *
+ */
+void EventBus::dispatchEvents()
+{
+  uint16_t tail = this->m_tail.load(std::memory_order_relaxed);
+  const uint16_t head = this->m_head.load(std::memory_order_acquire);
+
+  for (uint16_t index = tail; index != head; ++index)
+  {
+    const Event& event = this->m_events[index & (EVENT_BUS_CAPACITY - 1)];
+    if (event.type == EventType::REMOTE)
+    {
+      this->coalesce(event.remote);
+    }
+  }
+  this->flushChanges();
+
+  while (tail != head)
+  {
+    const Event& event = this->m_events[tail & (EVENT_BUS_CAPACITY - 1)];
+    if (event.type != EventType::REMOTE)
+    {
+      this->deliver(event);
+    }
+    ++tail;
+    this->m_tail.store(tail, std::memory_order_release);
+  }
+}
+
+unsigned long EventBus::getDroppedEvents() { return this->m_droppedEvents; }
+
+// PRIVATE
+
+void EventBus::deliver(const Event& event)
+{
+  uint8_t mask = 1 << static_cast<uint8_t>(event.type);
+  for (EventSubscriber* subscriber = this->m_subscribers; subscriber != nullptr;
+       subscriber = subscriber->m_nextSubscriber)
+  {
+    if ((subscriber->m_eventFilter & mask) != 0)
+    {
+      subscriber->notified(event);
+    }
+  }
+}
+
+/**
+ * @brief Merge a change with the pending changes of the same remote. The remote state is the last
+ * one, changed fields add up. A deletion or a creation replaces what happened before.
+ *
+ * @param change The change to merge
+ */
+void EventBus::coalesce(const RemoteChange& change)
+{
+  unsigned short index = 0;
+  while (index < this->m_changesCount && this->m_changes[index].remote.id != change.remote.id)
+  {
+    ++index;
+  }
+
+  if (index == this->m_changesCount)
+  {
+    if (this->m_changesCount == MAX_REMOTES)
+    {
+      // Too many remotes changed in this cycle, the oldest changes are delivered now.
+      this->flushChanges();
+      index = 0;
+    }
+    this->m_changes[index] = change;
+    ++this->m_changesCount;
+    return;
+  }
+
+  RemoteChange& pending = this->m_changes[index];
+  if ((change.changes & (REMOTE_CHANGE_CREATED | REMOTE_CHANGE_DELETED)) != 0)
+  {
+    pending.changes = change.changes;
+  }
+  else
+  {
+    pending.changes |= change.changes;
+  }
+  if ((change.changes & REMOTE_CHANGE_LAST_ACTION) != 0)
+  {
+    pending.lastAction = change.lastAction;
+  }
+  pending.remote = change.remote;
+}
+
+void EventBus::flushChanges()
+{
+  Event event;
+  event.type = EventType::REMOTE;
+  for (unsigned short i = 0; i < this->m_changesCount; ++i)
+  {
+    event.remote = this->m_changes[i];
+    this->deliver(event);
+  }
+  this->m_changesCount = 0;
+}
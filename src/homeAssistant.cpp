@@ -0,0 +1,193 @@
+/**
+ * @file homeAssistant.cpp
+ * @author Laurette Alexandre
+ * @brief Implementation of the Home Assistant MQTT discovery.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stdio.h>
+#include <ctype.h>
+
+#include <config.h>
+#include <remote.h>
+#include <remoteAction.h>
+#include <homeAssistant.h>
+
+/**
+ * @brief Append text to a fixed buffer, kept terminated. Past the end, the characters are only
+ * counted, so an overflow is checked once when the payload is complete.
+ *
+ */
+struct BufferWriter
+{
+  char* buffer;
+  const size_t size;
+  size_t length = 0;
+
+  BufferWriter(char* buffer, const size_t size)
+      : buffer(buffer)
+      , size(size)
+  {
+  }
+
+  void write(const char c)
+  {
+    if (this->length + 1 < this->size)
+    {
+      this->buffer[this->length] = c;
+    }
+    this->length++;
+  }
+
+  void write(const char* text)
+  {
+    while (*text != '\0')
+    {
+      this->write(*text++);
+    }
+  }
+
+  // A quoted JSON string
+  void writeString(const char* text)
+  {
+    char escaped[7];
+    this->write('"');
+    for (; *text != '\0'; text++)
+    {
+      const unsigned char c = static_cast<unsigned char>(*text);
+      if (c == '"' || c == '\\')
+      {
+        this->write('\\');
+        this->write(*text);
+      }
+      else if (c < 0x20)
+      {
+        sprintf(escaped, "\\u%04x", c);
+        this->write(escaped);
+      }
+      else
+      {
+        this->write(*text);
+      }
+    }
+    this->write('"');
+  }
+
+  void writeNumber(const unsigned long value)
+  {
+    char number[11];
+    sprintf(number, "%lu", value);
+    this->write(number);
+  }
+
+  // The length written, 0 if the buffer was too small
+  size_t end()
+  {
+    if (this->size == 0)
+    {
+      return 0;
+    }
+    if (this->length >= this->size)
+    {
+      this->buffer[0] = '\0';
+      return 0;
+    }
+    this->buffer[this->length] = '\0';
+    return this->length;
+  }
+};
+
+/**
+ * @brief The identifier of this bridge in Home Assistant, from its MAC address.
+ *
+ * @param deviceId Buffer of MAX_DEVICE_ID_LENGTH, ie: esprtsomfy_5ccf7f0a1b2c
+ * @param macAddress The MAC address, ie: 5C:CF:7F:0A:1B:2C
+ */
+void formatDeviceId(char* deviceId, const char* macAddress)
+{
+  BufferWriter writer(deviceId, MAX_DEVICE_ID_LENGTH);
+  writer.write("esprtsomfy_");
+  for (; *macAddress != '\0'; macAddress++)
+  {
+    if (isxdigit(static_cast<unsigned char>(*macAddress)))
+    {
+      writer.write(static_cast<char>(tolower(static_cast<unsigned char>(*macAddress))));
+    }
+  }
+  writer.end();
+}
+
+/**
+ * @brief The topic of the discovery config of a remote:
+ * <prefix>/cover/esprtsomfy_<remote_id>/config
+ *
+ * @return The length of the topic, 0 if it does not fit.
+ */
+size_t formatCoverDiscoveryTopic(char* topic, const size_t size, const unsigned long remoteId)
+{
+  BufferWriter writer(topic, size);
+  writer.write(HOME_ASSISTANT_DISCOVERY_PREFIX);
+  writer.write("/cover/esprtsomfy_");
+  writer.writeNumber(remoteId);
+  writer.write("/config");
+  return writer.end();
+}
+
+/**
+ * @brief Write the discovery config of a remote as a cover, streamed in the buffer without a
+ * JsonDocument. The keys are the abbreviations of Home Assistant and `~` is the base topic of the
+ * remote, to keep the payload small. The cover has no position, it is optimistic.
+ *
+ * @param buffer The buffer, reused for each remote
+ * @param size The size of the buffer
+ * @param remote The remote
+ * @param deviceId The identifier of this bridge, from formatDeviceId()
+ * @return The length of the payload, 0 if it does not fit.
+ */
+size_t writeCoverDiscovery(
+    char* buffer, const size_t size, const Remote& remote, const char* deviceId)
+{
+  BufferWriter writer(buffer, size);
+  writer.write("{\"~\":\"esprtsomfy/remotes/");
+  writer.writeNumber(remote.id);
+  writer.write("\",\"name\":");
+  writer.writeString(remote.name);
+  writer.write(",\"uniq_id\":\"");
+  writer.write(deviceId);
+  writer.write('_');
+  writer.writeNumber(remote.id);
+  writer.write("\",\"cmd_t\":\"~/set/action\",\"pl_open\":\"");
+  writer.write(getRemoteActionDescriptor(RemoteAction::UP).name);
+  writer.write("\",\"pl_cls\":\"");
+  writer.write(getRemoteActionDescriptor(RemoteAction::DOWN).name);
+  writer.write("\",\"pl_stop\":\"");
+  writer.write(getRemoteActionDescriptor(RemoteAction::STOP).name);
+  writer.write("\",\"opt\":true,\"dev\":{\"ids\":[\"");
+  writer.write(deviceId);
+  writer.write("\"],\"name\":\"");
+  writer.write(APP_NAME);
+  writer.write("\",\"mdl\":\"RTS bridge\",\"sw\":\"");
+  writer.write(FIRMWARE_VERSION);
+  writer.write("\"}}");
+  return writer.end();
+}
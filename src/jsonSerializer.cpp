@@ -27,14 +27,40 @@
  */
 #include <Arduino.h>
 #include <ArduinoJson.h>
+#include <StreamString.h>
 
 #include <remote.h>
+#include <scene.h>
+#include <event.h>
+#include <command.h>
+#include <schedule.h>
+#include <batch.h>
+#include <cron.h>
+#include <remoteAction.h>
 #include <networks.h>
 #include <mqttConfig.h>
 #include <systemInfos.h>
+#include <loadStats.h>
+#include <update.h>
 
 #include <jsonSerializer.h>
 
+// Indexed by CommandError
+static const char* const COMMAND_ERROR_NAMES[] = {
+  "none",
+  "invalid_payload",
+  "invalid_remote",
+  "invalid_action",
+  "remote_not_found",
+  "invalid_idempotency_key",
+  "idempotency_conflict",
+  "queue_full",
+  "commit_failed",
+};
+static_assert(sizeof(COMMAND_ERROR_NAMES) / sizeof(COMMAND_ERROR_NAMES[0])
+        == static_cast<uint8_t>(CommandError::COMMIT_FAILED) + 1,
+    "A command error has no name.");
+
 String JSONSerializer::serializeMessage(const char* message)
 {
   JsonDocument doc;
@@ -53,6 +79,7 @@ String JSONSerializer::serializeRemote(const Remote& remote)
   JsonObject object = doc.to<JsonObject>();
 
   this->serializeRemote(object, remote);
+  object["dedup_window_ms"] = remote.dedupWindow; // A setting, left out of the states
 
   String output;
   serializeJson(doc, output);
@@ -61,9 +88,19 @@ String JSONSerializer::serializeRemote(const Remote& remote)
 
 String JSONSerializer::serializeRemotes(const Remote remotes[], int size)
 {
-  JsonDocument doc;
-  JsonArray array = doc.to<JsonArray>();
+  StreamString output;
+  this->serializeRemotes(output, remotes, size);
+  return output;
+}
 
+/**
+ * @brief Write the array element by element, only one element is held in a document at a time.
+ *
+ */
+void JSONSerializer::serializeRemotes(Print& output, const Remote remotes[], int size)
+{
+  bool first = true;
+  output.print('[');
   for (int i = 0; i < size; i++)
   {
     if (remotes[i].id == 0)
@@ -71,14 +108,93 @@ String JSONSerializer::serializeRemotes(const Remote remotes[], int size)
       // Empty remote
       continue;
     }
-    JsonObject object = array.add<JsonObject>();
+    if (!first)
+    {
+      output.print(',');
+    }
+    first = false;
+
+    JsonDocument doc;
+    JsonObject object = doc.to<JsonObject>();
     this->serializeRemote(object, remotes[i]);
+    object["dedup_window_ms"] = remotes[i].dedupWindow;
+    serializeJson(doc, output);
   }
+  output.print(']');
+}
 
-  String output;
-  serializeJson(doc, output);
-  return output;
-};
+/**
+ * @brief Serialize the state of a remote in a buffer, ie:
+ * {"id":1,"rolling_code":43,"name":"foo","last_action":"up","updated_at":1760000000}. The last
+ * action and the time are null while unknown.
+ *
+ * @param state The state
+ * @param output The buffer
+ * @param size The size of the buffer
+ * @return The length written, 0 if the buffer is too small.
+ */
+size_t JSONSerializer::serializeRemoteState(const RemoteState& state, char* output, size_t size)
+{
+  JsonDocument doc;
+  JsonObject object = doc.to<JsonObject>();
+  this->serializeRemote(object, state.remote);
+  if (state.lastAction == RemoteAction::UNKNOWN)
+  {
+    object["last_action"] = nullptr;
+  }
+  else
+  {
+    object["last_action"] = getRemoteActionDescriptor(state.lastAction).name;
+  }
+  if (state.updatedAt == 0)
+  {
+    object["updated_at"] = nullptr;
+  }
+  else
+  {
+    object["updated_at"] = static_cast<unsigned long>(state.updatedAt);
+  }
+
+  if (measureJson(doc) >= size)
+  {
+    return 0;
+  }
+  return serializeJson(doc, output, size);
+}
+
+/**
+ * @brief Serialize the identifiers and the names of the remotes, ie: [{"id":1,"name":"foo"}].
+ * The rolling codes are left to the states, they change with each command.
+ *
+ * @param output The output
+ * @param remotes The remotes, the empty ones are skipped
+ * @param size The number of remotes
+ */
+void JSONSerializer::serializeRemotesInventory(Print& output, const Remote remotes[], int size)
+{
+  bool first = true;
+  output.print('[');
+  for (int i = 0; i < size; i++)
+  {
+    if (remotes[i].id == 0)
+    {
+      // Empty remote
+      continue;
+    }
+    if (!first)
+    {
+      output.print(',');
+    }
+    first = false;
+
+    JsonDocument doc;
+    JsonObject object = doc.to<JsonObject>();
+    object["id"] = remotes[i].id;
+    object["name"] = remotes[i].name;
+    serializeJson(doc, output);
+  }
+  output.print(']');
+}
 
 String JSONSerializer::serializeNetworkConfig(const NetworkConfiguration& networkConfig)
 {
@@ -95,25 +211,51 @@ String JSONSerializer::serializeNetworkConfig(const NetworkConfiguration& networ
 
 String JSONSerializer::serializeNetworks(const Network networks[], int size)
 {
-  JsonDocument doc;
-  JsonArray array = doc.to<JsonArray>();
+  StreamString output;
+  this->serializeNetworks(output, networks, size);
+  return output;
+}
 
+void JSONSerializer::serializeNetworks(Print& output, const Network networks[], int size)
+{
+  bool first = true;
+  output.print('[');
   for (int i = 0; i < size; i++)
   {
     if (strcmp(networks[i].SSID, "") == 0)
     {
-      // Empty remote
+      // Empty network
       continue;
     }
-    JsonObject object = array.add<JsonObject>();
+    if (!first)
+    {
+      output.print(',');
+    }
+    first = false;
+
+    JsonDocument doc;
+    JsonObject object = doc.to<JsonObject>();
     object["ssid"] = networks[i].SSID;
     object["rssi"] = networks[i].RSSI;
+    serializeJson(doc, output);
   }
+  output.print(']');
+}
+
+String JSONSerializer::serializeNetworkScan(const NetworkScan& scan)
+{
+  JsonDocument doc;
+  JsonObject object = doc.to<JsonObject>();
+
+  object["scanning"] = scan.scanning;
+  object["scanned"] = scan.scanned;
+  object["age"] = scan.age;
+  object["count"] = scan.count;
 
   String output;
   serializeJson(doc, output);
   return output;
-};
+}
 
 String JSONSerializer::serializeSystemInfos(const SystemInfos& infos)
 {
@@ -135,6 +277,39 @@ String JSONSerializer::serializeSystemInfos(const SystemInfosExtended& infos)
   object["version"] = infos.version;
   object["mac"] = infos.macAddress;
   object["ip"] = infos.ipAddress;
+  object["suppressed_commands"] = infos.suppressedCommands;
+
+  String output;
+  serializeJson(doc, output);
+  return output;
+}
+
+String JSONSerializer::serializeLoadStats(const LoadStats& stats)
+{
+  JsonDocument doc;
+  JsonObject object = doc.to<JsonObject>();
+
+  object["in_flight"] = stats.inFlight;
+  object["free_heap"] = stats.freeHeap;
+  object["shed_limit"] = stats.shedByLimit;
+  object["shed_heap"] = stats.shedByHeap;
+
+  String output;
+  serializeJson(doc, output);
+  return output;
+}
+
+String JSONSerializer::serializeUpdateProgress(const UpdateProgress& progress)
+{
+  static const char* const states[] = { "idle", "running", "done", "failed" };
+
+  JsonDocument doc;
+  JsonObject object = doc.to<JsonObject>();
+
+  object["target"] = progress.target == UpdateTarget::FILESYSTEM ? "filesystem" : "firmware";
+  object["state"] = states[static_cast<uint8_t>(progress.state)];
+  object["written"] = progress.written;
+  object["total"] = progress.total;
 
   String output;
   serializeJson(doc, output);
@@ -157,6 +332,339 @@ String JSONSerializer::serializeMQTTConfig(const MQTTConfiguration& mqttConfig)
   return output;
 }
 
+String JSONSerializer::serializeScene(const Scene& scene)
+{
+  JsonDocument doc;
+  JsonObject object = doc.to<JsonObject>();
+
+  this->serializeScene(object, scene);
+
+  String output;
+  serializeJson(doc, output);
+  return output;
+}
+
+String JSONSerializer::serializeScenes(const Scene scenes[], int size)
+{
+  StreamString output;
+  this->serializeScenes(output, scenes, size);
+  return output;
+}
+
+void JSONSerializer::serializeScenes(Print& output, const Scene scenes[], int size)
+{
+  bool first = true;
+  output.print('[');
+  for (int i = 0; i < size; i++)
+  {
+    if (scenes[i].id == 0)
+    {
+      // Empty scene
+      continue;
+    }
+    if (!first)
+    {
+      output.print(',');
+    }
+    first = false;
+
+    JsonDocument doc;
+    JsonObject object = doc.to<JsonObject>();
+    this->serializeScene(object, scenes[i]);
+    serializeJson(doc, output);
+  }
+  output.print(']');
+}
+
+String JSONSerializer::serializeBatchReport(const BatchReport& report)
+{
+  JsonDocument doc;
+  JsonObject object = doc.to<JsonObject>();
+
+  object["operations"] = report.size;
+  JsonArray commands = object["commands"].to<JsonArray>();
+  for (unsigned short i = 0; i < report.size; i++)
+  {
+    JsonObject commandObject = commands.add<JsonObject>();
+    commandObject["request_id"] = report.requestIds[i];
+    commandObject["remote_id"] = report.operations[i].remoteId;
+    commandObject["action"] = getRemoteActionDescriptor(report.operations[i].action).name;
+  }
+
+  String output;
+  serializeJson(doc, output);
+  return output;
+}
+
+String JSONSerializer::serializeCommand(const Command& command)
+{
+  JsonDocument doc;
+  JsonObject object = doc.to<JsonObject>();
+
+  if (command.requestId == 0)
+  {
+    // Refused, it was never queued
+    object["request_id"] = nullptr;
+  }
+  else
+  {
+    object["request_id"] = command.requestId;
+  }
+  object["remote_id"] = command.remoteId;
+  if (command.action == RemoteAction::UNKNOWN)
+  {
+    object["action"] = nullptr;
+  }
+  else
+  {
+    object["action"] = getRemoteActionDescriptor(command.action).name;
+  }
+  switch (command.status)
+  {
+  case CommandStatus::PENDING:
+    object["status"] = "pending";
+    break;
+  case CommandStatus::DONE:
+    object["status"] = "done";
+    object["rolling_code"] = command.rollingCode;
+    break;
+  case CommandStatus::FAILED:
+    object["status"] = "failed";
+    object["error"] = COMMAND_ERROR_NAMES[static_cast<uint8_t>(command.error)];
+    break;
+  }
+  if (strlen(command.idempotencyKey) != 0)
+  {
+    object["idempotency_key"] = command.idempotencyKey;
+  }
+  if (command.requestId != 0 && command.status != CommandStatus::PENDING)
+  {
+    JsonObject timings = object["timings"].to<JsonObject>();
+    timings["queue_us"] = command.timings.queue;
+    timings["transmit_us"] = command.timings.transmit;
+    timings["commit_us"] = command.timings.commit;
+    timings["total_us"] = command.timings.total;
+  }
+
+  String output;
+  serializeJson(doc, output);
+  return output;
+}
+
+/**
+ * @brief Serialize only the changed fields of a remote, ie: {"id":1,"rolling_code":43}.
+ *
+ * @param change The change
+ * @return String
+ */
+String JSONSerializer::serializeRemoteChange(const RemoteChange& change)
+{
+  JsonDocument doc;
+  JsonObject object = doc.to<JsonObject>();
+
+  object["id"] = change.remote.id;
+  if ((change.changes & REMOTE_CHANGE_DELETED) != 0)
+  {
+    object["deleted"] = true;
+  }
+  else
+  {
+    if ((change.changes & REMOTE_CHANGE_CREATED) != 0)
+    {
+      object["created"] = true;
+    }
+    if ((change.changes & REMOTE_CHANGE_NAME) != 0)
+    {
+      object["name"] = change.remote.name;
+    }
+    if ((change.changes & REMOTE_CHANGE_ROLLING_CODE) != 0)
+    {
+      object["rolling_code"] = change.remote.rollingCode;
+    }
+    if ((change.changes & REMOTE_CHANGE_LAST_ACTION) != 0)
+    {
+      object["last_action"] = getRemoteActionDescriptor(change.lastAction).name;
+    }
+    if ((change.changes & REMOTE_CHANGE_DEDUP_WINDOW) != 0)
+    {
+      object["dedup_window_ms"] = change.remote.dedupWindow;
+    }
+  }
+
+  String output;
+  serializeJson(doc, output);
+  return output;
+}
+
+String JSONSerializer::serializeSchedule(const Schedule& schedule)
+{
+  JsonDocument doc;
+  JsonObject object = doc.to<JsonObject>();
+
+  this->serializeSchedule(object, schedule);
+
+  String output;
+  serializeJson(doc, output);
+  return output;
+}
+
+String JSONSerializer::serializeSchedules(const Schedule schedules[], int size)
+{
+  StreamString output;
+  this->serializeSchedules(output, schedules, size);
+  return output;
+}
+
+void JSONSerializer::serializeSchedules(Print& output, const Schedule schedules[], int size)
+{
+  bool first = true;
+  output.print('[');
+  for (int i = 0; i < size; i++)
+  {
+    if (schedules[i].id == 0)
+    {
+      // Empty schedule
+      continue;
+    }
+    if (!first)
+    {
+      output.print(',');
+    }
+    first = false;
+
+    JsonDocument doc;
+    JsonObject object = doc.to<JsonObject>();
+    this->serializeSchedule(object, schedules[i]);
+    serializeJson(doc, output);
+  }
+  output.print(']');
+}
+
+String JSONSerializer::serializeLocation(const Location& location)
+{
+  JsonDocument doc;
+  JsonObject object = doc.to<JsonObject>();
+
+  object["latitude"] = location.latitude;
+  object["longitude"] = location.longitude;
+  object["timezone"] = location.timezone;
+
+  String output;
+  serializeJson(doc, output);
+  return output;
+}
+
+void JSONSerializer::serializeBatchResponse(Print& output, const BatchResponse& response)
+{
+  JsonDocument doc;
+  JsonObject object = doc.to<JsonObject>();
+  object["status"] = response.status;
+  object["body"] = serialized(response.body); // Already serialized
+  serializeJson(doc, output);
+}
+
+/**
+ * @brief Read a command request: {"action":"up","idempotency_key":"..."}. The key is optional.
+ *
+ * @param input The JSON input
+ * @param request The request to fill
+ * @return true if the input is valid, false otherwise.
+ */
+bool JSONSerializer::deserializeCommandRequest(const char* input, CommandRequest& request)
+{
+  JsonDocument doc;
+  DeserializationError error = deserializeJson(doc, input);
+  if (error)
+  {
+    return false;
+  }
+
+  const char* idempotencyKey = doc["idempotency_key"] | "";
+  if (strlen(idempotencyKey) >= MAX_IDEMPOTENCY_KEY_LENGTH)
+  {
+    return false;
+  }
+
+  request.action = parseRemoteAction(doc["action"] | "");
+  strcpy(request.idempotencyKey, idempotencyKey);
+  return true;
+}
+
+/**
+ * @brief Read the fields of a JSON object, each as a string. The body of a request is parsed once,
+ * then its fields are read from them.
+ *
+ * @param input The JSON object
+ * @param fields Filled with the first MAX_BODY_FIELDS fields
+ * @return false if the input is not a JSON object.
+ */
+bool JSONSerializer::deserializeFields(const char* input, BodyFields& fields)
+{
+  fields.size = 0;
+  JsonDocument doc;
+  DeserializationError error = deserializeJson(doc, input);
+  if (error || !doc.is<JsonObject>())
+  {
+    return false;
+  }
+  this->deserializeFields(doc.as<JsonObjectConst>(), fields);
+  return true;
+}
+
+/**
+ * @brief Read the sub-requests of a batch, ie: {"requests":[{"method":"POST",
+ * "path":"/api/v1/remotes/1/action","body":{"action":"up"}}]}. They are all checked first, then
+ * each one is handed to the callback, so only one of them is held at a time.
+ *
+ * @param input The JSON input
+ * @param size The max number of sub-requests
+ * @param callback Runs each sub-request, in order
+ * @return The number of sub-requests, -1 if the input is malformed or has too many of them. None
+ * is run then.
+ */
+int JSONSerializer::deserializeBatchRequests(
+    const char* input, int size, BatchRequestCallback callback)
+{
+  JsonDocument doc;
+  DeserializationError error = deserializeJson(doc, input);
+  if (error)
+  {
+    return -1;
+  }
+
+  JsonArrayConst array = doc["requests"];
+  if (array.isNull() || array.size() > static_cast<size_t>(size))
+  {
+    return -1;
+  }
+  for (JsonObjectConst object : array)
+  {
+    const char* method = object["method"] | "";
+    const char* path = object["path"] | "";
+    if (strlen(method) == 0 || strlen(method) >= MAX_BATCH_METHOD_LENGTH || strlen(path) == 0
+        || strlen(path) >= MAX_BATCH_PATH_LENGTH)
+    {
+      return -1;
+    }
+  }
+
+  int count = 0;
+  BatchRequest request;
+  for (JsonObjectConst object : array)
+  {
+    strcpy(request.method, object["method"].as<const char*>());
+    strcpy(request.path, object["path"].as<const char*>());
+    request.body.size = 0;
+    if (object["body"].is<JsonObjectConst>())
+    {
+      this->deserializeFields(object["body"].as<JsonObjectConst>(), request.body);
+    }
+    callback(request);
+    count++;
+  }
+  return count;
+}
+
 // PRIVATE
 
 void JSONSerializer::serializeRemote(JsonObject object, const Remote& remote)
@@ -164,4 +672,48 @@ void JSONSerializer::serializeRemote(JsonObject object, const Remote& remote)
   object["id"] = remote.id;
   object["rolling_code"] = remote.rollingCode;
   object["name"] = remote.name;
-};
\ No newline at end of file
+};
+void JSONSerializer::serializeScene(JsonObject object, const Scene& scene)
+{
+  object["id"] = scene.id;
+  object["name"] = scene.name;
+  JsonArray actions = object["actions"].to<JsonArray>();
+  for (unsigned short i = 0; i < scene.size; i++)
+  {
+    JsonObject action = actions.add<JsonObject>();
+    action["remote_id"] = scene.operations[i].remoteId;
+    action["action"] = getRemoteActionDescriptor(scene.operations[i].action).name;
+  }
+}
+void JSONSerializer::serializeSchedule(JsonObject object, const Schedule& schedule)
+{
+  object["id"] = schedule.id;
+  object["remote_id"] = schedule.remoteId;
+  object["action"] = getRemoteActionDescriptor(schedule.action).name;
+  object["trigger"] = getScheduleTriggerName(schedule.trigger);
+  object["offset"] = schedule.offset;
+  object["cron"] = schedule.cron;
+}
+void JSONSerializer::deserializeFields(JsonObjectConst object, BodyFields& fields)
+{
+  fields.size = 0;
+  for (JsonPairConst pair : object)
+  {
+    if (fields.size == MAX_BODY_FIELDS)
+    {
+      break;
+    }
+    fields.names[fields.size] = pair.key().c_str();
+    if (pair.value().is<const char*>())
+    {
+      fields.values[fields.size] = pair.value().as<const char*>();
+    }
+    else
+    {
+      // Numbers and booleans as in JSON, so they parse as form params
+      fields.values[fields.size] = "";
+      serializeJson(pair.value(), fields.values[fields.size]);
+    }
+    fields.size++;
+  }
+}
@@ -37,13 +37,18 @@
 #include <networks.h>
 #include <webServer.h>
 #include <controller.h>
+#include <otaUpdater.h>
 #include <wifiClient.h>
 #include <mqttClient.h>
+#include <pubSubConnection.h>
+#include <scheduler.h>
+#include <systemClock.h>
 #include <systemManager.h>
 #include <wifiAccessPoint.h>
 #include <RTSTransmitter.h>
 #include <eepromDatabase.h>
 #include <jsonSerializer.h>
+#include <espUpdatePartition.h>
 
 WifiAccessPoint wifiAP;
 RTSTransmitter transmitter;
@@ -54,9 +59,17 @@ EEPROMDatabase database(macToLong(wifiClient.getMacAddress().c_str()));
 Network networks[MAX_NETWORK_SCAN];
 Controller controller(&database, &wifiClient, &transmitter, &systemManager);
 
+SystemClock systemClock;
+Scheduler scheduler(&controller, &systemClock);
+
 JSONSerializer serializer;
-MQTTClient mqttClient(&controller, &serializer);
-WebServer server(SERVER_PORT, &controller, &serializer);
+PubSubConnection mqttConnection;
+MQTTClient mqttClient(&controller, &serializer, &systemClock, &mqttConnection);
+ESPUpdatePartition updatePartition;
+OtaUpdater updater(&updatePartition);
+WebServer server(SERVER_PORT, &controller, &serializer, &updater);
+
+bool safeMode = false;
 
 // ============================================================================
 // SETUP
@@ -70,6 +83,17 @@ void setup()
   // Wait one second to avoid bad chars in serial
   delay(2000);
 
+  if (!systemManager.beginBoot())
+  {
+    // Only what is needed to install a working firmware
+    safeMode = true;
+    wifiAP.startAccessPoint(AP_SSID, AP_PASSWORD);
+    LOG_INFO("AP IP address:", wifiAP.getIP());
+    server.setupSafeMode();
+    server.begin();
+    return;
+  }
+
   // Open the output for 433.42MHz and 433.92MHz transmitter
   LOG_INFO("Initializing pin for transmitter...");
   transmitter.init();
@@ -78,17 +102,18 @@ void setup()
   LOG_INFO("Initializing database...");
   database.init();
 
-  // SPIFFS Setup
+#ifndef EMBED_ASSETS
+  // SPIFFS Setup, only the web UI is in the filesystem
   LOG_INFO("Setuping SPIFFS...");
   if (!LittleFS.begin())
   {
-    LOG_ERROR("An Error has occurred while mounting SPIFFS.");
-    return;
+    LOG_ERROR("An Error has occurred while mounting SPIFFS. The web UI is not served.");
   }
   else
   {
     LOG_INFO("SPIFFS setup done.");
   }
+#endif
 
   // WIFI Setup
   LOG_INFO("Scanning all wifi networks...");
@@ -117,6 +142,7 @@ void setup()
     else
     {
       LOG_INFO("WiFi IP address:", wifiClient.getIP());
+      systemClock.begin();
     }
   }
 
@@ -128,7 +154,7 @@ void setup()
     if (wifiClient.isConnected())
     {
       mqttClient.connect(mqttConfig);
-      controller.attach(&mqttClient); // Connect mqttClient to the observer
+      controller.subscribe(&mqttClient, EVENT_FILTER_REMOTE | EVENT_FILTER_COMMAND);
     }
     else
     {
@@ -144,13 +170,23 @@ void setup()
   LOG_INFO("Setuping WebServer...");
   server.setup();
   server.begin();
-  controller.attach(&server);
+  controller.subscribe(&server);
 }
 
 void loop()
 {
+  if (safeMode)
+  {
+    systemManager.handleActions();
+    return;
+  }
   // put your main code here, to run repeatedly:
   mqttClient.handleMessages();
+  controller.handleCommands();
+  controller.handleNetworkScan();
+  controller.dispatchEvents();
+  server.handleEvents();
+  scheduler.handleSchedules();
   systemManager.handleActions();
 }
 #endif // PIO_UNIT_TESTING
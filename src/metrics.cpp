@@ -0,0 +1,248 @@
+/**
+ * @file metrics.cpp
+ * @author Laurette Alexandre
+ * @brief Metrics recorded in static memory, written in the Prometheus text format.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+
+#include <metrics.h>
+
+// Upper bounds of the buckets, in microseconds and as written in the "le" label
+static const uint32_t BUCKET_BOUNDS[METRIC_BUCKETS - 1] = { 1000, 5000, 10000, 50000, 100000,
+  500000 };
+static const char* const BUCKET_LABELS[METRIC_BUCKETS]
+    = { "0.001", "0.005", "0.01", "0.05", "0.1", "0.5", "+Inf" };
+
+static const char* const HISTOGRAM_NAMES[] = {
+  "esprtsomfy_command_duration_seconds",
+  "esprtsomfy_transmit_duration_seconds",
+  "esprtsomfy_database_commit_duration_seconds",
+  "esprtsomfy_mqtt_publish_duration_seconds",
+};
+static const char* const COUNTER_NAMES[] = {
+  "esprtsomfy_commands_done_total",
+  "esprtsomfy_commands_failed_total",
+  "esprtsomfy_database_commit_failures_total",
+  "esprtsomfy_mqtt_messages_received_total",
+  "esprtsomfy_mqtt_publish_failures_total",
+  "esprtsomfy_mqtt_connect_failures_total",
+  "esprtsomfy_mqtt_reconnects_total",
+  "esprtsomfy_mqtt_disconnected_seconds_total",
+  "esprtsomfy_mqtt_outbox_compacted_total",
+  "esprtsomfy_mqtt_outbox_dropped_total",
+};
+static const char* const GAUGE_NAMES[] = {
+  "esprtsomfy_mqtt_outbox_depth",
+};
+static_assert(sizeof(HISTOGRAM_NAMES) / sizeof(HISTOGRAM_NAMES[0])
+        == static_cast<uint8_t>(HistogramId::COUNT),
+    "A histogram has no name.");
+static_assert(
+    sizeof(COUNTER_NAMES) / sizeof(COUNTER_NAMES[0]) == static_cast<uint8_t>(CounterId::COUNT),
+    "A counter has no name.");
+static_assert(
+    sizeof(GAUGE_NAMES) / sizeof(GAUGE_NAMES[0]) == static_cast<uint8_t>(GaugeId::COUNT),
+    "A gauge has no name.");
+
+Histogram Metrics::m_histograms[static_cast<uint8_t>(HistogramId::COUNT)];
+uint32_t Metrics::m_counters[static_cast<uint8_t>(CounterId::COUNT)] = {};
+uint32_t Metrics::m_gauges[static_cast<uint8_t>(GaugeId::COUNT)] = {};
+
+/**
+ * @brief Count a duration in its bucket.
+ *
+ * @param duration In microseconds
+ */
+void Histogram::observe(const uint32_t duration)
+{
+  uint8_t bucket = 0;
+  while (bucket < METRIC_BUCKETS - 1 && duration > BUCKET_BOUNDS[bucket])
+  {
+    bucket++;
+  }
+  this->buckets[bucket]++;
+  this->count++;
+  this->sum += duration;
+}
+
+void Metrics::observe(const HistogramId id, const uint32_t duration)
+{
+  Metrics::m_histograms[static_cast<uint8_t>(id)].observe(duration);
+}
+
+void Metrics::increment(const CounterId id) { Metrics::m_counters[static_cast<uint8_t>(id)]++; }
+
+void Metrics::add(const CounterId id, const uint32_t value)
+{
+  Metrics::m_counters[static_cast<uint8_t>(id)] += value;
+}
+
+void Metrics::set(const GaugeId id, const uint32_t value)
+{
+  Metrics::m_gauges[static_cast<uint8_t>(id)] = value;
+}
+
+const Histogram& Metrics::getHistogram(const HistogramId id)
+{
+  return Metrics::m_histograms[static_cast<uint8_t>(id)];
+}
+
+uint32_t Metrics::getCounter(const CounterId id)
+{
+  return Metrics::m_counters[static_cast<uint8_t>(id)];
+}
+
+uint32_t Metrics::getGauge(const GaugeId id) { return Metrics::m_gauges[static_cast<uint8_t>(id)]; }
+
+const char* Metrics::getName(const HistogramId id)
+{
+  return HISTOGRAM_NAMES[static_cast<uint8_t>(id)];
+}
+
+const char* Metrics::getName(const CounterId id)
+{
+  return COUNTER_NAMES[static_cast<uint8_t>(id)];
+}
+
+const char* Metrics::getName(const GaugeId id) { return GAUGE_NAMES[static_cast<uint8_t>(id)]; }
+
+void Metrics::reset()
+{
+  for (Histogram& histogram : Metrics::m_histograms)
+  {
+    histogram = Histogram();
+  }
+  for (uint32_t& counter : Metrics::m_counters)
+  {
+    counter = 0;
+  }
+  for (uint32_t& gauge : Metrics::m_gauges)
+  {
+    gauge = 0;
+  }
+}
+
+/**
+ * @brief Write an item in the Prometheus text format, a histogram, a counter or a gauge with its
+ * TYPE line.
+ *
+ * @param output The output
+ * @param item The histograms come first, then the counters and the gauges. Up to ITEMS excluded.
+ */
+void Metrics::write(Print& output, const uint8_t item)
+{
+  const uint8_t histograms = static_cast<uint8_t>(HistogramId::COUNT);
+  const uint8_t counters = histograms + static_cast<uint8_t>(CounterId::COUNT);
+  if (item < histograms)
+  {
+    output.print("# TYPE ");
+    output.print(HISTOGRAM_NAMES[item]);
+    output.print(" histogram\n");
+    Metrics::writeHistogram(output, HISTOGRAM_NAMES[item], "", Metrics::m_histograms[item]);
+  }
+  else if (item < counters)
+  {
+    Metrics::writeCounter(
+        output, COUNTER_NAMES[item - histograms], Metrics::m_counters[item - histograms]);
+  }
+  else if (item < Metrics::ITEMS)
+  {
+    Metrics::writeGauge(output, GAUGE_NAMES[item - counters], Metrics::m_gauges[item - counters]);
+  }
+}
+
+/**
+ * @brief Write the samples of a histogram, without its TYPE line. The buckets are cumulative and
+ * the sum is in seconds.
+ *
+ * @param output The output
+ * @param name The name of the histogram
+ * @param labels Labels added to each sample, ie: `method="GET",route="/"`. Empty if none.
+ * @param histogram The histogram
+ */
+void Metrics::writeHistogram(
+    Print& output, const char* name, const char* labels, const Histogram& histogram)
+{
+  const bool hasLabels = labels[0] != '\0';
+  uint32_t cumulated = 0;
+  for (uint8_t i = 0; i < METRIC_BUCKETS; i++)
+  {
+    cumulated += histogram.buckets[i];
+    output.print(name);
+    output.print("_bucket{");
+    output.print(labels);
+    output.print(hasLabels ? ",le=\"" : "le=\"");
+    output.print(BUCKET_LABELS[i]);
+    output.print("\"} ");
+    output.print(static_cast<unsigned long>(cumulated));
+    output.print('\n');
+  }
+
+  output.print(name);
+  output.print("_sum");
+  if (hasLabels)
+  {
+    output.print('{');
+    output.print(labels);
+    output.print('}');
+  }
+  output.print(' ');
+  output.print(histogram.sum / 1000000.0, 6);
+  output.print('\n');
+
+  output.print(name);
+  output.print("_count");
+  if (hasLabels)
+  {
+    output.print('{');
+    output.print(labels);
+    output.print('}');
+  }
+  output.print(' ');
+  output.print(static_cast<unsigned long>(histogram.count));
+  output.print('\n');
+}
+
+void Metrics::writeCounter(Print& output, const char* name, const uint32_t value)
+{
+  output.print("# TYPE ");
+  output.print(name);
+  output.print(" counter\n");
+  output.print(name);
+  output.print(' ');
+  output.print(static_cast<unsigned long>(value));
+  output.print('\n');
+}
+
+void Metrics::writeGauge(Print& output, const char* name, const uint32_t value)
+{
+  output.print("# TYPE ");
+  output.print(name);
+  output.print(" gauge\n");
+  output.print(name);
+  output.print(' ');
+  output.print(static_cast<unsigned long>(value));
+  output.print('\n');
+}
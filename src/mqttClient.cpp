@@ -25,200 +25,773 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  * SOFTWARE.
  */
-#include <regex>
 #include <Arduino.h>
+#include <stdarg.h>
 #include <DebugLog.h>
-#include <ESP8266WiFi.h>
-#include <PubSubClient.h>
 
 #include <config.h>
 #include <result.h>
 #include <remote.h>
+#include <event.h>
+#include <command.h>
 #include <controller.h>
 #include <mqttClient.h>
+#include <mqttTopic.h>
+#include <homeAssistant.h>
+#include <remoteAction.h>
 #include <mqttConfig.h>
 #include <serializerAbs.h>
+#include <mqttConnectionAbs.h>
+#include <metrics.h>
 
-WiFiClient espClient;
-PubSubClient pubSubClient(espClient);
+/**
+ * @brief Count the bytes printed, to know the length of a payload before streaming it.
+ *
+ */
+class PrintCounter : public Print
+{
+  public:
+  size_t length = 0;
+
+  size_t write(uint8_t) override
+  {
+    this->length++;
+    return 1;
+  }
+  size_t write(const uint8_t*, size_t size) override
+  {
+    this->length += size;
+    return size;
+  }
+};
+
+/**
+ * @brief Format an outgoing topic in a buffer of MAX_MQTT_TOPIC_LENGTH, ie:
+ * "esprtsomfy/remotes/%lu/name".
+ *
+ * @return false if it would be truncated: its message is skipped, and counted as a failed publish.
+ */
+static bool formatTopic(char* topic, const char* format, ...)
+{
+  va_list args;
+  va_start(args, format);
+  const int length = vsnprintf(topic, MAX_MQTT_TOPIC_LENGTH, format, args);
+  va_end(args);
+  if (length < 0 || length >= MAX_MQTT_TOPIC_LENGTH)
+  {
+    LOG_ERROR("The topic is too long, its message is skipped:", topic);
+    Metrics::increment(CounterId::MQTT_PUBLISH_FAILURES);
+    return false;
+  }
+  return true;
+}
 
 MQTTClient* MQTTClient::m_instance = nullptr;
 
-MQTTClient::MQTTClient(Controller* controller, SerializerAbstract* serializer)
+MQTTClient::MQTTClient(Controller* controller, SerializerAbstract* serializer,
+    ClockAbstract* clock, MQTTConnectionAbstract* connection)
     : m_controller(controller)
     , m_serializer(serializer)
+    , m_clock(clock)
+    , m_connection(connection)
+    , m_backoff(MQTT_RECONNECT_MIN_DELAY_MS, MQTT_RECONNECT_MAX_DELAY_MS)
+    , m_outbox(MQTT_OUTBOX_DROP_OLDEST)
 {
   this->m_instance = this;
 }
 
 MQTTClient* MQTTClient::getInstance() { return MQTTClient::m_instance; }
 
+/**
+ * @brief Start the client. The first connection is attempted at once, the next ones from
+ * handleMessages() until the broker is reached.
+ *
+ * @param conf The MQTT configuration
+ * @return true if connected to the broker.
+ */
 bool MQTTClient::connect(const MQTTConfiguration& conf)
 {
-  pubSubClient.setServer(conf.broker, conf.port);
+  this->m_config = conf;
+  this->m_enabled = true;
+  this->m_connection->begin(this->m_config.broker, this->m_config.port, MQTTClient::receive);
+  this->m_backoff.begin(millis());
+  return this->attemptConnection();
+}
+
+/**
+ * @brief Process the incoming messages. When the connection is lost, reconnect with a backoff:
+ * a single attempt per call, spaced out while the broker stays unreachable.
+ *
+ */
+void MQTTClient::handleMessages()
+{
+  if (!this->m_enabled)
+  {
+    return;
+  }
+  if (!this->m_connection->isConnected())
+  {
+    if (this->m_backoff.isConnected())
+    {
+      LOG_WARN("MQTT connection lost. State:", this->m_connection->getState());
+      this->m_backoff.lost(millis());
+    }
+    if (this->m_backoff.isDue(millis()) && this->m_connection->isNetworkConnected())
+    {
+      this->attemptConnection();
+    }
+    return;
+  }
+  this->m_connection->loop();
+  this->drainOutbox();
+
+  if (METRICS_PUBLISH_INTERVAL_MS > 0
+      && millis() - this->m_lastMetricsPublish >= METRICS_PUBLISH_INTERVAL_MS)
+  {
+    this->m_lastMetricsPublish = millis();
+    this->publishMetrics();
+  }
+}
+
+bool MQTTClient::isConnected() { return this->m_connection->isConnected(); }
+
+void MQTTClient::notified(const Event& event)
+{
+  if (!this->isConnected())
+  {
+    LOG_DEBUG("MQTT Client is not connected. The event is kept in the outbox.");
+  }
+  switch (event.type)
+  {
+  case EventType::REMOTE:
+    this->publishRemote(event.remote);
+    break;
+  case EventType::COMMAND:
+    this->publishCommand(event.command);
+    break;
+  }
+}
+
+// PRIVATE
+
+/**
+ * @brief Connect to the broker, then subscribe and publish the state again: a broker restarted
+ * may have lost both. The state is published from handleMessages(), at the pace of the outbox.
+ *
+ * @return true if connected.
+ */
+bool MQTTClient::attemptConnection()
+{
   String clientId = this->getClientIdentifier();
+  if (!this->m_connection->connect(
+          clientId.c_str(), this->m_config.username, this->m_config.password))
+  {
+    this->m_backoff.failed(millis(), random(1001));
+    LOG_ERROR("Cannot connect to the MQTT broker. Next attempt in ms:", this->m_backoff.getWait());
+    return false;
+  }
+  this->m_backoff.succeeded(millis());
+  LOG_INFO("MQTT client connected.");
 
-  if (pubSubClient.connect(clientId.c_str(), conf.username, conf.password))
+  LOG_DEBUG("Subscribing to topics...");
+  for (uint8_t i = 0; i < MQTT_SUBSCRIPTIONS_COUNT; ++i)
+  {
+    this->m_connection->subscribe(MQTT_SUBSCRIPTIONS[i].filter);
+  }
+  if (MQTT_JSON_STATE)
   {
-    LOG_INFO("MQTT client started.");
+    Result<Remote[MAX_REMOTES]> resultRemotes = this->m_controller->fetchAllRemotes();
+    this->forgetStates(resultRemotes.data);
+  }
+  this->m_republish = RepublishStep::VERSION;
+  return true;
+}
 
+/**
+ * @brief Publish the next message of the state: the system infos, the remotes stored and their
+ * discovery configs, retained so a client subscribing later gets them. A remote is read once for
+ * all its messages.
+ *
+ */
+void MQTTClient::republishNext()
+{
+  char topic[MAX_MQTT_TOPIC_LENGTH];
+  char rollingCode[11];
+  const Remote& remote = this->m_republishRemote;
+  switch (this->m_republish)
+  {
+  case RepublishStep::VERSION:
+  {
     LOG_DEBUG("Publishing basic informations...");
     Result<SystemInfosExtended> resultInfos = this->m_controller->fetchSystemInfos();
-    pubSubClient.publish("esprtsomfy/system/infos/version", resultInfos.data.version);
-    pubSubClient.publish("esprtsomfy/system/infos/mac", resultInfos.data.macAddress.c_str());
-    pubSubClient.publish("esprtsomfy/system/infos/ip", resultInfos.data.ipAddress.c_str());
-
-    Result<Remote[MAX_REMOTES]> resultRemotes = this->m_controller->fetchAllRemotes();
-    char topic[50];
-    for (unsigned short i = 0; i < MAX_REMOTES; ++i)
+    this->publish("esprtsomfy/system/infos/version", resultInfos.data.version, true);
+    this->m_republish = RepublishStep::MAC;
+    break;
+  }
+  case RepublishStep::MAC:
+  {
+    Result<SystemInfosExtended> resultInfos = this->m_controller->fetchSystemInfos();
+    this->publish("esprtsomfy/system/infos/mac", resultInfos.data.macAddress.c_str(), true);
+    formatDeviceId(this->m_deviceId, resultInfos.data.macAddress.c_str());
+    this->m_republish = RepublishStep::IP;
+    break;
+  }
+  case RepublishStep::IP:
+  {
+    Result<SystemInfosExtended> resultInfos = this->m_controller->fetchSystemInfos();
+    this->publish("esprtsomfy/system/infos/ip", resultInfos.data.ipAddress.c_str(), true);
+    this->m_republishSlot = 0;
+    this->m_republish = this->findRepublishRemote();
+    break;
+  }
+  case RepublishStep::REMOTE_STATE:
+    if (MQTT_JSON_STATE)
     {
-      if (resultRemotes.data[i].id == 0)
+      RemoteState* state = this->trackState(remote);
+      if (state != nullptr && formatTopic(topic, "esprtsomfy/remotes/%lu/state", remote.id)
+          && this->m_serializer->serializeRemoteState(
+                 *state, this->m_payload, sizeof(this->m_payload))
+              > 0)
       {
-        // Skip empty remotes
-        continue;
+        this->publish(topic, this->m_payload, true);
       }
-      sprintf(topic, "esprtsomfy/remotes/%lu/rolling_code", resultRemotes.data[i].id);
-      pubSubClient.publish(topic, String(resultRemotes.data[i].rollingCode).c_str());
-      sprintf(topic, "esprtsomfy/remotes/%lu/name", resultRemotes.data[i].id);
-      pubSubClient.publish(topic, resultRemotes.data[i].name);
+      this->m_republish = RepublishStep::REMOTE_DISCOVERY;
+      break;
+    }
+    if (formatTopic(topic, "esprtsomfy/remotes/%lu/rolling_code", remote.id))
+    {
+      sprintf(rollingCode, "%u", remote.rollingCode);
+      this->publish(topic, rollingCode, true);
+    }
+    this->m_republish = RepublishStep::REMOTE_NAME;
+    break;
+  case RepublishStep::REMOTE_NAME:
+    if (formatTopic(topic, "esprtsomfy/remotes/%lu/name", remote.id))
+    {
+      this->publish(topic, remote.name, true);
+    }
+    this->m_republish = RepublishStep::REMOTE_DISCOVERY;
+    break;
+  case RepublishStep::REMOTE_DISCOVERY:
+    if (this->writeDiscovery(topic, sizeof(topic), remote))
+    {
+      this->publish(topic, this->m_payload, true);
+    }
+    this->m_republishSlot++;
+    this->m_republish = this->findRepublishRemote();
+    break;
+  case RepublishStep::INVENTORY:
+  {
+    Result<Remote[MAX_REMOTES]> resultRemotes = this->m_controller->fetchAllRemotes();
+    this->publishInventory(resultRemotes.data);
+    this->m_republish = RepublishStep::DONE;
+    break;
+  }
+  case RepublishStep::DONE:
+    break;
+  }
+}
+
+/**
+ * @brief Read the next remote to republish, from m_republishSlot. Empty slots are skipped.
+ *
+ * @return The step publishing it, or the step after the remotes.
+ */
+RepublishStep MQTTClient::findRepublishRemote()
+{
+  Result<Remote[MAX_REMOTES]> resultRemotes = this->m_controller->fetchAllRemotes();
+  for (; this->m_republishSlot < MAX_REMOTES; ++this->m_republishSlot)
+  {
+    if (resultRemotes.data[this->m_republishSlot].id != 0)
+    {
+      this->m_republishRemote = resultRemotes.data[this->m_republishSlot];
+      return RepublishStep::REMOTE_STATE;
+    }
+  }
+  return MQTT_JSON_STATE ? RepublishStep::INVENTORY : RepublishStep::DONE;
+}
+
+/**
+ * @brief Publish the changed fields of a remote, one topic per field.
+ *
+ * @param change The coalesced change of the remote
+ */
+void MQTTClient::publishRemote(const RemoteChange& change)
+{
+  LOG_DEBUG("Remote change catched.");
+  if (MQTT_JSON_STATE)
+  {
+    this->publishRemoteState(change);
+    return;
+  }
+  char topic[MAX_MQTT_TOPIC_LENGTH];
+  char rollingCode[11];
+  const Remote& remote = change.remote;
+  if ((change.changes & REMOTE_CHANGE_DELETED) != 0)
+  {
+    if (formatTopic(topic, "esprtsomfy/remotes/%lu/rolling_code", remote.id))
+    {
+      this->deliver(topic, "NA", true);
+    }
+    if (formatTopic(topic, "esprtsomfy/remotes/%lu/name", remote.id))
+    {
+      this->deliver(topic, "NA", true);
+    }
+    if (formatTopic(topic, "esprtsomfy/remotes/%lu/last_action", remote.id))
+    {
+      this->deliver(topic, "NA");
     }
+    this->removeDiscovery(remote.id);
+    return;
+  }
+
+  if ((change.changes & REMOTE_CHANGE_LAST_ACTION) != 0
+      && formatTopic(topic, "esprtsomfy/remotes/%lu/last_action", remote.id))
+  {
+    this->deliver(topic, getRemoteActionDescriptor(change.lastAction).name);
+  }
+  if ((change.changes & REMOTE_CHANGE_ROLLING_CODE) != 0
+      && formatTopic(topic, "esprtsomfy/remotes/%lu/rolling_code", remote.id))
+  {
+    sprintf(rollingCode, "%u", remote.rollingCode);
+    this->deliver(topic, rollingCode, true);
+  }
+  if ((change.changes & REMOTE_CHANGE_NAME) != 0
+      && formatTopic(topic, "esprtsomfy/remotes/%lu/name", remote.id))
+  {
+    this->deliver(topic, remote.name, true);
+  }
+  if ((change.changes & (REMOTE_CHANGE_CREATED | REMOTE_CHANGE_NAME)) != 0)
+  {
+    this->publishDiscovery(remote);
+  }
+}
 
-    LOG_DEBUG("Subscribing to topics...");
-    pubSubClient.setCallback(MQTTClient::receive);
-    pubSubClient.subscribe("esprtsomfy/remotes/+/set/name");
-    pubSubClient.subscribe("esprtsomfy/remotes/+/set/action");
+/**
+ * @brief Publish the state of a changed remote as a single retained JSON document. The list of
+ * the remotes is published again when one is created, renamed or deleted.
+ *
+ * @param change The coalesced change of the remote
+ */
+void MQTTClient::publishRemoteState(const RemoteChange& change)
+{
+  char topic[MAX_MQTT_TOPIC_LENGTH];
+  const Remote& remote = change.remote;
+  if (!formatTopic(topic, "esprtsomfy/remotes/%lu/state", remote.id))
+  {
+    return;
   }
-  else
+  Result<Remote[MAX_REMOTES]> resultRemotes;
+  if ((change.changes & (REMOTE_CHANGE_CREATED | REMOTE_CHANGE_NAME | REMOTE_CHANGE_DELETED)) != 0)
+  {
+    resultRemotes = this->m_controller->fetchAllRemotes();
+  }
+
+  if ((change.changes & REMOTE_CHANGE_DELETED) != 0)
+  {
+    this->forgetStates(resultRemotes.data);
+    this->deliver(topic, "", true);
+    this->removeDiscovery(remote.id);
+    if (this->isConnected())
+    {
+      this->publishInventory(resultRemotes.data);
+    }
+    return;
+  }
+
+  RemoteState* state = this->trackState(remote);
+  if (state == nullptr)
+  {
+    LOG_ERROR("No state left for the remote.");
+    return;
+  }
+  if ((change.changes & REMOTE_CHANGE_LAST_ACTION) != 0)
+  {
+    state->lastAction = change.lastAction;
+  }
+  const time_t now = this->m_clock->now();
+  state->updatedAt = now >= static_cast<time_t>(MIN_VALID_TIME) ? now : 0;
+  if (this->m_serializer->serializeRemoteState(*state, this->m_payload, sizeof(this->m_payload))
+      == 0)
+  {
+    LOG_ERROR("The state of the remote is too long.");
+    return;
+  }
+  this->deliver(topic, this->m_payload, true);
+
+  if ((change.changes & (REMOTE_CHANGE_CREATED | REMOTE_CHANGE_NAME)) != 0)
+  {
+    this->publishDiscovery(remote);
+    if (this->isConnected())
+    {
+      // Streamed, it does not fit in the outbox. The reconnection publishes it from the database.
+      this->publishInventory(resultRemotes.data);
+    }
+  }
+}
+
+/**
+ * @brief Publish the list of the remotes on esprtsomfy/remotes, retained. It is streamed in the
+ * packet, so its length does not depend on the buffer of PubSubClient.
+ *
+ * @param remotes All the remotes, MAX_REMOTES
+ */
+void MQTTClient::publishInventory(const Remote remotes[])
+{
+  PrintCounter counter;
+  this->m_serializer->serializeRemotesInventory(counter, remotes, MAX_REMOTES);
+
+  MetricTimer timer(HistogramId::MQTT_PUBLISH);
+  Print* stream = this->m_connection->beginPublish("esprtsomfy/remotes", counter.length, true);
+  if (stream == nullptr)
+  {
+    Metrics::increment(CounterId::MQTT_PUBLISH_FAILURES);
+    return;
+  }
+  this->m_serializer->serializeRemotesInventory(*stream, remotes, MAX_REMOTES);
+  if (!this->m_connection->endPublish())
+  {
+    Metrics::increment(CounterId::MQTT_PUBLISH_FAILURES);
+  }
+}
+
+/**
+ * @brief The state kept for a remote, updated with its fields. A remote not tracked yet takes a
+ * free state.
+ *
+ * @param remote The remote
+ * @return nullptr if no state is free.
+ */
+RemoteState* MQTTClient::trackState(const Remote& remote)
+{
+  RemoteState* free = nullptr;
+  for (RemoteState& state : this->m_states)
+  {
+    if (state.remote.id == remote.id)
+    {
+      state.remote = remote;
+      return &state;
+    }
+    if (free == nullptr && state.remote.id == 0)
+    {
+      free = &state;
+    }
+  }
+  if (free != nullptr)
+  {
+    *free = RemoteState { remote };
+  }
+  return free;
+}
+
+/**
+ * @brief Free the states of the remotes which are not in the database anymore.
+ *
+ * @param remotes All the remotes, MAX_REMOTES
+ */
+void MQTTClient::forgetStates(const Remote remotes[])
+{
+  for (RemoteState& state : this->m_states)
+  {
+    bool found = false;
+    for (unsigned short i = 0; i < MAX_REMOTES && !found; ++i)
+    {
+      found = remotes[i].id == state.remote.id;
+    }
+    if (!found)
+    {
+      state = RemoteState();
+    }
+  }
+}
+
+/**
+ * @brief Write the topic of the Home Assistant discovery config of a remote, and the config in
+ * m_payload.
+ *
+ * @param topic Filled with the topic
+ * @param size Size of the topic buffer
+ * @param remote The remote
+ * @return false if there is nothing to publish: disabled, or the device is not known yet.
+ */
+bool MQTTClient::writeDiscovery(char* topic, const size_t size, const Remote& remote)
+{
+  if (!HOME_ASSISTANT_DISCOVERY || this->m_deviceId[0] == '\0')
   {
-    LOG_ERROR("Cannot connect to the MQTT broker.");
+    return false;
+  }
+  formatCoverDiscoveryTopic(topic, size, remote.id);
+  if (writeCoverDiscovery(this->m_payload, sizeof(this->m_payload), remote, this->m_deviceId)
+      == 0)
+  {
+    LOG_ERROR("The discovery config is too long.");
     return false;
   }
   return true;
 }
 
-void MQTTClient::handleMessages()
+/**
+ * @brief Deliver the Home Assistant discovery config of a changed remote, retained. While
+ * disconnected, it waits in the outbox with the other changes.
+ *
+ * @param remote The remote
+ */
+void MQTTClient::publishDiscovery(const Remote& remote)
+{
+  char topic[MAX_MQTT_TOPIC_LENGTH];
+  if (this->writeDiscovery(topic, sizeof(topic), remote))
+  {
+    this->deliver(topic, this->m_payload, true);
+  }
+}
+
+/**
+ * @brief Remove the cover of a deleted remote from Home Assistant, with an empty retained config.
+ *
+ * @param remoteId The identifier of the remote
+ */
+void MQTTClient::removeDiscovery(const unsigned long remoteId)
 {
-  if (!pubSubClient.connected())
+  if (!HOME_ASSISTANT_DISCOVERY)
   {
     return;
   }
-  pubSubClient.loop();
+  char topic[MAX_MQTT_TOPIC_LENGTH];
+  formatCoverDiscoveryTopic(topic, sizeof(topic), remoteId);
+  this->deliver(topic, "", true);
 }
 
-bool MQTTClient::isConnected() { return pubSubClient.connected(); }
+void MQTTClient::publishCommand(const Command& command)
+{
+  LOG_DEBUG("Command completion catched.");
+  char topic[MAX_MQTT_TOPIC_LENGTH];
+  if (formatTopic(topic, "esprtsomfy/remotes/%lu/ack", command.remoteId))
+  {
+    this->deliver(topic, this->m_serializer->serializeCommand(command).c_str());
+  }
+}
 
-void MQTTClient::notified(const char* action, const Remote& remote)
+/**
+ * @brief Publish a summary of the metrics, one topic per metric:
+ * esprtsomfy/system/metrics/<name>. A histogram gives its count and its sum in seconds, as
+ * `<count>,<sum>`. The buckets are only served by GET /api/v1/metrics.
+ *
+ */
+void MQTTClient::publishMetrics()
 {
-  if (!this->isConnected())
+  char topic[MAX_MQTT_TOPIC_LENGTH];
+  char payload[11];
+  for (uint8_t i = 0; i < static_cast<uint8_t>(HistogramId::COUNT); i++)
+  {
+    const HistogramId id = static_cast<HistogramId>(i);
+    const Histogram& histogram = Metrics::getHistogram(id);
+    if (!formatTopic(topic, "esprtsomfy/system/metrics/%s", Metrics::getName(id)))
+    {
+      continue;
+    }
+    String summary = String(histogram.count) + "," + String(histogram.sum / 1000000.0, 6);
+    this->publish(topic, summary.c_str());
+  }
+  for (uint8_t i = 0; i < static_cast<uint8_t>(CounterId::COUNT); i++)
+  {
+    const CounterId id = static_cast<CounterId>(i);
+    if (!formatTopic(topic, "esprtsomfy/system/metrics/%s", Metrics::getName(id)))
+    {
+      continue;
+    }
+    sprintf(payload, "%lu", static_cast<unsigned long>(Metrics::getCounter(id)));
+    this->publish(topic, payload);
+  }
+  for (uint8_t i = 0; i < static_cast<uint8_t>(GaugeId::COUNT); i++)
+  {
+    const GaugeId id = static_cast<GaugeId>(i);
+    if (!formatTopic(topic, "esprtsomfy/system/metrics/%s", Metrics::getName(id)))
+    {
+      continue;
+    }
+    sprintf(payload, "%lu", static_cast<unsigned long>(Metrics::getGauge(id)));
+    this->publish(topic, payload);
+  }
+}
+
+/**
+ * @brief Publish the next message of the state after a connection, then the oldest message of
+ * the outbox. One per MQTT_OUTBOX_DRAIN_INTERVAL_MS, so a reconnection does not flood the broker
+ * and the TCP buffers.
+ *
+ */
+void MQTTClient::drainOutbox()
+{
+  if (millis() - this->m_lastDrain < MQTT_OUTBOX_DRAIN_INTERVAL_MS)
   {
-    LOG_ERROR("MQTT Client is not connected. Nothing can be published.");
     return;
   }
-  char topic[50];
-  if (strcmp(action, "remote-update") == 0 || strcmp(action, "remote-create") == 0)
+  if (this->m_republish != RepublishStep::DONE)
   {
-    LOG_DEBUG("Remote create/update catched.");
-    sprintf(topic, "esprtsomfy/remotes/%lu/rolling_code", remote.id);
-    pubSubClient.publish(topic, String(remote.rollingCode).c_str());
-    sprintf(topic, "esprtsomfy/remotes/%lu/name", remote.id);
-    pubSubClient.publish(topic, remote.name);
+    this->m_lastDrain = millis();
+    this->republishNext();
     return;
   }
-
-  if (strcmp(action, "remote-up") == 0 || strcmp(action, "remote-stop") == 0
-      || strcmp(action, "remote-down") == 0 || strcmp(action, "remote-pair") == 0
-      || strcmp(action, "remote-reset") == 0)
+  MQTTMessage message;
+  if (!this->m_outbox.peek(message))
   {
-    LOG_DEBUG("Remote command catched.");
-    sprintf(topic, "esprtsomfy/remotes/%lu/last_action", remote.id);
-    String command = String(action).substring(7);
-    pubSubClient.publish(topic, command.c_str());
     return;
   }
+  this->m_lastDrain = millis();
+  if (this->publish(message.topic, message.payload, message.retained))
+  {
+    this->m_outbox.pop();
+  }
+}
 
-  if (strcmp(action, "remote-delete") == 0)
+/**
+ * @brief Publish a change, or keep it in the outbox while disconnected. Once the outbox is not
+ * empty, or while the state is republished, the changes go through it until it is drained: an
+ * older value of a topic must not be published after a newer one.
+ *
+ * @param topic The topic
+ * @param payload The payload
+ * @param retained If the broker must retain the message
+ * @return true if published or queued.
+ */
+bool MQTTClient::deliver(const char* topic, const char* payload, const bool retained)
+{
+  if (!this->m_connection->isConnected() || this->m_republish != RepublishStep::DONE
+      || this->m_outbox.size() > 0)
   {
-    sprintf(topic, "esprtsomfy/remotes/%lu/rolling_code", remote.id);
-    pubSubClient.publish(topic, "NA");
-    sprintf(topic, "esprtsomfy/remotes/%lu/name", remote.id);
-    pubSubClient.publish(topic, "NA");
-    sprintf(topic, "esprtsomfy/remotes/%lu/last_action", remote.id);
-    pubSubClient.publish(topic, "NA");
+    return this->m_outbox.push(topic, payload, retained);
   }
+  return this->publish(topic, payload, retained);
 }
 
-// PRIVATE
+bool MQTTClient::publish(const char* topic, const char* payload, const bool retained)
+{
+  MetricTimer timer(HistogramId::MQTT_PUBLISH);
+  if (!this->m_connection->publish(topic, payload, retained))
+  {
+    Metrics::increment(CounterId::MQTT_PUBLISH_FAILURES);
+    return false;
+  }
+  return true;
+}
 
 /**
- * @brief Called when a message arrived. TODO refacto this part. Some code is
- * ugly, but this part was sooo boring.
+ * @brief Called when a message arrived. The topic is parsed in place and the payload is copied
+ * once on the stack, nothing is allocated.
  *
  * @param topic The topic
- * @param payloadByte The payload received
+ * @param payloadByte The payload received, not terminated
  * @param length Lenght of the payload
  */
 void MQTTClient::receive(const char* topic, byte* payloadByte, uint32_t length)
 {
   LOG_DEBUG("Message arrived on topic: ", topic);
+  Metrics::increment(CounterId::MQTT_MESSAGES_RECEIVED);
 
   MQTTClient* instance = MQTTClient::getInstance();
 
-  // Inspired by:
-  // https://github.com/me-no-dev/ESPAsyncWebServer/blob/7f3753454b1f176c4b6d6bcd1587a135d95ca63c/src/WebHandlerImpl.h#L94
-  std::regex remoteIdPattern(R"(/(\d+)/)");
-  std::smatch matches;
-  std::string s(topic);
-  if (!std::regex_search(s, matches, remoteIdPattern))
+  MQTTTopic parsed;
+  if (!parseMQTTTopic(topic, parsed))
   {
-    LOG_ERROR("Cannot extract remote ID.");
+    LOG_ERROR("Unknown topic.");
     return;
   }
 
-  // Assume that we only have one match. We should never trust users ?!
-  unsigned long remoteId = strtoul(matches[1].str().c_str(), nullptr, 10);
-
-  // Get payload from payloadByte
-  String payload = "";
-  for (unsigned int i = 0; i < length; i++)
+  char payload[MAX_MQTT_PAYLOAD_LENGTH];
+  if (length >= sizeof(payload))
   {
-    payload += (char)payloadByte[i];
+    LOG_ERROR("The payload is too long.");
+    return;
   }
+  memcpy(payload, payloadByte, length);
+  payload[length] = '\0';
 
-  // Get endpoint
-  String endpoint = String(topic);
-  String lastElement;
-  int lastSlashPos = endpoint.lastIndexOf('/');
-  if (lastSlashPos != -1)
+  switch (parsed.type)
   {
-    lastElement = endpoint.substring(lastSlashPos + 1);
-  }
-  else
+  case MQTTTopicType::REMOTES_ACTIONS:
   {
-    LOG_ERROR("Something went wrong. The topic is ambigous.");
-    return;
+    // Queue a batch of commands, each one is acked on its remote
+    // Payload: <remote_id>:<action>,<remote_id>:<action>
+    RemoteOperation operations[MAX_BATCH_OPERATIONS];
+    int size = parseRemoteOperations(payload, operations, MAX_BATCH_OPERATIONS);
+    if (size < 0)
+    {
+      LOG_ERROR("The batch payload is malformed.");
+      return;
+    }
+    Result<BatchReport> result = instance->m_controller->operateBatch(operations, size);
+    if (!result.isSuccess)
+    {
+      LOG_ERROR(result.errorMsg);
+    }
+    break;
   }
-
-  if (lastElement == "action")
+  case MQTTTopicType::SCENE_RUN:
   {
-    // Perform a command
-    Result<String> result = instance->m_controller->operateRemote(remoteId, payload.c_str());
+    // Queue the commands of a scene. Topic: esprtsomfy/scenes/<scene_id>/set/run
+    if (parsed.id > UINT16_MAX)
+    {
+      LOG_ERROR("The scene doesn't exist.");
+      return;
+    }
+    Result<BatchReport> result = instance->m_controller->operateScene(parsed.id);
     if (!result.isSuccess)
     {
       LOG_ERROR(result.errorMsg);
+    }
+    break;
+  }
+  case MQTTTopicType::REMOTE_ACTION:
+  {
+    // Queue a command, its completion is published on esprtsomfy/remotes/<id>/ack
+    // Payload: <action> or {"action":"<action>","idempotency_key":"<key>"}
+    CommandRequest commandRequest = { parseRemoteAction(payload), "" };
+    if (payload[0] == '{'
+        && !instance->m_serializer->deserializeCommandRequest(payload, commandRequest))
+    {
+      LOG_ERROR("The action payload is malformed.");
+      Command refused = { 0, parsed.id, RemoteAction::UNKNOWN, CommandStatus::FAILED, 0, 0, "",
+        CommandError::INVALID_PAYLOAD };
+      instance->publishCommand(refused);
       return;
     }
-    LOG_INFO(result.data);
+    Result<Command> result = instance->m_controller->submitCommand(
+        parsed.id, commandRequest.action, commandRequest.idempotencyKey);
+    if (result.isSuccess)
+    {
+      LOG_INFO("Command submitted:", result.data.requestId);
+    }
+    else
+    {
+      LOG_ERROR(result.errorMsg);
+    }
+    // A refused or already completed command (a replay, or a duplicate merged with a previous
+    // one) has no completion to come, it is acked now. So is a command merged with a pending one
+    // of another key, as the completion only carries the key of the first one.
+    if (result.data.status != CommandStatus::PENDING
+        || strcmp(result.data.idempotencyKey, commandRequest.idempotencyKey) != 0)
+    {
+      // The ack carries the key of the request, so the client can match it
+      result.data.remoteId = parsed.id;
+      strncpy(result.data.idempotencyKey, commandRequest.idempotencyKey,
+          MAX_IDEMPOTENCY_KEY_LENGTH - 1);
+      result.data.idempotencyKey[MAX_IDEMPOTENCY_KEY_LENGTH - 1] = '\0';
+      instance->publishCommand(result.data);
+    }
+    break;
   }
-
-  else if (lastElement == "name")
+  case MQTTTopicType::REMOTE_NAME:
   {
     // Change name
-    Result<Remote> result = instance->m_controller->updateRemote(remoteId, payload.c_str(), 0);
+    Result<Remote> result = instance->m_controller->updateRemote(parsed.id, payload, 0);
     if (!result.isSuccess)
     {
       LOG_ERROR(result.errorMsg);
-      return;
     }
+    break;
+  }
+  default:
+    break;
   }
 }
 
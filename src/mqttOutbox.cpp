@@ -0,0 +1,212 @@
+/**
+ * @file mqttOutbox.cpp
+ * @author Laurette Alexandre
+ * @brief Implementation of the outbox of the MQTT client.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <string.h>
+
+#include <config.h>
+#include <metrics.h>
+#include <mqttOutbox.h>
+
+// The longest message fits in an empty queue
+static_assert(MQTT_OUTBOX_STATES_SIZE >= MAX_MQTT_TOPIC_LENGTH + MAX_MQTT_OUTBOX_PAYLOAD_LENGTH,
+    "MQTT_OUTBOX_STATES_SIZE is too small");
+static_assert(MQTT_OUTBOX_EVENTS_SIZE >= MAX_MQTT_TOPIC_LENGTH + MAX_MQTT_OUTBOX_PAYLOAD_LENGTH,
+    "MQTT_OUTBOX_EVENTS_SIZE is too small");
+
+MQTTMessageBuffer::MQTTMessageBuffer(char* buffer, const size_t capacity)
+    : m_buffer(buffer)
+    , m_capacity(capacity)
+{
+}
+
+/**
+ * @brief If a message fits after the ones queued.
+ *
+ * @param length The length of the message, its topic and its payload with their \0
+ * @return true if it fits.
+ */
+bool MQTTMessageBuffer::hasRoom(const size_t length) const
+{
+  return this->m_used + length <= this->m_capacity;
+}
+
+/**
+ * @brief Queue a message after the others. hasRoom() must be checked first.
+ *
+ * @param topic The topic
+ * @param payload The payload
+ */
+void MQTTMessageBuffer::push(const char* topic, const char* payload)
+{
+  const size_t topicLength = strlen(topic) + 1;
+  const size_t payloadLength = strlen(payload) + 1;
+  memcpy(this->m_buffer + this->m_used, topic, topicLength);
+  memcpy(this->m_buffer + this->m_used + topicLength, payload, payloadLength);
+  this->m_used += topicLength + payloadLength;
+  this->m_count++;
+}
+
+/**
+ * @brief The oldest message, left in the buffer until pop().
+ *
+ * @param message Set to the message, its retained flag is left as is
+ * @return false if the buffer is empty.
+ */
+bool MQTTMessageBuffer::peek(MQTTMessage& message) const
+{
+  if (this->m_count == 0)
+  {
+    return false;
+  }
+  message.topic = this->m_buffer;
+  message.payload = this->m_buffer + strlen(this->m_buffer) + 1;
+  return true;
+}
+
+void MQTTMessageBuffer::pop()
+{
+  if (this->m_count > 0)
+  {
+    this->erase(0);
+  }
+}
+
+/**
+ * @brief Remove the message queued for a topic.
+ *
+ * @param topic The topic
+ * @return true if a message was removed.
+ */
+bool MQTTMessageBuffer::remove(const char* topic)
+{
+  for (size_t offset = 0; offset < this->m_used; offset += this->getLength(offset))
+  {
+    if (strcmp(this->m_buffer + offset, topic) == 0)
+    {
+      this->erase(offset);
+      return true;
+    }
+  }
+  return false;
+}
+
+unsigned short MQTTMessageBuffer::size() const { return this->m_count; }
+
+// PRIVATE
+
+size_t MQTTMessageBuffer::getLength(const size_t offset) const
+{
+  const size_t topicLength = strlen(this->m_buffer + offset) + 1;
+  return topicLength + strlen(this->m_buffer + offset + topicLength) + 1;
+}
+
+/**
+ * @brief Remove a message, the next ones are moved back in its place.
+ *
+ * @param offset Where the message starts
+ */
+void MQTTMessageBuffer::erase(const size_t offset)
+{
+  const size_t length = this->getLength(offset);
+  memmove(this->m_buffer + offset, this->m_buffer + offset + length,
+      this->m_used - offset - length);
+  this->m_used -= length;
+  this->m_count--;
+}
+
+MQTTOutbox::MQTTOutbox(const bool dropOldest)
+    : m_states(m_statesBuffer, MQTT_OUTBOX_STATES_SIZE)
+    , m_events(m_eventsBuffer, MQTT_OUTBOX_EVENTS_SIZE)
+    , m_dropOldest(dropOldest)
+{
+}
+
+/**
+ * @brief Queue a message. A retained one replaces the value queued for its topic.
+ *
+ * @param topic The topic
+ * @param payload The payload
+ * @param retained If the broker must retain the message
+ * @return false if the message is dropped: too long, or its queue is full.
+ */
+bool MQTTOutbox::push(const char* topic, const char* payload, const bool retained)
+{
+  const size_t topicLength = strlen(topic);
+  const size_t payloadLength = strlen(payload);
+  if (topicLength >= MAX_MQTT_TOPIC_LENGTH || payloadLength >= MAX_MQTT_OUTBOX_PAYLOAD_LENGTH)
+  {
+    Metrics::increment(CounterId::MQTT_OUTBOX_DROPPED);
+    return false;
+  }
+
+  MQTTMessageBuffer& queue = retained ? this->m_states : this->m_events;
+  if (retained && queue.remove(topic))
+  {
+    Metrics::increment(CounterId::MQTT_OUTBOX_COMPACTED);
+  }
+  while (!queue.hasRoom(topicLength + payloadLength + 2))
+  {
+    Metrics::increment(CounterId::MQTT_OUTBOX_DROPPED);
+    if (!this->m_dropOldest)
+    {
+      Metrics::set(GaugeId::MQTT_OUTBOX_DEPTH, this->size());
+      return false;
+    }
+    queue.pop();
+  }
+  queue.push(topic, payload);
+  Metrics::set(GaugeId::MQTT_OUTBOX_DEPTH, this->size());
+  return true;
+}
+
+/**
+ * @brief The next message to publish, left in the outbox until pop(): the oldest message not
+ * retained, else the oldest state.
+ *
+ * @param message Set to the message
+ * @return false if the outbox is empty.
+ */
+bool MQTTOutbox::peek(MQTTMessage& message) const
+{
+  message.retained = this->m_events.size() == 0;
+  return message.retained ? this->m_states.peek(message) : this->m_events.peek(message);
+}
+
+void MQTTOutbox::pop()
+{
+  if (this->m_events.size() > 0)
+  {
+    this->m_events.pop();
+  }
+  else
+  {
+    this->m_states.pop();
+  }
+  Metrics::set(GaugeId::MQTT_OUTBOX_DEPTH, this->size());
+}
+
+unsigned short MQTTOutbox::size() const { return this->m_states.size() + this->m_events.size(); }
@@ -0,0 +1,134 @@
+/**
+ * @file mqttTopic.cpp
+ * @author Laurette Alexandre
+ * @brief Parse the topics of the incoming MQTT messages.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <string.h>
+#include <stdint.h>
+
+#include <mqttTopic.h>
+#include <utils.h>
+
+struct TopicSegment
+{
+  const char* start;
+  uint8_t length;
+};
+
+/**
+ * @brief Split the topic on '/' in one pass. The segments point in the topic, nothing is copied.
+ *
+ * @return The number of segments, or -1 if there are too many or one is too long.
+ */
+static int8_t splitTopic(const char* topic, TopicSegment segments[MAX_MQTT_TOPIC_SEGMENTS])
+{
+  int8_t count = 0;
+  const char* start = topic;
+  for (const char* cursor = topic;; cursor++)
+  {
+    if (*cursor != '/' && *cursor != '\0')
+    {
+      continue;
+    }
+    if (count == MAX_MQTT_TOPIC_SEGMENTS || cursor - start > UINT8_MAX)
+    {
+      return -1;
+    }
+    segments[count++] = TopicSegment { start, static_cast<uint8_t>(cursor - start) };
+    if (*cursor == '\0')
+    {
+      return count;
+    }
+    start = cursor + 1;
+  }
+}
+
+/**
+ * @brief Match the segments of a topic against a filter, walked level by level.
+ *
+ */
+static bool matchFilter(
+    const char* filter, const TopicSegment segments[], const int8_t count, uint32_t& id)
+{
+  const char* level = filter;
+  for (int8_t i = 0; i < count; i++)
+  {
+    if (level == nullptr)
+    {
+      return false; // The topic is longer
+    }
+    const char* end = strchr(level, '/');
+    const size_t length = end == nullptr ? strlen(level) : static_cast<size_t>(end - level);
+
+    if (length == 1 && level[0] == '+')
+    {
+      if (!parseNumber(segments[i].start, segments[i].length, id))
+      {
+        return false;
+      }
+    }
+    else if (length != segments[i].length || memcmp(level, segments[i].start, length) != 0)
+    {
+      return false;
+    }
+    level = end == nullptr ? nullptr : end + 1;
+  }
+  return level == nullptr; // Otherwise the topic is shorter
+}
+
+/**
+ * @brief Find which subscription a topic belongs to, and its id. The topic is read in place,
+ * without allocation, ie: "esprtsomfy/remotes/12/set/action" gives REMOTE_ACTION and 12.
+ *
+ * @param topic The topic of an incoming message
+ * @param parsed Filled with the type and the id of the topic
+ * @return false if the topic is not one of the subscriptions.
+ */
+bool parseMQTTTopic(const char* topic, MQTTTopic& parsed)
+{
+  parsed = MQTTTopic();
+  if (topic == nullptr)
+  {
+    return false;
+  }
+  TopicSegment segments[MAX_MQTT_TOPIC_SEGMENTS];
+  const int8_t count = splitTopic(topic, segments);
+  if (count < 0)
+  {
+    return false;
+  }
+
+  for (uint8_t i = 0; i < MQTT_SUBSCRIPTIONS_COUNT; i++)
+  {
+    uint32_t id = 0;
+    if (matchFilter(MQTT_SUBSCRIPTIONS[i].filter, segments, count, id))
+    {
+      parsed.type = MQTT_SUBSCRIPTIONS[i].type;
+      parsed.id = id;
+      return true;
+    }
+  }
+  return false;
+}
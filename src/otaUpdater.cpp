@@ -0,0 +1,186 @@
+/**
+ * @file otaUpdater.cpp
+ * @author Laurette Alexandre
+ * @brief Stream an update into a flash partition and verify its SHA-256.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <DebugLog.h>
+
+#include <result.h>
+#include <update.h>
+#include <sha256.h>
+#include <otaUpdater.h>
+#include <updatePartitionAbs.h>
+
+OtaUpdater::OtaUpdater(UpdatePartitionAbstract* partition)
+    : m_partition(partition)
+{
+}
+
+/**
+ * @brief Begin an update. Only one update runs at a time.
+ *
+ * @param target The partition to write
+ * @param sha256 The expected SHA-256 of the image, in hex
+ * @param total The size of the image, or an upper bound
+ * @return The progress, or an error if the update cannot begin.
+ */
+Result<UpdateProgress> OtaUpdater::begin(
+    const UpdateTarget target, const char* sha256, const size_t total)
+{
+  Result<UpdateProgress> result;
+  if (this->m_progress.state == UpdateState::RUNNING)
+  {
+    result.data = this->m_progress;
+    result.errorMsg = "An update is already running.";
+    return result;
+  }
+
+  if (sha256 == nullptr || strlen(sha256) != SHA256_HEX_LENGTH - 1)
+  {
+    return this->fail("The SHA-256 of the image should be given, as 64 hex chars.");
+  }
+  for (uint8_t i = 0; i < SHA256_HEX_LENGTH - 1; i++)
+  {
+    if (!isxdigit(sha256[i]))
+    {
+      return this->fail("The SHA-256 of the image should be given, as 64 hex chars.");
+    }
+    this->m_expectedSha256[i] = tolower(sha256[i]);
+  }
+  this->m_expectedSha256[SHA256_HEX_LENGTH - 1] = '\0';
+
+  this->m_progress = { target, UpdateState::IDLE, 0, total };
+  this->m_sha256.reset();
+  this->m_error = "";
+  if (total == 0 || !this->m_partition->begin(target, total))
+  {
+    return this->fail("The image does not fit in the partition.");
+  }
+  this->m_progress.state = UpdateState::RUNNING;
+
+  LOG_INFO("Update started, bytes expected:", total);
+  result.data = this->m_progress;
+  result.isSuccess = true;
+  return result;
+}
+
+/**
+ * @brief Write the next chunk of the image in the partition.
+ *
+ * @return The progress, or an error if the update failed. The update is then aborted.
+ */
+Result<UpdateProgress> OtaUpdater::write(const uint8_t* data, const size_t length)
+{
+  if (this->m_progress.state != UpdateState::RUNNING)
+  {
+    Result<UpdateProgress> result;
+    result.data = this->m_progress;
+    result.errorMsg = "No update is running.";
+    return result;
+  }
+  if (this->m_progress.written + length > this->m_progress.total)
+  {
+    return this->fail("The image is larger than announced.");
+  }
+  if (this->m_partition->write(data, length) != length)
+  {
+    return this->fail("The partition cannot be written.");
+  }
+
+  this->m_sha256.update(data, length);
+  this->m_progress.written += length;
+
+  Result<UpdateProgress> result;
+  result.data = this->m_progress;
+  result.isSuccess = true;
+  return result;
+}
+
+/**
+ * @brief Check the SHA-256 of the written image and mark it to be installed at the next boot.
+ *
+ * @return The progress, or an error if the image is corrupted. The update is then aborted.
+ */
+Result<UpdateProgress> OtaUpdater::end()
+{
+  if (this->m_progress.state != UpdateState::RUNNING)
+  {
+    Result<UpdateProgress> result;
+    result.data = this->m_progress;
+    result.errorMsg = "No update is running.";
+    return result;
+  }
+
+  char sha256[SHA256_HEX_LENGTH];
+  this->m_sha256.finishHex(sha256);
+  if (strcmp(sha256, this->m_expectedSha256) != 0)
+  {
+    LOG_ERROR("SHA-256 of the image:", sha256);
+    return this->fail("The SHA-256 of the image does not match, it is discarded.");
+  }
+  if (!this->m_partition->end())
+  {
+    return this->fail("The image cannot be installed.");
+  }
+
+  this->m_progress.state = UpdateState::DONE;
+  this->m_progress.total = this->m_progress.written; // It was an upper bound
+  LOG_INFO("Update written, installed at the next boot.");
+  Result<UpdateProgress> result;
+  result.data = this->m_progress;
+  result.isSuccess = true;
+  return result;
+}
+
+void OtaUpdater::abort()
+{
+  if (this->m_progress.state == UpdateState::RUNNING)
+  {
+    this->fail("The update was aborted.");
+  }
+}
+
+const UpdateProgress& OtaUpdater::getProgress() const { return this->m_progress; }
+
+const String& OtaUpdater::getError() const { return this->m_error; }
+
+// PRIVATE
+
+Result<UpdateProgress> OtaUpdater::fail(const String& error)
+{
+  LOG_ERROR(error);
+  if (this->m_progress.state == UpdateState::RUNNING)
+  {
+    this->m_partition->abort();
+  }
+  this->m_progress.state = UpdateState::FAILED;
+  this->m_error = error;
+
+  Result<UpdateProgress> result;
+  result.data = this->m_progress;
+  result.errorMsg = error;
+  return result;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file pubSubConnection.cpp
+ * @author Laurette Alexandre
+ * @brief Implementation of the connection to the MQTT broker with PubSubClient.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <DebugLog.h>
+#include <ESP8266WiFi.h>
+#include <PubSubClient.h>
+
+#include <config.h>
+#include <pubSubConnection.h>
+
+PubSubConnection::PubSubConnection()
+    : m_client(m_wifiClient)
+{
+}
+
+void PubSubConnection::begin(const char* broker, const uint16_t port, MQTTReceiveCallback callback)
+{
+  this->m_broker = broker;
+  this->m_port = port;
+  this->m_resolved = false;
+  this->m_client.setCallback(callback);
+  this->m_client.setBufferSize(MQTT_BUFFER_SIZE);
+  // PubSubClient connects synchronously, bound the time the loop is blocked
+  this->m_wifiClient.setTimeout(MQTT_CONNECT_TIMEOUT_MS);
+  this->m_client.setSocketTimeout(MQTT_CONNACK_TIMEOUT_S);
+}
+
+bool PubSubConnection::isNetworkConnected() { return WiFi.status() == WL_CONNECTED; }
+
+/**
+ * @brief Connect to the broker. An attempt blocks at most MQTT_DNS_TIMEOUT_MS when the broker is
+ * not resolved yet, then MQTT_CONNECT_TIMEOUT_MS for the TCP connection and MQTT_CONNACK_TIMEOUT_S.
+ *
+ * @param clientId The client identifier
+ * @param username The username, may be empty
+ * @param password The password, may be empty
+ * @return true if connected.
+ */
+bool PubSubConnection::connect(const char* clientId, const char* username, const char* password)
+{
+  if (!this->m_resolved)
+  {
+    // An IP address is parsed without any lookup
+    IPAddress ip;
+    if (WiFi.hostByName(this->m_broker, ip, MQTT_DNS_TIMEOUT_MS) != 1)
+    {
+      LOG_ERROR("Cannot resolve the MQTT broker:", this->m_broker);
+      return false;
+    }
+    this->m_client.setServer(ip, this->m_port);
+    this->m_resolved = true;
+  }
+  return this->m_client.connect(clientId, username, password);
+}
+
+bool PubSubConnection::isConnected() { return this->m_client.connected(); }
+
+int PubSubConnection::getState() { return this->m_client.state(); }
+
+void PubSubConnection::loop() { this->m_client.loop(); }
+
+bool PubSubConnection::subscribe(const char* filter) { return this->m_client.subscribe(filter); }
+
+bool PubSubConnection::publish(const char* topic, const char* payload, const bool retained)
+{
+  return this->m_client.publish(topic, payload, retained);
+}
+
+Print* PubSubConnection::beginPublish(const char* topic, const size_t length, const bool retained)
+{
+  if (!this->m_client.beginPublish(topic, length, retained))
+  {
+    return nullptr;
+  }
+  return &this->m_client;
+}
+
+bool PubSubConnection::endPublish() { return this->m_client.endPublish(); }
@@ -0,0 +1,122 @@
+/**
+ * @file reconnectBackoff.cpp
+ * @author Laurette Alexandre
+ * @brief Implementation of the reconnection backoff.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stdint.h>
+
+#include <metrics.h>
+#include <reconnectBackoff.h>
+
+const uint16_t JITTER_MAX = 1000;
+
+ReconnectBackoff::ReconnectBackoff(const uint32_t minDelay, const uint32_t maxDelay)
+    : m_minDelay(minDelay)
+    , m_maxDelay(maxDelay)
+    , m_delay(minDelay)
+{
+}
+
+/**
+ * @brief Start disconnected, the first attempt is due at once.
+ *
+ * @param now The current time
+ */
+void ReconnectBackoff::begin(const uint32_t now)
+{
+  this->m_connected = false;
+  this->m_recovering = false;
+  this->m_delay = this->m_minDelay;
+  this->m_wait = 0;
+  this->m_failures = 0;
+  this->m_lastAttempt = now;
+}
+
+bool ReconnectBackoff::isDue(const uint32_t now) const
+{
+  return !this->m_connected && now - this->m_lastAttempt >= this->m_wait;
+}
+
+/**
+ * @brief The attempt connected. When the connection had been lost, the reconnection and the time
+ * it took are counted in the metrics.
+ *
+ * @param now The current time
+ */
+void ReconnectBackoff::succeeded(const uint32_t now)
+{
+  if (this->m_recovering)
+  {
+    Metrics::increment(CounterId::MQTT_RECONNECTS);
+    Metrics::add(CounterId::MQTT_DISCONNECTED_SECONDS, (now - this->m_lostAt + 500) / 1000);
+  }
+  this->m_connected = true;
+  this->m_recovering = false;
+  this->m_delay = this->m_minDelay;
+  this->m_wait = 0;
+  this->m_failures = 0;
+}
+
+/**
+ * @brief The attempt failed, wait before the next one.
+ *
+ * @param now The current time
+ * @param jitter Random, from 0 to 1000: the share of the upper half of the delay to wait
+ */
+void ReconnectBackoff::failed(const uint32_t now, const uint16_t jitter)
+{
+  Metrics::increment(CounterId::MQTT_CONNECT_FAILURES);
+  const uint32_t half = this->m_delay / 2;
+  const uint16_t share = jitter < JITTER_MAX ? jitter : JITTER_MAX;
+  this->m_wait = half + (uint32_t)((uint64_t)(this->m_delay - half) * share / JITTER_MAX);
+  this->m_lastAttempt = now;
+  this->m_failures++;
+  this->m_delay
+      = this->m_delay > this->m_maxDelay / 2 ? this->m_maxDelay : this->m_delay * 2;
+}
+
+/**
+ * @brief The connection was lost, try to connect again at once.
+ *
+ * @param now The current time
+ */
+void ReconnectBackoff::lost(const uint32_t now)
+{
+  if (!this->m_connected)
+  {
+    return;
+  }
+  this->m_connected = false;
+  this->m_recovering = true;
+  this->m_lostAt = now;
+  this->m_lastAttempt = now;
+  this->m_wait = 0;
+}
+
+bool ReconnectBackoff::isConnected() const { return this->m_connected; }
+
+uint32_t ReconnectBackoff::getWait() const { return this->m_wait; }
+
+uint32_t ReconnectBackoff::getFailures() const { return this->m_failures; }
@@ -0,0 +1,115 @@
+/**
+ * @file remoteAction.cpp
+ * @author Laurette Alexandre
+ * @brief Implementation of Remote actions and events.
+ * @version 2.1.1
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+
+#include <remoteAction.h>
+
+/**
+ * @brief Convert the name of an action to its typed value.
+ *
+ * @param name The name of the action (up, stop, down, pair, reset)
+ * @return RemoteAction RemoteAction::UNKNOWN if the name is null or not valid.
+ */
+RemoteAction parseRemoteAction(const char* name)
+{
+  if (name == nullptr)
+  {
+    return RemoteAction::UNKNOWN;
+  }
+  for (unsigned short i = 0; i < REMOTE_ACTIONS_COUNT; ++i)
+  {
+    if (strcmp(name, REMOTE_ACTIONS[i].name) == 0)
+    {
+      return REMOTE_ACTIONS[i].action;
+    }
+  }
+  return RemoteAction::UNKNOWN;
+}
+
+/**
+ * @brief Parse a list of operations formatted as "<remote_id>:<action>,<remote_id>:<action>".
+ * The input is read in place, without allocation.
+ *
+ * @param input The list to parse
+ * @param operations Array filled with the parsed operations
+ * @param maxSize Size of the operations array
+ * @return int The number of parsed operations, or -1 if the input is malformed or too long.
+ */
+int parseRemoteOperations(
+    const char* input, RemoteOperation operations[], const unsigned short maxSize)
+{
+  if (input == nullptr)
+  {
+    return -1;
+  }
+
+  int count = 0;
+  const char* cursor = input;
+  while (*cursor != '\0')
+  {
+    if (count >= maxSize)
+    {
+      return -1;
+    }
+
+    char* end;
+    unsigned long remoteId = strtoul(cursor, &end, 10);
+    if (end == cursor || *end != ':')
+    {
+      return -1;
+    }
+    cursor = end + 1;
+
+    const char* separator = strchr(cursor, ',');
+    size_t length = separator == nullptr ? strlen(cursor) : separator - cursor;
+    char name[8];
+    if (length == 0 || length >= sizeof(name))
+    {
+      return -1;
+    }
+    memcpy(name, cursor, length);
+    name[length] = '\0';
+
+    RemoteAction action = parseRemoteAction(name);
+    if (action == RemoteAction::UNKNOWN)
+    {
+      return -1;
+    }
+
+    operations[count].remoteId = remoteId;
+    operations[count].action = action;
+    ++count;
+
+    cursor += length;
+    if (*cursor == ',')
+    {
+      ++cursor;
+    }
+  }
+  return count;
+}
@@ -0,0 +1,414 @@
+/**
+ * @file restApi.cpp
+ * @author Laurette Alexandre
+ * @brief Implementation of RestApi.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+
+#include <cron.h>
+#include <restApi.h>
+#include <remoteAction.h>
+
+/**
+ * @brief Parse a whole number, ie: "1500" or "-1".
+ *
+ * @param value The text
+ * @param number Set to the number
+ * @return false if the text is empty or has another char.
+ */
+static bool parseNumber(const String& value, long& number)
+{
+  char* end;
+  number = strtol(value.c_str(), &end, 10);
+  return value.length() > 0 && *end == '\0';
+}
+
+RestApi::RestApi(Controller* controller, SerializerAbstract* serializer)
+    : m_controller(controller)
+    , m_serializer(serializer)
+{
+}
+
+BatchResponse RestApi::fetchSystemInfos(const RouteMatch& match, const BodyFields& body)
+{
+  Result<SystemInfosExtended> result = this->m_controller->fetchSystemInfos();
+  if (!result.isSuccess)
+  {
+    return this->fail(result.errorMsg.c_str());
+  }
+  return BatchResponse { 200, this->m_serializer->serializeSystemInfos(result.data) };
+}
+
+/**
+ * @brief The remotes, one per item of a chunked body. The writer keeps a copy of the table, the
+ * body stays the one of the state when it was asked.
+ *
+ * @return The writer of the JSON array
+ */
+Result<ChunkedWriter> RestApi::fetchAllRemotes()
+{
+  Result<Remote[MAX_REMOTES]> result = this->m_controller->fetchAllRemotes();
+  if (!result.isSuccess)
+  {
+    return Result<ChunkedWriter> { ChunkedWriter(), result.errorMsg, false };
+  }
+  SerializerAbstract* serializer = this->m_serializer;
+  ChunkedWriter writer = ChunkedWriter::jsonArray(MAX_REMOTES,
+      [serializer, remotes = result](const uint8_t index) -> String
+      {
+        const Remote& remote = remotes.data[index];
+        return remote.id == 0 ? String() : serializer->serializeRemote(remote);
+      });
+  return Result<ChunkedWriter> { writer, "", true };
+}
+
+BatchResponse RestApi::fetchRemote(const RouteMatch& match, const BodyFields& body)
+{
+  Result<Remote> result = this->m_controller->fetchRemote(match.params[0]);
+  if (!result.isSuccess)
+  {
+    return this->fail(result.errorMsg.c_str());
+  }
+  return BatchResponse { 200, this->m_serializer->serializeRemote(result.data) };
+}
+
+BatchResponse RestApi::createRemote(const RouteMatch& match, const BodyFields& body)
+{
+  String name;
+  body.get("name", name);
+
+  Result<Remote> result = this->m_controller->createRemote(name.c_str());
+  if (!result.isSuccess)
+  {
+    return this->fail(result.errorMsg.c_str());
+  }
+  return BatchResponse { 200, this->m_serializer->serializeRemote(result.data) };
+}
+
+BatchResponse RestApi::updateRemote(const RouteMatch& match, const BodyFields& body)
+{
+  String name;
+  body.get("name", name);
+
+  unsigned int rollingCode = 0;
+  String value;
+  if (body.get("rolling_code", value))
+  {
+    rollingCode = int(value.toInt());
+  }
+
+  long dedupWindow = DEDUP_WINDOW_UNCHANGED;
+  if (body.get("dedup_window_ms", value) && !parseNumber(value, dedupWindow))
+  {
+    return this->fail("The dedup window should be a number of milliseconds.");
+  }
+
+  Result<Remote> result
+      = this->m_controller->updateRemote(match.params[0], name.c_str(), rollingCode, dedupWindow);
+  if (!result.isSuccess)
+  {
+    return this->fail(result.errorMsg.c_str());
+  }
+  return BatchResponse { 200, this->m_serializer->serializeRemote(result.data) };
+}
+
+BatchResponse RestApi::deleteRemote(const RouteMatch& match, const BodyFields& body)
+{
+  Result<Remote> result = this->m_controller->deleteRemote(match.params[0]);
+  if (!result.isSuccess)
+  {
+    return this->fail(result.errorMsg.c_str());
+  }
+  return BatchResponse { 200, this->m_serializer->serializeRemote(result.data) };
+}
+
+/**
+ * @brief Queue a command, it is transmitted later from the main loop. A client retrying with the
+ * same idempotency_key gets the same command, it is never sent twice.
+ *
+ * @return 202 and the command, with its Location to poll.
+ */
+BatchResponse RestApi::actionRemote(const RouteMatch& match, const BodyFields& body)
+{
+  RemoteAction action = RemoteAction::UNKNOWN;
+  String value;
+  if (body.get("action", value))
+  {
+    action = parseRemoteAction(value.c_str());
+  }
+  String idempotencyKey;
+  body.get("idempotency_key", idempotencyKey);
+
+  Result<Command> result
+      = this->m_controller->submitCommand(match.params[0], action, idempotencyKey.c_str());
+  if (!result.isSuccess)
+  {
+    return this->fail(result.errorMsg.c_str());
+  }
+  return BatchResponse { 202, this->m_serializer->serializeCommand(result.data),
+    "/api/v1/commands/" + String(result.data.requestId) };
+}
+
+BatchResponse RestApi::fetchCommand(const RouteMatch& match, const BodyFields& body)
+{
+  Result<Command> result = this->m_controller->fetchCommand(match.params[0]);
+  if (!result.isSuccess)
+  {
+    return this->fail(result.errorMsg.c_str());
+  }
+  return BatchResponse { 200, this->m_serializer->serializeCommand(result.data) };
+}
+
+/**
+ * @brief Queue the operations of a stored scene, given as "scene", or the "actions" of the body,
+ * ie: "1048576:up,1048577:down". They are transmitted later from the main loop, one per loop.
+ *
+ * @return 202 and the request id of each operation, to poll its command.
+ */
+BatchResponse RestApi::operateBatch(const RouteMatch& match, const BodyFields& body)
+{
+  Result<BatchReport> result;
+  String value;
+  if (body.get("scene", value))
+  {
+    // Stored on 16 bits, a larger id would run another scene once truncated
+    const unsigned long sceneId = strtoul(value.c_str(), nullptr, 10);
+    if (sceneId > UINT16_MAX)
+    {
+      return this->fail("The scene doesn't exist.");
+    }
+    result = this->m_controller->operateScene(sceneId);
+  }
+  else
+  {
+    RemoteOperation operations[MAX_BATCH_OPERATIONS];
+    int size = 0;
+    if (body.get("actions", value))
+    {
+      size = parseRemoteOperations(value.c_str(), operations, MAX_BATCH_OPERATIONS);
+    }
+    if (size < 0)
+    {
+      return this->fail("The actions are malformed. Expected: <remote_id>:<action>,...");
+    }
+    result = this->m_controller->operateBatch(operations, size);
+  }
+
+  if (!result.isSuccess)
+  {
+    return this->fail(result.errorMsg.c_str());
+  }
+  return BatchResponse { 202, this->m_serializer->serializeBatchReport(result.data) };
+}
+
+/**
+ * @brief The scenes, one per item of a chunked body, from a copy of the table.
+ *
+ * @return The writer of the JSON array
+ */
+Result<ChunkedWriter> RestApi::fetchAllScenes()
+{
+  Result<Scene[MAX_SCENES]> result = this->m_controller->fetchAllScenes();
+  if (!result.isSuccess)
+  {
+    return Result<ChunkedWriter> { ChunkedWriter(), result.errorMsg, false };
+  }
+  SerializerAbstract* serializer = this->m_serializer;
+  ChunkedWriter writer = ChunkedWriter::jsonArray(MAX_SCENES,
+      [serializer, scenes = result](const uint8_t index) -> String
+      {
+        const Scene& scene = scenes.data[index];
+        return scene.id == 0 ? String() : serializer->serializeScene(scene);
+      });
+  return Result<ChunkedWriter> { writer, "", true };
+}
+
+BatchResponse RestApi::createScene(const RouteMatch& match, const BodyFields& body)
+{
+  String name;
+  body.get("name", name);
+
+  RemoteOperation operations[MAX_BATCH_OPERATIONS];
+  int size = 0;
+  String value;
+  if (body.get("actions", value))
+  {
+    size = parseRemoteOperations(value.c_str(), operations, MAX_BATCH_OPERATIONS);
+  }
+  if (size < 0)
+  {
+    return this->fail("The actions are malformed. Expected: <remote_id>:<action>,...");
+  }
+
+  Result<Scene> result = this->m_controller->createScene(name.c_str(), operations, size);
+  if (!result.isSuccess)
+  {
+    return this->fail(result.errorMsg.c_str());
+  }
+  return BatchResponse { 200, this->m_serializer->serializeScene(result.data) };
+}
+
+BatchResponse RestApi::deleteScene(const RouteMatch& match, const BodyFields& body)
+{
+  // Stored on 16 bits, a larger id would delete another scene once truncated
+  if (match.params[0] > UINT16_MAX)
+  {
+    return this->fail("The scene doesn't exist.");
+  }
+
+  Result<Scene> result = this->m_controller->deleteScene(match.params[0]);
+  if (!result.isSuccess)
+  {
+    return this->fail(result.errorMsg.c_str());
+  }
+  return BatchResponse { 200, this->m_serializer->serializeScene(result.data) };
+}
+
+/**
+ * @brief The schedules, one per item of a chunked body, from a copy of the table.
+ *
+ * @return The writer of the JSON array
+ */
+Result<ChunkedWriter> RestApi::fetchAllSchedules()
+{
+  Result<Schedule[MAX_SCHEDULES]> result = this->m_controller->fetchAllSchedules();
+  if (!result.isSuccess)
+  {
+    return Result<ChunkedWriter> { ChunkedWriter(), result.errorMsg, false };
+  }
+  SerializerAbstract* serializer = this->m_serializer;
+  ChunkedWriter writer = ChunkedWriter::jsonArray(MAX_SCHEDULES,
+      [serializer, schedules = result](const uint8_t index) -> String
+      {
+        const Schedule& schedule = schedules.data[index];
+        return schedule.id == 0 ? String() : serializer->serializeSchedule(schedule);
+      });
+  return Result<ChunkedWriter> { writer, "", true };
+}
+
+BatchResponse RestApi::createSchedule(const RouteMatch& match, const BodyFields& body)
+{
+  unsigned long remoteId = 0;
+  String value;
+  if (body.get("remote_id", value))
+  {
+    remoteId = strtoul(value.c_str(), nullptr, 10);
+  }
+
+  RemoteAction action = RemoteAction::UNKNOWN;
+  if (body.get("action", value))
+  {
+    action = parseRemoteAction(value.c_str());
+  }
+
+  ScheduleTrigger trigger = ScheduleTrigger::TIME;
+  if (body.get("trigger", value))
+  {
+    trigger = parseScheduleTrigger(value.c_str());
+  }
+
+  short offset = 0;
+  if (body.get("offset", value))
+  {
+    offset = value.toInt();
+  }
+
+  String cron;
+  body.get("cron", cron);
+
+  Result<Schedule> result
+      = this->m_controller->createSchedule(remoteId, action, trigger, offset, cron.c_str());
+  if (!result.isSuccess)
+  {
+    return this->fail(result.errorMsg.c_str());
+  }
+  return BatchResponse { 200, this->m_serializer->serializeSchedule(result.data) };
+}
+
+BatchResponse RestApi::deleteSchedule(const RouteMatch& match, const BodyFields& body)
+{
+  // Stored on 16 bits, a larger id would delete another schedule once truncated
+  if (match.params[0] > UINT16_MAX)
+  {
+    return this->fail("The schedule doesn't exist.");
+  }
+
+  Result<Schedule> result = this->m_controller->deleteSchedule(match.params[0]);
+  if (!result.isSuccess)
+  {
+    return this->fail(result.errorMsg.c_str());
+  }
+  return BatchResponse { 200, this->m_serializer->serializeSchedule(result.data) };
+}
+
+BatchResponse RestApi::fetchLocation(const RouteMatch& match, const BodyFields& body)
+{
+  Result<Location> result = this->m_controller->fetchLocation();
+  if (!result.isSuccess)
+  {
+    return this->fail(result.errorMsg.c_str());
+  }
+  return BatchResponse { 200, this->m_serializer->serializeLocation(result.data) };
+}
+
+/**
+ * @brief Update the location, the fields not given keep their value.
+ *
+ */
+BatchResponse RestApi::updateLocation(const RouteMatch& match, const BodyFields& body)
+{
+  Location location = this->m_controller->fetchLocation().data;
+
+  float latitude = location.latitude;
+  String value;
+  if (body.get("latitude", value))
+  {
+    latitude = value.toFloat();
+  }
+
+  float longitude = location.longitude;
+  if (body.get("longitude", value))
+  {
+    longitude = value.toFloat();
+  }
+
+  String timezone = location.timezone;
+  body.get("timezone", timezone);
+
+  Result<Location> result
+      = this->m_controller->updateLocation(latitude, longitude, timezone.c_str());
+  if (!result.isSuccess)
+  {
+    return this->fail(result.errorMsg.c_str());
+  }
+  return BatchResponse { 200, this->m_serializer->serializeLocation(result.data) };
+}
+
+// PRIVATE
+
+BatchResponse RestApi::fail(const char* message)
+{
+  return BatchResponse { 400, this->m_serializer->serializeMessage(message) };
+}
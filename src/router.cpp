@@ -0,0 +1,203 @@
+/**
+ * @file router.cpp
+ * @author Laurette Alexandre
+ * @brief Implementation of the route table of the REST API.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <string.h>
+#include <stdint.h>
+
+#include <router.h>
+#include <utils.h>
+
+static bool isParamSegment(const char* segment, const uint8_t length)
+{
+  return length >= 2 && segment[0] == '{' && segment[length - 1] == '}';
+}
+
+/**
+ * @brief Length of the segment starting at path, up to the next '/' or the end.
+ *
+ */
+static size_t segmentLength(const char* path)
+{
+  const char* end = strchr(path, '/');
+  return end == nullptr ? strlen(path) : static_cast<size_t>(end - path);
+}
+
+/**
+ * @brief Add a route. Patterns are not copied, they must outlive the router (string literals).
+ *
+ * @param pattern The path, ie: "/api/v1/remotes/{id}"
+ * @param methods Mask of the methods
+ * @return The index of the route, ROUTE_NOT_FOUND if the table is full or the pattern invalid.
+ */
+int8_t Router::addRoute(const char* pattern, const uint8_t methods)
+{
+  if (pattern[0] != '/' || this->m_routesCount >= MAX_ROUTES)
+  {
+    return ROUTE_NOT_FOUND;
+  }
+
+  int8_t node = 0;
+  const char* segment = pattern;
+  while (*segment == '/')
+  {
+    segment++;
+    const size_t length = segmentLength(segment);
+    if (length == 0 || length > UINT8_MAX)
+    {
+      return ROUTE_NOT_FOUND;
+    }
+
+    int8_t child = this->findChild(node, segment, length);
+    if (child == ROUTE_NOT_FOUND)
+    {
+      child = this->addChild(node, segment, length);
+    }
+    if (child == ROUTE_NOT_FOUND)
+    {
+      return ROUTE_NOT_FOUND;
+    }
+    node = child;
+    segment += length;
+  }
+
+  const int8_t route = this->m_routesCount++;
+  this->m_routes[route].methods = methods;
+  this->m_routes[route].nextRoute = this->m_nodes[node].firstRoute;
+  this->m_nodes[node].firstRoute = route;
+  return route;
+}
+
+/**
+ * @brief Find the route of a request.
+ *
+ * @param path The path of the request, without the query
+ * @param method The method of the request
+ * @param match Filled with the route and the captured numbers
+ * @return true if a route matches both the path and the method.
+ */
+bool Router::match(const char* path, const uint8_t method, RouteMatch& match) const
+{
+  match.route = ROUTE_NOT_FOUND;
+  match.paramsCount = 0;
+  if (path[0] != '/')
+  {
+    return false;
+  }
+
+  int8_t node = 0;
+  const char* segment = path;
+  while (*segment == '/')
+  {
+    segment++;
+    const size_t length = segmentLength(segment);
+    if (length > UINT8_MAX)
+    {
+      return false;
+    }
+
+    int8_t next = ROUTE_NOT_FOUND;
+    int8_t param = ROUTE_NOT_FOUND;
+    for (int8_t child = this->m_nodes[node].firstChild; child != ROUTE_NOT_FOUND;
+         child = this->m_nodes[child].nextSibling)
+    {
+      const RouteNode& candidate = this->m_nodes[child];
+      if (candidate.isParam)
+      {
+        param = child;
+      }
+      else if (candidate.length == length && memcmp(candidate.segment, segment, length) == 0)
+      {
+        next = child;
+        break;
+      }
+    }
+
+    if (next == ROUTE_NOT_FOUND)
+    {
+      uint32_t value;
+      if (param == ROUTE_NOT_FOUND || match.paramsCount >= MAX_ROUTE_PARAMS
+          || !parseNumber(segment, length, value))
+      {
+        return false;
+      }
+      match.params[match.paramsCount++] = value;
+      next = param;
+    }
+    node = next;
+    segment += length;
+  }
+
+  for (int8_t route = this->m_nodes[node].firstRoute; route != ROUTE_NOT_FOUND;
+       route = this->m_routes[route].nextRoute)
+  {
+    if (this->m_routes[route].methods & method)
+    {
+      match.route = route;
+      return true;
+    }
+  }
+  return false;
+}
+
+// PRIVATE
+
+int8_t Router::findChild(const int8_t parent, const char* segment, const uint8_t length) const
+{
+  const bool isParam = isParamSegment(segment, length);
+  for (int8_t child = this->m_nodes[parent].firstChild; child != ROUTE_NOT_FOUND;
+       child = this->m_nodes[child].nextSibling)
+  {
+    const RouteNode& node = this->m_nodes[child];
+    if (isParam && node.isParam)
+    {
+      // Captures are not named, {id} and {remoteId} are the same segment.
+      return child;
+    }
+    if (!isParam && !node.isParam && node.length == length
+        && memcmp(node.segment, segment, length) == 0)
+    {
+      return child;
+    }
+  }
+  return ROUTE_NOT_FOUND;
+}
+
+int8_t Router::addChild(const int8_t parent, const char* segment, const uint8_t length)
+{
+  if (this->m_nodesCount >= MAX_ROUTE_NODES)
+  {
+    return ROUTE_NOT_FOUND;
+  }
+  const int8_t child = this->m_nodesCount++;
+  RouteNode& node = this->m_nodes[child];
+  node.segment = segment;
+  node.length = length;
+  node.isParam = isParamSegment(segment, length);
+  node.nextSibling = this->m_nodes[parent].firstChild;
+  this->m_nodes[parent].firstChild = child;
+  return child;
+}
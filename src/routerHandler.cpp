@@ -0,0 +1,264 @@
+/**
+ * @file routerHandler.cpp
+ * @author Laurette Alexandre
+ * @brief Implementation of the web handler dispatching the REST API through the router.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <DebugLog.h>
+#include <ESPAsyncWebServer.h>
+
+#include <batch.h>
+#include <config.h>
+#include <router.h>
+#include <metrics.h>
+#include <routerHandler.h>
+
+static WebRequestMethodComposite parseMethod(const char* method)
+{
+  if (strcmp(method, "GET") == 0)
+  {
+    return HTTP_GET;
+  }
+  if (strcmp(method, "POST") == 0)
+  {
+    return HTTP_POST;
+  }
+  if (strcmp(method, "PUT") == 0)
+  {
+    return HTTP_PUT;
+  }
+  if (strcmp(method, "PATCH") == 0)
+  {
+    return HTTP_PATCH;
+  }
+  if (strcmp(method, "DELETE") == 0)
+  {
+    return HTTP_DELETE;
+  }
+  return 0;
+}
+
+static const char* methodName(const WebRequestMethodComposite methods)
+{
+  switch (methods)
+  {
+  case HTTP_GET:
+    return "GET";
+  case HTTP_POST:
+    return "POST";
+  case HTTP_PUT:
+    return "PUT";
+  case HTTP_PATCH:
+    return "PATCH";
+  case HTTP_DELETE:
+    return "DELETE";
+  default:
+    return "ANY";
+  }
+}
+
+/**
+ * @brief Add a route.
+ *
+ * @param pattern The path, ie: "/api/v1/remotes/{id}". It is not copied.
+ * @param methods Mask of the methods, ie: HTTP_GET
+ * @param handler Called with the request
+ * @param batchHandler Called for a sub-request of a batch, nullptr to refuse the route in a batch
+ * @return false if the route table is full.
+ */
+bool RouterHandler::on(const char* pattern, const WebRequestMethodComposite methods,
+    RouteRequestHandler handler, RouteBatchHandler batchHandler)
+{
+  const int8_t route = this->m_router.addRoute(pattern, methods);
+  if (route == ROUTE_NOT_FOUND)
+  {
+    LOG_ERROR("Route not added:", pattern);
+    return false;
+  }
+  this->m_handlers[route] = handler;
+  this->m_batchHandlers[route] = batchHandler;
+  this->m_patterns[route] = pattern;
+  this->m_methods[route] = methods;
+  return true;
+}
+
+/**
+ * @brief Find the route of a sub-request of a batch.
+ *
+ * @param request The sub-request
+ * @param match Filled with the route and the captured numbers
+ * @return The handler, nullptr if no route allowed in a batch matches.
+ */
+RouteBatchHandler RouterHandler::findBatchHandler(
+    const BatchRequest& request, RouteMatch& match) const
+{
+  const WebRequestMethodComposite method = parseMethod(request.method);
+  if (method == 0 || !this->m_router.match(request.path, method, match))
+  {
+    return nullptr;
+  }
+  return this->m_batchHandlers[match.route];
+}
+
+/**
+ * @brief Get a number captured by the route of the request. Only valid in a route handler.
+ *
+ * @param request The request
+ * @param index The index of the capture in the path, from 0
+ * @return The number, 0 if there is no such capture.
+ */
+unsigned long RouterHandler::getPathParam(AsyncWebServerRequest* request, const uint8_t index)
+{
+  const RouteContext* context = RouterHandler::getContext(request);
+  if (context == nullptr || index >= context->match.paramsCount)
+  {
+    return 0;
+  }
+  return context->match.params[index];
+}
+
+/**
+ * @brief Get the application/json body of the request. Only valid in a route handler.
+ *
+ * @param request The request
+ * @return The body, nullptr if the request has no JSON body.
+ */
+const char* RouterHandler::getJsonBody(AsyncWebServerRequest* request)
+{
+  const RouteContext* context = RouterHandler::getContext(request);
+  return context == nullptr ? nullptr : context->body;
+}
+
+/**
+ * @brief Get what the router knows about the request. Only valid in a route handler.
+ *
+ * @param request The request
+ * @return The context, nullptr outside of a route handler.
+ */
+RouteContext* RouterHandler::getContext(AsyncWebServerRequest* request)
+{
+  return static_cast<RouteContext*>(request->_tempObject);
+}
+
+/**
+ * @brief Write the durations of the handler of a route, as a Prometheus histogram labelled with
+ * its method and its pattern. A route never reached writes nothing.
+ *
+ * @param output The output
+ * @param route The index of the route, the first one also writes the TYPE line
+ * @return false if there is no such route.
+ */
+bool RouterHandler::writeMetrics(Print& output, const uint8_t route) const
+{
+  const char name[] = "esprtsomfy_http_request_duration_seconds";
+  if (route >= MAX_ROUTES || this->m_handlers[route] == nullptr)
+  {
+    return false;
+  }
+  if (route == 0)
+  {
+    output.print("# TYPE ");
+    output.print(name);
+    output.print(" histogram\n");
+  }
+  if (this->m_durations[route].count == 0)
+  {
+    return true;
+  }
+
+  char labels[80]; // Truncated beyond, the patterns are much shorter
+  snprintf(labels, sizeof(labels), "method=\"%s\",route=\"%s\"",
+      methodName(this->m_methods[route]), this->m_patterns[route]);
+  Metrics::writeHistogram(output, name, labels, this->m_durations[route]);
+  return true;
+}
+
+bool RouterHandler::canHandle(AsyncWebServerRequest* request)
+{
+  RouteMatch match;
+  if (!this->m_router.match(request->url().c_str(), request->method(), match))
+  {
+    return false;
+  }
+  // Other headers are dropped by the server
+  for (uint8_t i = 0; i < ROUTE_HEADERS_COUNT; i++)
+  {
+    request->addInterestingHeader(ROUTE_HEADERS[i]);
+  }
+  return true;
+}
+
+void RouterHandler::handleRequest(AsyncWebServerRequest* request)
+{
+  RouteMatch match;
+  if (!this->m_router.match(request->url().c_str(), request->method(), match))
+  {
+    request->send(404);
+    return;
+  }
+
+  char* body = static_cast<char*>(request->_tempObject);
+  if (body == nullptr && request->contentLength() > 0
+      && request->contentType().equalsIgnoreCase("application/json"))
+  {
+    request->send(413, "application/json",
+        "{\"message\":\"The JSON body is limited to " + String(MAX_JSON_BODY_SIZE) + " bytes.\"}");
+    return;
+  }
+
+  // The handler runs synchronously, the context only lives during the call. The request frees
+  // its temp object, so the body is put back afterwards.
+  RouteContext context = { match, body, BodyFields(), false };
+  request->_tempObject = &context;
+  const uint32_t start = micros();
+  this->m_handlers[match.route](request);
+  this->m_durations[match.route].observe(micros() - start);
+  request->_tempObject = body;
+}
+
+/**
+ * @brief Accumulate an application/json body, chunk by chunk, in the temp object of the request.
+ * Other bodies are parsed as params by the server.
+ *
+ */
+void RouterHandler::handleBody(
+    AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total)
+{
+  if (!request->contentType().equalsIgnoreCase("application/json") || total > MAX_JSON_BODY_SIZE)
+  {
+    return;
+  }
+  if (index == 0)
+  {
+    request->_tempObject = malloc(total + 1); // Freed by the request
+  }
+  if (request->_tempObject == nullptr || index + len > total)
+  {
+    return;
+  }
+
+  char* body = static_cast<char*>(request->_tempObject);
+  memcpy(body + index, data, len);
+  body[index + len] = '\0';
+}
@@ -0,0 +1,289 @@
+/**
+ * @file scheduler.cpp
+ * @author Laurette Alexandre
+ * @brief Implementation of the schedule engine.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <math.h>
+#include <time.h>
+#include <Arduino.h>
+#include <DebugLog.h>
+
+#include <cron.h>
+#include <config.h>
+#include <result.h>
+#include <schedule.h>
+#include <clockAbs.h>
+#include <scheduler.h>
+#include <controller.h>
+#include <timerWheel.h>
+
+/**
+ * @brief Number of days since 1970-01-01 of a date of the proleptic gregorian calendar.
+ * From http://howardhinnant.github.io/date_algorithms.html
+ *
+ */
+long daysFromCivil(const int year, const unsigned int month, const unsigned int day)
+{
+  const int y = year - (month <= 2 ? 1 : 0);
+  const long era = (y >= 0 ? y : y - 399) / 400;
+  const unsigned int yearOfEra = static_cast<unsigned int>(y - era * 400);
+  const unsigned int dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+  const unsigned int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+  return era * 146097 + static_cast<long>(dayOfEra) - 719468;
+}
+
+/**
+ * @brief Compute the sunrise or the sunset of a day, with the algorithm of the Almanac for
+ * Computers (1990). It is accurate to a minute or two, which is enough to operate blinds.
+ *
+ * @param year The year of the day
+ * @param month The month of the day, from 1
+ * @param day The day of the month, from 1
+ * @param latitude Degrees, north is positive
+ * @param longitude Degrees, east is positive
+ * @param sunrise true for the sunrise, false for the sunset
+ * @param minutes The UTC time of the event, in minutes from the UTC midnight of the day. It can be
+ * negative or above 24h far from the greenwich meridian.
+ * @return true if the event happens this day
+ * @return false otherwise (polar day or polar night)
+ */
+bool computeSunEvent(const int year, const unsigned int month, const unsigned int day,
+    const float latitude, const float longitude, const bool sunrise, int& minutes)
+{
+  const double zenith = 90.833; // Center of the sun below the horizon, with the refraction
+  const double toRadians = M_PI / 180.0;
+
+  long dayOfYear = daysFromCivil(year, month, day) - daysFromCivil(year, 1, 1) + 1;
+  double longitudeHour = longitude / 15.0;
+  double approximateTime = dayOfYear + ((sunrise ? 6.0 : 18.0) - longitudeHour) / 24.0;
+
+  double meanAnomaly = 0.9856 * approximateTime - 3.289;
+  double trueLongitude = meanAnomaly + 1.916 * sin(meanAnomaly * toRadians)
+      + 0.020 * sin(2 * meanAnomaly * toRadians) + 282.634;
+  trueLongitude = fmod(trueLongitude + 360.0, 360.0);
+
+  double rightAscension = atan(0.91764 * tan(trueLongitude * toRadians)) / toRadians;
+  rightAscension = fmod(rightAscension + 360.0, 360.0);
+  rightAscension += floor(trueLongitude / 90.0) * 90.0 - floor(rightAscension / 90.0) * 90.0;
+  rightAscension /= 15.0;
+
+  double sinDeclination = 0.39782 * sin(trueLongitude * toRadians);
+  double cosDeclination = cos(asin(sinDeclination));
+  double cosHourAngle = (cos(zenith * toRadians) - sinDeclination * sin(latitude * toRadians))
+      / (cosDeclination * cos(latitude * toRadians));
+  if (cosHourAngle > 1.0 || cosHourAngle < -1.0)
+  {
+    return false;
+  }
+
+  double hourAngle = acos(cosHourAngle) / toRadians;
+  if (sunrise)
+  {
+    hourAngle = 360.0 - hourAngle;
+  }
+  hourAngle /= 15.0;
+
+  double localMeanTime = hourAngle + rightAscension - 0.06571 * approximateTime - 6.622;
+  localMeanTime = fmod(localMeanTime + 24.0, 24.0);
+  minutes = static_cast<int>(lround((localMeanTime - longitudeHour) * 60.0));
+  return true;
+}
+
+/**
+ * @brief Compute the next run of a schedule.
+ *
+ * @param schedule The schedule
+ * @param masks Its parsed cron expression
+ * @param location Used for sun events
+ * @param clock Used to convert local times
+ * @param from The next run is strictly after this time
+ * @return time_t The next run, 0 if the schedule never runs.
+ */
+time_t computeNextRun(const Schedule& schedule, const CronMasks& masks, const Location& location,
+    ClockAbstract* clock, const time_t from)
+{
+  struct tm fromLocal;
+  clock->toLocalTime(from, fromLocal);
+
+  // Days are walked at noon, far from the daylight saving changes.
+  struct tm day = fromLocal;
+  day.tm_hour = 12;
+  day.tm_min = 0;
+  day.tm_sec = 0;
+  day.tm_isdst = -1;
+  time_t noon = clock->fromLocalTime(day);
+
+  for (unsigned short i = 0; i < MAX_SCHEDULE_SEARCH_DAYS; ++i)
+  {
+    if (i != 0)
+    {
+      noon += 24 * 3600;
+      clock->toLocalTime(noon, day);
+    }
+    if (!cronMatchesDay(masks, day))
+    {
+      continue;
+    }
+
+    if (schedule.trigger == ScheduleTrigger::TIME)
+    {
+      for (int hour = i == 0 ? fromLocal.tm_hour : 0; hour < 24; ++hour)
+      {
+        if (((masks.hours >> hour) & 1) == 0)
+        {
+          continue;
+        }
+        for (int minute = 0; minute < 60; ++minute)
+        {
+          if (((masks.minutes >> minute) & 1) == 0)
+          {
+            continue;
+          }
+          struct tm at = day;
+          at.tm_hour = hour;
+          at.tm_min = minute;
+          at.tm_sec = 0;
+          at.tm_isdst = -1;
+          time_t run = clock->fromLocalTime(at);
+          if (run > from)
+          {
+            return run;
+          }
+        }
+      }
+      continue;
+    }
+
+    int minutes;
+    bool sunrise = schedule.trigger == ScheduleTrigger::SUNRISE;
+    if (!computeSunEvent(day.tm_year + 1900, day.tm_mon + 1, day.tm_mday, location.latitude,
+            location.longitude, sunrise, minutes))
+    {
+      continue;
+    }
+    long days = daysFromCivil(day.tm_year + 1900, day.tm_mon + 1, day.tm_mday);
+    time_t run = static_cast<time_t>(days) * 24 * 3600 + (minutes + schedule.offset) * 60;
+    if (run > from)
+    {
+      return run;
+    }
+  }
+  return 0;
+}
+
+Scheduler::Scheduler(Controller* controller, ClockAbstract* clock)
+    : m_controller(controller)
+    , m_clock(clock)
+{
+  for (unsigned short i = 0; i < MAX_SCHEDULES; ++i)
+  {
+    this->m_timers[i].id = i;
+  }
+}
+
+/**
+ * @brief Run the schedules which are due. Should be called from the main loop.
+ * Nothing happens until the clock is synced.
+ *
+ */
+void Scheduler::handleSchedules()
+{
+  time_t now = this->m_clock->now();
+  if (now < static_cast<time_t>(MIN_VALID_TIME))
+  {
+    return;
+  }
+
+  unsigned long revision = this->m_controller->getSchedulesRevision();
+  if (!this->m_loaded || revision != this->m_revision)
+  {
+    this->m_revision = revision;
+    this->reload(now);
+  }
+
+  TimerNode* expired = this->m_wheel.advance(now);
+  while (expired != nullptr)
+  {
+    TimerNode* next = expired->next;
+    this->run(expired->id, now);
+    expired = next;
+  }
+}
+
+// PRIVATE
+
+void Scheduler::reload(const time_t now)
+{
+  LOG_INFO("Loading schedules...");
+  this->m_wheel.begin(now);
+
+  this->m_location = this->m_controller->fetchLocation().data;
+  this->m_clock->setTimezone(this->m_location.timezone);
+
+  Result<Schedule[MAX_SCHEDULES]> result = this->m_controller->fetchAllSchedules();
+  unsigned short count = 0;
+  for (unsigned short i = 0; i < MAX_SCHEDULES; ++i)
+  {
+    this->m_schedules[i] = result.data[i];
+    if (this->m_schedules[i].id == 0)
+    {
+      continue;
+    }
+    if (!parseCronExpression(this->m_schedules[i].cron, this->m_masks[i]))
+    {
+      LOG_WARN("Invalid cron expression on the schedule:", this->m_schedules[i].id);
+      this->m_schedules[i].id = 0;
+      continue;
+    }
+    this->arm(i, now);
+    ++count;
+  }
+  this->m_loaded = true;
+  LOG_INFO("Schedules loaded:", count);
+}
+
+void Scheduler::arm(const unsigned short index, const time_t from)
+{
+  time_t next = computeNextRun(
+      this->m_schedules[index], this->m_masks[index], this->m_location, this->m_clock, from);
+  if (next == 0)
+  {
+    LOG_WARN("The schedule will never run:", this->m_schedules[index].id);
+    return;
+  }
+  this->m_wheel.schedule(&this->m_timers[index], static_cast<uint32_t>(next));
+}
+
+void Scheduler::run(const unsigned short index, const time_t now)
+{
+  const Schedule& schedule = this->m_schedules[index];
+  LOG_INFO("Running the schedule", schedule.id);
+  Result<String> result = this->m_controller->operateRemote(schedule.remoteId, schedule.action);
+  if (!result.isSuccess)
+  {
+    LOG_ERROR(result.errorMsg);
+  }
+  this->arm(index, now);
+}
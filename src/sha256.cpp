@@ -0,0 +1,163 @@
+/**
+ * @file sha256.cpp
+ * @author Laurette Alexandre
+ * @brief SHA-256 computed on the fly, chunk by chunk (FIPS 180-4).
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include <sha256.h>
+
+static const uint32_t K[64] = { 0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b,
+  0x59f111f1, 0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74,
+  0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f,
+  0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3,
+  0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354,
+  0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819,
+  0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3,
+  0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa,
+  0xa4506ceb, 0xbef9a3f7, 0xc67178f2 };
+
+static inline uint32_t rotateRight(const uint32_t value, const uint8_t bits)
+{
+  return (value >> bits) | (value << (32 - bits));
+}
+
+Sha256::Sha256() { this->reset(); }
+
+void Sha256::reset()
+{
+  static const uint32_t initialState[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+  memcpy(this->m_state, initialState, sizeof(this->m_state));
+  this->m_blockLength = 0;
+  this->m_length = 0;
+}
+
+void Sha256::update(const uint8_t* data, size_t length)
+{
+  this->m_length += length;
+  while (length > 0)
+  {
+    const size_t size = sizeof(this->m_block) - this->m_blockLength < length
+        ? sizeof(this->m_block) - this->m_blockLength
+        : length;
+    memcpy(this->m_block + this->m_blockLength, data, size);
+    this->m_blockLength += size;
+    data += size;
+    length -= size;
+    if (this->m_blockLength == sizeof(this->m_block))
+    {
+      this->transform();
+      this->m_blockLength = 0;
+    }
+  }
+}
+
+/**
+ * @brief Pad the last block and write the digest. Call reset before hashing again.
+ *
+ */
+void Sha256::finish(uint8_t digest[SHA256_SIZE])
+{
+  const uint64_t bits = this->m_length * 8;
+  this->m_block[this->m_blockLength++] = 0x80;
+  if (this->m_blockLength > 56)
+  {
+    memset(this->m_block + this->m_blockLength, 0, sizeof(this->m_block) - this->m_blockLength);
+    this->transform();
+    this->m_blockLength = 0;
+  }
+  memset(this->m_block + this->m_blockLength, 0, 56 - this->m_blockLength);
+  for (uint8_t i = 0; i < 8; i++)
+  {
+    this->m_block[63 - i] = bits >> (8 * i);
+  }
+  this->transform();
+
+  for (uint8_t i = 0; i < 8; i++)
+  {
+    digest[4 * i] = this->m_state[i] >> 24;
+    digest[4 * i + 1] = this->m_state[i] >> 16;
+    digest[4 * i + 2] = this->m_state[i] >> 8;
+    digest[4 * i + 3] = this->m_state[i];
+  }
+}
+
+void Sha256::finishHex(char hex[SHA256_HEX_LENGTH])
+{
+  uint8_t digest[SHA256_SIZE];
+  this->finish(digest);
+  for (uint8_t i = 0; i < SHA256_SIZE; i++)
+  {
+    sprintf(hex + 2 * i, "%02x", digest[i]);
+  }
+}
+
+// PRIVATE
+
+void Sha256::transform()
+{
+  uint32_t w[64];
+  for (uint8_t i = 0; i < 16; i++)
+  {
+    w[i] = (uint32_t(this->m_block[4 * i]) << 24) | (uint32_t(this->m_block[4 * i + 1]) << 16)
+        | (uint32_t(this->m_block[4 * i + 2]) << 8) | this->m_block[4 * i + 3];
+  }
+  for (uint8_t i = 16; i < 64; i++)
+  {
+    const uint32_t s0 = rotateRight(w[i - 15], 7) ^ rotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+    const uint32_t s1 = rotateRight(w[i - 2], 17) ^ rotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+
+  uint32_t a = this->m_state[0], b = this->m_state[1], c = this->m_state[2], d = this->m_state[3];
+  uint32_t e = this->m_state[4], f = this->m_state[5], g = this->m_state[6], h = this->m_state[7];
+  for (uint8_t i = 0; i < 64; i++)
+  {
+    const uint32_t s1 = rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25);
+    const uint32_t choice = (e & f) ^ (~e & g);
+    const uint32_t temp1 = h + s1 + choice + K[i] + w[i];
+    const uint32_t s0 = rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22);
+    const uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+    const uint32_t temp2 = s0 + majority;
+    h = g;
+    g = f;
+    f = e;
+    e = d + temp1;
+    d = c;
+    c = b;
+    b = a;
+    a = temp1 + temp2;
+  }
+  this->m_state[0] += a;
+  this->m_state[1] += b;
+  this->m_state[2] += c;
+  this->m_state[3] += d;
+  this->m_state[4] += e;
+  this->m_state[5] += f;
+  this->m_state[6] += g;
+  this->m_state[7] += h;
+}
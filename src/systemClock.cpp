@@ -0,0 +1,57 @@
+/**
+ * @file systemClock.cpp
+ * @author Laurette Alexandre
+ * @brief Implementation of the clock synced with NTP.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <time.h>
+#include <Arduino.h>
+#include <DebugLog.h>
+
+#include <config.h>
+#include <systemClock.h>
+
+/**
+ * @brief Start the synchronisation with the NTP server. It runs in background, now() is not
+ * valid until the first answer.
+ *
+ */
+void SystemClock::begin()
+{
+  LOG_INFO("Starting NTP synchronisation...");
+  configTime(DEFAULT_TIMEZONE, NTP_SERVER);
+}
+
+time_t SystemClock::now() { return time(nullptr); }
+
+void SystemClock::setTimezone(const char* timezone)
+{
+  LOG_DEBUG("Timezone set to", timezone);
+  setenv("TZ", timezone, 1);
+  tzset();
+}
+
+void SystemClock::toLocalTime(const time_t& time, struct tm& local) { localtime_r(&time, &local); }
+
+time_t SystemClock::fromLocalTime(struct tm& local) { return mktime(&local); }
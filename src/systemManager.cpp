@@ -27,8 +27,38 @@
  */
 
 #include <Arduino.h>
+#include <DebugLog.h>
+
+#include <config.h>
 #include <systemManager.h>
 
+// Kept in the RTC memory, it survives a reset or a crash but not a power loss.
+struct BootRecord {
+    uint32_t magic;
+    uint32_t failedBoots;
+};
+const uint32_t BOOT_RECORD_MAGIC = 0x52545342;
+const uint32_t BOOT_RECORD_OFFSET = 32; // In blocks of 4 bytes, the first 128 bytes are for eboot
+
+/**
+ * @brief Count this boot as failed, until the main loop runs long enough to confirm it.
+ *
+ * @return false if the last MAX_FAILED_BOOTS boots failed, the firmware should start in safe
+ * mode. The count is cleared, so the next boot tries the normal mode again.
+ */
+bool SystemManager::beginBoot(){
+    BootRecord record;
+    ESP.rtcUserMemoryRead(BOOT_RECORD_OFFSET, reinterpret_cast<uint32_t*>(&record), sizeof(record));
+    uint32_t failedBoots = record.magic == BOOT_RECORD_MAGIC ? record.failedBoots + 1 : 1;
+    if (failedBoots > MAX_FAILED_BOOTS){
+        LOG_ERROR("The last boots failed, starting in safe mode.");
+        this->writeFailedBoots(0);
+        return false;
+    }
+    this->writeFailedBoots(failedBoots);
+    return true;
+}
+
 void SystemManager::handleActions(){
     unsigned long t = millis();
     if (t - this->m_lastHandled >= 500){
@@ -36,9 +66,27 @@ void SystemManager::handleActions(){
         if(this->m_restartRequested){
             ESP.restart();
         }
+        if(!this->m_bootConfirmed && t >= BOOT_CONFIRM_DELAY_MS){
+            // The controller ran that long, the firmware is considered good.
+            this->m_bootConfirmed = true;
+            this->writeFailedBoots(0);
+            LOG_INFO("Boot confirmed.");
+        }
     }
 }
 
+/**
+ * @brief Restart on the next call to handleActions. A deliberate restart is not a failed boot,
+ * even before the boot is confirmed: after an update or a change of configuration.
+ *
+ */
 void SystemManager::requestRestart(){
     this->m_restartRequested = true;
+    this->writeFailedBoots(0);
+}
+
+// PRIVATE
+void SystemManager::writeFailedBoots(const uint32_t failedBoots){
+    BootRecord record = { BOOT_RECORD_MAGIC, failedBoots };
+    ESP.rtcUserMemoryWrite(BOOT_RECORD_OFFSET, reinterpret_cast<uint32_t*>(&record), sizeof(record));
 }
\ No newline at end of file
@@ -0,0 +1,216 @@
+/**
+ * @file timerWheel.cpp
+ * @author Laurette Alexandre
+ * @brief Implementation of the hierarchical timing wheel.
+ * @version 2.2.0
+ * @date 2026-10-19
+ *
+ * @copyright (c) 2026 Laurette Alexandre
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <timerWheel.h>
+
+/**
+ * @brief Start the wheel at the given tick. All timers armed before are dropped.
+ *
+ * @param now The current tick
+ */
+void TimerWheel::begin(const uint32_t now)
+{
+  for (uint8_t level = 0; level < TIMER_WHEEL_LEVELS; ++level)
+  {
+    for (uint16_t index = 0; index < TIMER_WHEEL_SLOTS; ++index)
+    {
+      TimerNode* node = this->detachSlot(level, index);
+      while (node != nullptr)
+      {
+        TimerNode* next = node->next;
+        node->next = nullptr;
+        node = next;
+      }
+    }
+  }
+  this->m_current = now;
+}
+
+/**
+ * @brief Arm a timer. If it is already armed, it is moved.
+ *
+ * @param node The timer
+ * @param expires The tick when the timer expires. A past tick expires on the next advance.
+ */
+void TimerWheel::schedule(TimerNode* node, const uint32_t expires)
+{
+  this->cancel(node);
+  node->expires = expires;
+  this->insert(node);
+}
+
+void TimerWheel::cancel(TimerNode* node)
+{
+  if (node->pprev == nullptr)
+  {
+    return;
+  }
+  *node->pprev = node->next;
+  if (node->next != nullptr)
+  {
+    node->next->pprev = node->pprev;
+  }
+  node->next = nullptr;
+  node->pprev = nullptr;
+}
+
+/**
+ * @brief Process all ticks up to now (included).
+ *
+ * @param now The current tick
+ * @return TimerNode* The expired timers, linked by next. They are no longer armed, so they can be
+ * scheduled again while the list is walked (read next first).
+ */
+TimerNode* TimerWheel::advance(const uint32_t now)
+{
+  int32_t distance = static_cast<int32_t>(now - this->m_current);
+  if (distance > TIMER_WHEEL_SLOTS * TIMER_WHEEL_SLOTS || distance < -TIMER_WHEEL_SLOTS)
+  {
+    // The clock jumped (first sync, long pause, adjusted backward). Ticking through the gap
+    // would be too long, so all timers are placed again from now.
+    this->rebase(now);
+  }
+
+  TimerNode* expired = nullptr;
+  while (static_cast<int32_t>(now - this->m_current) >= 0)
+  {
+    uint16_t index = this->m_current & TIMER_WHEEL_MASK;
+    for (uint8_t level = 1; index == 0 && level < TIMER_WHEEL_LEVELS; ++level)
+    {
+      index = this->cascade(level);
+    }
+
+    TimerNode* node = this->detachSlot(0, this->m_current & TIMER_WHEEL_MASK);
+    while (node != nullptr)
+    {
+      TimerNode* next = node->next;
+      node->next = expired;
+      expired = node;
+      node = next;
+    }
+    ++this->m_current;
+  }
+  return expired;
+}
+
+// PRIVATE
+
+void TimerWheel::insert(TimerNode* node)
+{
+  uint32_t expires = node->expires;
+  uint32_t delta = expires - this->m_current;
+  if (static_cast<int32_t>(delta) < 0)
+  {
+    // Already expired, it goes in the next processed slot.
+    expires = this->m_current;
+    delta = 0;
+  }
+  else if (delta >= (1UL << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS)))
+  {
+    // Too far, it will be placed again when its slot of the last level cascades.
+    expires = this->m_current + (1UL << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS)) - 1;
+    delta = expires - this->m_current;
+  }
+
+  uint8_t level = 0;
+  while (level < TIMER_WHEEL_LEVELS - 1 && delta >= (1UL << (TIMER_WHEEL_BITS * (level + 1))))
+  {
+    ++level;
+  }
+
+  uint16_t index = (expires >> (TIMER_WHEEL_BITS * level)) & TIMER_WHEEL_MASK;
+  TimerNode** head = &this->m_slots[level][index];
+  node->next = *head;
+  if (node->next != nullptr)
+  {
+    node->next->pprev = &node->next;
+  }
+  node->pprev = head;
+  *head = node;
+}
+
+/**
+ * @brief Move the timers of the current slot of a level to the lower levels.
+ *
+ * @param level The level to cascade, from 1
+ * @return uint16_t The index of the cascaded slot. When it is 0, the upper level must cascade too.
+ */
+uint16_t TimerWheel::cascade(const uint8_t level)
+{
+  uint16_t index = (this->m_current >> (TIMER_WHEEL_BITS * level)) & TIMER_WHEEL_MASK;
+  TimerNode* node = this->detachSlot(level, index);
+  while (node != nullptr)
+  {
+    TimerNode* next = node->next;
+    this->insert(node);
+    node = next;
+  }
+  return index;
+}
+
+/**
+ * @brief Empty a slot.
+ *
+ * @return TimerNode* The timers of the slot, linked by next and no longer armed.
+ */
+TimerNode* TimerWheel::detachSlot(const uint8_t level, const uint16_t index)
+{
+  TimerNode* first = this->m_slots[level][index];
+  this->m_slots[level][index] = nullptr;
+  for (TimerNode* node = first; node != nullptr; node = node->next)
+  {
+    node->pprev = nullptr;
+  }
+  return first;
+}
+
+void TimerWheel::rebase(const uint32_t now)
+{
+  TimerNode* all = nullptr;
+  for (uint8_t level = 0; level < TIMER_WHEEL_LEVELS; ++level)
+  {
+    for (uint16_t index = 0; index < TIMER_WHEEL_SLOTS; ++index)
+    {
+      TimerNode* node = this->detachSlot(level, index);
+      while (node != nullptr)
+      {
+        TimerNode* next = node->next;
+        node->next = all;
+        all = node;
+        node = next;
+      }
+    }
+  }
+
+  this->m_current = now;
+  while (all != nullptr)
+  {
+    TimerNode* next = all->next;
+    this->insert(all);
+    all = next;
+  }
+}
@@ -40,4 +40,35 @@ unsigned long macToLong(const char* macAddress)
   }
 
   return result;
+}
+
+/**
+ * @brief Parse a segment made only of digits, ie: an id in a path or a topic.
+ *
+ * @param segment The segment, not terminated
+ * @param length Length of the segment
+ * @param value The number parsed
+ * @return false if the segment is empty, has another char or overflows.
+ */
+bool parseNumber(const char* segment, const uint8_t length, uint32_t& value)
+{
+  if (length == 0)
+  {
+    return false;
+  }
+  value = 0;
+  for (uint8_t i = 0; i < length; i++)
+  {
+    if (segment[i] < '0' || segment[i] > '9')
+    {
+      return false;
+    }
+    const uint32_t digit = segment[i] - '0';
+    if (value > (UINT32_MAX - digit) / 10)
+    {
+      return false;
+    }
+    value = value * 10 + digit;
+  }
+  return true;
 }
\ No newline at end of file
@@ -29,22 +29,45 @@
 #include <LittleFS.h>
 #include <ESPAsyncTCP.h>
 #include <ESPAsyncWebServer.h>
+#include <WebAuthentication.h>
 
 #include <result.h>
 #include <remote.h>
+#include <scene.h>
+#include <event.h>
+#include <command.h>
+#include <schedule.h>
+#include <batch.h>
+#include <router.h>
+#include <loadStats.h>
+#include <metrics.h>
 #include <controller.h>
 #include <webServer.h>
+#include <assetHandler.h>
+#ifdef EMBED_ASSETS
+#include <embeddedAssets.h> // Generated by scripts/build_assets.py
+#endif
+#include <restApi.h>
+#include <routerHandler.h>
+#include <chunkedWriter.h>
+#include <admissionControl.h>
+#include <admissionHandler.h>
 #include <serializerAbs.h>
 
 WebServer* WebServer::m_instance = nullptr;
 
-WebServer::WebServer(
-    const unsigned short port, Controller* controller, SerializerAbstract* serializer)
+WebServer::WebServer(const unsigned short port, Controller* controller,
+    SerializerAbstract* serializer, OtaUpdater* updater)
     : m_controller(controller)
     , m_serializer(serializer)
+    , m_api(controller, serializer)
+    , m_admission(MAX_IN_FLIGHT_REQUESTS, RESERVED_COMMAND_REQUESTS, MIN_FREE_HEAP,
+          MIN_FREE_HEAP_COMMAND)
+    , m_updater(updater)
 {
   this->m_server = new AsyncWebServer(port);
   this->m_instance = this;
+  this->m_bootId = ESP.random();
 }
 
 WebServer::~WebServer() { delete this->m_server; }
@@ -54,36 +77,153 @@ WebServer* WebServer::getInstance() { return WebServer::m_instance; }
 void WebServer::setup()
 {
   DefaultHeaders::Instance().addHeader("Access-Control-Allow-Origin", "*");
+
+  // Before any other handler, so a shed request allocates nothing.
+  this->m_server->addHandler(new AdmissionHandler(this->m_admission)); // Deleted by the server
+
+  // API first, so its requests are not looked up in the filesystem.
+  RouterHandler* router = new RouterHandler();
+  router->on("/api/v1/system/restart", HTTP_POST, WebServer::handleSystemRestart);
+  router->on("/api/v1/system/infos", HTTP_GET, WebServer::handleFetchSystemInfos);
+  router->on("/api/v1/system/load", HTTP_GET, WebServer::handleFetchSystemLoad);
+  router->on("/api/v1/metrics", HTTP_GET, WebServer::handleFetchMetrics);
+  router->on("/api/v1/wifi/networks", HTTP_GET, WebServer::handleFetchWifiNetworks);
+  router->on("/api/v1/wifi/scan", HTTP_GET, WebServer::handleFetchWifiScan);
+  router->on("/api/v1/wifi/scan", HTTP_POST, WebServer::handleScanWifiNetworks);
+  router->on("/api/v1/wifi/config", HTTP_GET, WebServer::handleFetchWifiConfiguration);
+  router->on("/api/v1/wifi/config", HTTP_POST, WebServer::handleUpdateWifiConfiguration);
+  router->on("/api/v1/mqtt/config", HTTP_GET, WebServer::handleFetchMQTTConfiguration);
+  router->on("/api/v1/mqtt/config", HTTP_POST, WebServer::handleUpdateMQTTConfiguration);
+  router->on("/api/v1/remotes", HTTP_GET, WebServer::handleFetchAllRemotes);
+  router->on("/api/v1/remotes", HTTP_POST, WebServer::handleCreateRemote,
+      &RestApi::createRemote);
+  router->on("/api/v1/remotes/{id}", HTTP_GET, WebServer::handleFetchRemote);
+  router->on("/api/v1/remotes/{id}", HTTP_PATCH, WebServer::handleUpdateRemote,
+      &RestApi::updateRemote);
+  router->on("/api/v1/remotes/{id}", HTTP_DELETE, WebServer::handleDeleteRemote,
+      &RestApi::deleteRemote);
+  router->on("/api/v1/remotes/{id}/action", HTTP_POST, WebServer::handleActionRemote,
+      &RestApi::actionRemote);
+  router->on("/api/v1/actions", HTTP_POST, WebServer::handleOperateBatch);
+  router->on("/api/v1/commands/{id}", HTTP_GET, WebServer::handleFetchCommand);
+  router->on("/api/v1/scenes", HTTP_GET, WebServer::handleFetchAllScenes);
+  router->on("/api/v1/scenes", HTTP_POST, WebServer::handleCreateScene);
+  router->on("/api/v1/scenes/{id}", HTTP_DELETE, WebServer::handleDeleteScene);
+  router->on("/api/v1/schedules", HTTP_GET, WebServer::handleFetchAllSchedules);
+  router->on("/api/v1/schedules", HTTP_POST, WebServer::handleCreateSchedule);
+  router->on("/api/v1/schedules/{id}", HTTP_DELETE, WebServer::handleDeleteSchedule);
+  router->on("/api/v1/location", HTTP_GET, WebServer::handleFetchLocation);
+  router->on("/api/v1/location", HTTP_POST, WebServer::handleUpdateLocation);
+  router->on("/api/v1/batch", HTTP_POST, WebServer::handleBatch);
+  router->on("/api/v1/ota", HTTP_GET, WebServer::handleFetchOta);
+  this->m_server->addHandler(router); // Deleted by the server
+  this->m_router = router;
+  this->setupOta();
+
+  AssetHandler* assets = new AssetHandler(LittleFS);
+#ifdef EMBED_ASSETS
+  assets->load(EMBEDDED_ASSETS, EMBEDDED_ASSETS_COUNT);
+  this->m_server->addHandler(assets); // Deleted by the server
+#else
+  assets->load(ASSETS_MANIFEST);
+  this->m_server->addHandler(assets); // Deleted by the server, checked before serveStatic
   this->m_server->serveStatic("/", LittleFS, "/");
   this->m_server->on("/", HTTP_GET, handleHTMLHomePage);
+#endif
   this->m_server->onNotFound(handleHTMLNotFoundPage);
 
-  this->m_server->on("/api/v1/system/restart", HTTP_POST, WebServer::handleSystemRestart);
-  this->m_server->on("/api/v1/system/infos", HTTP_GET, WebServer::handleFetchSystemInfos);
-  this->m_server->on("/api/v1/wifi/networks", HTTP_GET, WebServer::handleFetchWifiNetworks);
-  this->m_server->on("/api/v1/wifi/config", HTTP_GET, WebServer::handleFetchWifiConfiguration);
-  this->m_server->on("/api/v1/wifi/config", HTTP_POST, WebServer::handleUpdateWifiConfiguration);
-  this->m_server->on("/api/v1/mqtt/config", HTTP_GET, WebServer::handleFetchMQTTConfiguration);
-  this->m_server->on("/api/v1/mqtt/config", HTTP_POST, WebServer::handleUpdateMQTTConfiguration);
-  this->m_server->on("^\\/api/v1/remotes$", HTTP_GET, WebServer::handleFetchAllRemotes);
-  this->m_server->on("^\\/api/v1/remotes$", HTTP_POST, WebServer::handleCreateRemote);
-  this->m_server->on("^\\/api/v1/remotes\\/([0-9]+)$", HTTP_GET, WebServer::handleFetchRemote);
-  this->m_server->on("^\\/api/v1/remotes\\/([0-9]+)$", HTTP_PATCH, WebServer::handleUpdateRemote);
-  this->m_server->on("^\\/api/v1/remotes\\/([0-9]+)$", HTTP_DELETE, WebServer::handleDeleteRemote);
-  this->m_server->on(
-      "^\\/api/v1/remotes\\/([0-9]+)\\/action$", HTTP_POST, WebServer::handleActionRemote);
+  this->m_events = new AsyncEventSource("/api/v1/events");
+  this->m_events->onConnect(WebServer::handleEventsConnect);
+  this->m_server->addHandler(this->m_events); // Deleted by the server
   LOG_INFO("Webserver setuped.");
 }
 
+/**
+ * @brief Setup only what is needed to update the firmware, when the last boots failed. No route
+ * reaches the database, it may be what fails.
+ *
+ */
+void WebServer::setupSafeMode()
+{
+  this->m_server->addHandler(new AdmissionHandler(this->m_admission)); // Deleted by the server
+
+  RouterHandler* router = new RouterHandler();
+  router->on("/api/v1/system/restart", HTTP_POST, WebServer::handleSystemRestart);
+  router->on("/api/v1/ota", HTTP_GET, WebServer::handleFetchOta);
+  this->m_server->addHandler(router); // Deleted by the server
+  this->m_router = router;
+  this->setupOta();
+
+  this->m_events = new AsyncEventSource("/api/v1/events");
+  this->m_server->addHandler(this->m_events); // Deleted by the server
+  LOG_INFO("Webserver setuped in safe mode.");
+}
+
+static_assert(sizeof(OTA_PASSWORD) > 1,
+    "Set the OTA password: ESPRTSOMFY_OTA_PASSWORD=<password> pio run. Without it, anyone on the "
+    "network could replace the firmware.");
+
+/**
+ * @brief Setup the upload of updates. Only the hash of the credentials is kept, so a Basic
+ * authentication, which sends the password in clear, is never accepted.
+ *
+ */
+void WebServer::setupOta()
+{
+  this->m_otaCredentials = generateDigestHash(OTA_USERNAME, OTA_PASSWORD, OTA_REALM);
+  this->m_server->on(
+      "/api/v1/ota", HTTP_POST, WebServer::handleOtaDone, WebServer::handleOtaUpload);
+}
+
 void WebServer::begin()
 {
   this->m_server->begin();
   LOG_INFO("WebServer started.");
 }
 
-void WebServer::notified(const char* action, const Remote& remote)
+/**
+ * @brief Send the pending resync once the slow clients caught up. Should be called from the main
+ * loop.
+ *
+ */
+void WebServer::handleEvents()
+{
+  if (!this->m_resyncPending || this->m_events->avgPacketsWaiting() >= MAX_EVENT_CLIENT_PENDING)
+  {
+    return;
+  }
+  this->m_resyncPending = false;
+  this->pushEvent("resync", "{}");
+}
+
+/**
+ * @brief Push the events to the clients of /api/v1/events. Remote changes only contain the
+ * changed fields.
+ *
+ * @param event The event
+ */
+void WebServer::notified(const Event& event)
 {
-  // Not implemented yet. Not necessary.
+  if (this->m_events == nullptr || this->m_events->count() == 0)
+  {
+    return;
+  }
+  if (this->m_resyncPending || this->m_events->avgPacketsWaiting() >= MAX_EVENT_CLIENT_PENDING)
+  {
+    // Clients are behind, queuing more messages would only use the heap.
+    this->m_resyncPending = true;
+    return;
+  }
+
+  switch (event.type)
+  {
+  case EventType::REMOTE:
+    this->pushEvent("remote", this->m_serializer->serializeRemoteChange(event.remote));
+    break;
+  case EventType::COMMAND:
+    this->pushEvent("command", this->m_serializer->serializeCommand(event.command));
+    break;
+  }
 }
 
 // ============================================================================
@@ -109,17 +249,37 @@ void WebServer::handleFetchSystemInfos(AsyncWebServerRequest* request)
   LOG_INFO("Endpoint to fetch system informations reached.");
 
   WebServer* instance = WebServer::getInstance();
-  Result<SystemInfosExtended> result = instance->m_controller->fetchSystemInfos();
-
-  if (!result.isSuccess)
+  String etag = instance->getStateETag();
+  if (WebServer::handleNotModified(request, etag))
   {
-    request->send(400, "application/json", "{\"message\":\"" + result.errorMsg + "\"}");
     return;
   }
-  String serialized = instance->m_serializer->serializeSystemInfos(result.data);
+  WebServer::runApi(request, &RestApi::fetchSystemInfos, etag);
+}
+
+void WebServer::handleFetchSystemLoad(AsyncWebServerRequest* request)
+{
+  LOG_INFO("Endpoint to fetch the load of the server reached.");
+
+  // No ETag, the counters change without any change of the state.
+  WebServer* instance = WebServer::getInstance();
+  LoadStats stats = { instance->m_admission.getInFlight(), ESP.getFreeHeap(),
+    instance->m_admission.getShedByLimit(), instance->m_admission.getShedByHeap() };
+
+  String serialized = instance->m_serializer->serializeLoadStats(stats);
   request->send(200, "application/json", serialized);
 }
 
+void WebServer::handleFetchMetrics(AsyncWebServerRequest* request)
+{
+  LOG_INFO("Endpoint to fetch the metrics reached.");
+
+  // The whole text does not fit in RAM, it is written item by item.
+  WebServer::sendChunked(request, "text/plain; version=0.0.4",
+      ChunkedWriter([](Print& output, const uint8_t item) -> bool
+          { return WebServer::getInstance()->writeMetrics(output, item); }));
+}
+
 void WebServer::handleFetchWifiNetworks(AsyncWebServerRequest* request)
 {
   LOG_INFO("Endpoint to fetch Wifi Networks reached.");
@@ -132,15 +292,53 @@ void WebServer::handleFetchWifiNetworks(AsyncWebServerRequest* request)
     request->send(400, "application/json", "{\"message\":\"" + result.errorMsg + "\"}");
     return;
   }
-  String serialized = instance->m_serializer->serializeNetworks(result.data, MAX_NETWORK_SCAN);
+  AsyncResponseStream* response = request->beginResponseStream("application/json");
+  instance->m_serializer->serializeNetworks(*response, result.data, MAX_NETWORK_SCAN);
+  // The networks are those of the last scan, as a cache
+  Result<NetworkScan> scan = instance->m_controller->fetchNetworkScan();
+  response->addHeader("Age", String(scan.data.age));
+  request->send(response);
+}
+
+void WebServer::handleFetchWifiScan(AsyncWebServerRequest* request)
+{
+  LOG_INFO("Endpoint to fetch the Wifi scan reached.");
+
+  WebServer* instance = WebServer::getInstance();
+  Result<NetworkScan> result = instance->m_controller->fetchNetworkScan();
+
+  String serialized = instance->m_serializer->serializeNetworkScan(result.data);
   request->send(200, "application/json", serialized);
 }
 
+/**
+ * @brief Start a scan, answered at once. The networks are fetched once the scan is done.
+ *
+ */
+void WebServer::handleScanWifiNetworks(AsyncWebServerRequest* request)
+{
+  LOG_INFO("Endpoint to scan Wifi Networks reached.");
+
+  WebServer* instance = WebServer::getInstance();
+  Result<NetworkScan> result = instance->m_controller->scanNetworks();
+
+  String serialized = instance->m_serializer->serializeNetworkScan(result.data);
+  AsyncWebServerResponse* response = request->beginResponse(202, "application/json", serialized);
+  response->addHeader("Location", "/api/v1/wifi/scan");
+  request->send(response);
+}
+
 void WebServer::handleFetchWifiConfiguration(AsyncWebServerRequest* request)
 {
   LOG_INFO("Endpoint to fetch Network Configuration reached.");
 
   WebServer* instance = WebServer::getInstance();
+  String etag = instance->getStateETag();
+  if (WebServer::handleNotModified(request, etag))
+  {
+    return;
+  }
+
   Result<NetworkConfiguration> result = instance->m_controller->fetchNetworkConfiguration();
 
   if (!result.isSuccess)
@@ -149,7 +347,9 @@ void WebServer::handleFetchWifiConfiguration(AsyncWebServerRequest* request)
     return;
   }
   String serialized = instance->m_serializer->serializeNetworkConfig(result.data);
-  request->send(200, "application/json", serialized);
+  AsyncWebServerResponse* response = request->beginResponse(200, "application/json", serialized);
+  response->addHeader("ETag", etag);
+  request->send(response);
 }
 
 void WebServer::handleUpdateWifiConfiguration(AsyncWebServerRequest* request)
@@ -158,16 +358,8 @@ void WebServer::handleUpdateWifiConfiguration(AsyncWebServerRequest* request)
 
   String ssid;
   String password;
-  if (request->hasParam("ssid", true))
-  {
-    AsyncWebParameter* p = request->getParam("ssid", true);
-    ssid = p->value();
-  }
-  if (request->hasParam("password", true))
-  {
-    AsyncWebParameter* p = request->getParam("password", true);
-    password = p->value();
-  }
+  WebServer::getBodyParam(request, "ssid", ssid);
+  WebServer::getBodyParam(request, "password", password);
 
   WebServer* instance = WebServer::getInstance();
   Result<NetworkConfiguration> result
@@ -187,6 +379,12 @@ void WebServer::handleFetchMQTTConfiguration(AsyncWebServerRequest* request)
   LOG_INFO("Endpoint to fetch MQTT Configuration reached.");
 
   WebServer* instance = WebServer::getInstance();
+  String etag = instance->getStateETag();
+  if (WebServer::handleNotModified(request, etag))
+  {
+    return;
+  }
+
   Result<MQTTConfiguration> result = instance->m_controller->fetchMQTTConfiguration();
 
   if (!result.isSuccess)
@@ -195,7 +393,9 @@ void WebServer::handleFetchMQTTConfiguration(AsyncWebServerRequest* request)
     return;
   }
   String serialized = instance->m_serializer->serializeMQTTConfig(result.data);
-  request->send(200, "application/json", serialized);
+  AsyncWebServerResponse* response = request->beginResponse(200, "application/json", serialized);
+  response->addHeader("ETag", etag);
+  request->send(response);
 }
 
 void WebServer::handleUpdateMQTTConfiguration(AsyncWebServerRequest* request)
@@ -208,30 +408,17 @@ void WebServer::handleUpdateMQTTConfiguration(AsyncWebServerRequest* request)
   String username;
   String password;
 
-  if (request->hasParam("broker", true))
-  {
-    AsyncWebParameter* p = request->getParam("broker", true);
-    broker = p->value();
-  }
-  if (request->hasParam("username", true))
-  {
-    AsyncWebParameter* p = request->getParam("username", true);
-    username = p->value();
-  }
-  if (request->hasParam("password", true))
-  {
-    AsyncWebParameter* p = request->getParam("password", true);
-    password = p->value();
-  }
-  if (request->hasParam("port", true))
+  WebServer::getBodyParam(request, "broker", broker);
+  WebServer::getBodyParam(request, "username", username);
+  WebServer::getBodyParam(request, "password", password);
+  String value;
+  if (WebServer::getBodyParam(request, "port", value))
   {
-    AsyncWebParameter* p = request->getParam("port", true);
-    port = p->value().toInt();
+    port = value.toInt();
   }
-  if (request->hasParam("enabled", true))
+  if (WebServer::getBodyParam(request, "enabled", value))
   {
-    AsyncWebParameter* p = request->getParam("enabled", true);
-    if (p->value() == "true" || p->value() == "True")
+    if (value == "true" || value == "True")
     {
       enabled = true;
     }
@@ -255,131 +442,329 @@ void WebServer::handleFetchAllRemotes(AsyncWebServerRequest* request)
   LOG_INFO("Endpoint to fetch all remotes reached.");
 
   WebServer* instance = WebServer::getInstance();
-  Result<Remote[MAX_REMOTES]> result = instance->m_controller->fetchAllRemotes();
-
-  if (!result.isSuccess)
+  String etag = instance->getStateETag();
+  if (WebServer::handleNotModified(request, etag))
   {
-    request->send(400, "application/json", "{\"message\":\"" + result.errorMsg + "\"}");
     return;
   }
-  String serialized = instance->m_serializer->serializeRemotes(result.data, MAX_REMOTES);
-  request->send(200, "application/json", serialized);
+  WebServer::sendListing(request, instance->m_api.fetchAllRemotes(), etag);
 }
 
 void WebServer::handleFetchRemote(AsyncWebServerRequest* request)
 {
   LOG_INFO("Endpoint to fetch a remote reached.");
 
-  unsigned long remoteId = strtoul(request->pathArg(0).c_str(), nullptr, 10);
-
   WebServer* instance = WebServer::getInstance();
-  Result<Remote> result = instance->m_controller->fetchRemote(remoteId);
-
-  if (!result.isSuccess)
+  String etag = instance->getStateETag();
+  if (WebServer::handleNotModified(request, etag))
   {
-    request->send(400, "application/json", "{\"message\":\"" + result.errorMsg + "\"}");
     return;
   }
-  String serialized = instance->m_serializer->serializeRemote(result.data);
-  request->send(200, "application/json", serialized);
+  WebServer::runApi(request, &RestApi::fetchRemote, etag);
 }
 
 void WebServer::handleCreateRemote(AsyncWebServerRequest* request)
 {
   LOG_INFO("Endpoint to create a remote reached.");
 
-  String name;
-  if (request->hasParam("name", true))
+  WebServer::runApi(request, &RestApi::createRemote);
+}
+
+void WebServer::handleUpdateRemote(AsyncWebServerRequest* request)
+{
+  LOG_INFO("Endpoint to update a remote reached.");
+
+  WebServer::runApi(request, &RestApi::updateRemote);
+}
+
+void WebServer::handleDeleteRemote(AsyncWebServerRequest* request)
+{
+  LOG_INFO("Endpoint to delete a remote reached.");
+
+  WebServer::runApi(request, &RestApi::deleteRemote);
+}
+
+void WebServer::handleActionRemote(AsyncWebServerRequest* request)
+{
+  LOG_INFO("Endpoint to operate an action on a remote reached.");
+
+  // The key is a header of the REST API, a field of the body in a batch
+  if (request->hasHeader(IDEMPOTENCY_KEY_HEADER))
   {
-    AsyncWebParameter* p = request->getParam("name", true);
-    name = p->value();
+    WebServer::getBodyFields(request).set(
+        "idempotency_key", request->getHeader(IDEMPOTENCY_KEY_HEADER)->value());
   }
+  WebServer::runApi(request, &RestApi::actionRemote);
+}
 
-  WebServer* instance = WebServer::getInstance();
-  Result<Remote> result = instance->m_controller->createRemote(name.c_str());
+void WebServer::handleFetchCommand(AsyncWebServerRequest* request)
+{
+  LOG_INFO("Endpoint to fetch a command reached.");
 
-  if (!result.isSuccess)
+  WebServer::runApi(request, &RestApi::fetchCommand);
+}
+
+void WebServer::handleOperateBatch(AsyncWebServerRequest* request)
+{
+  LOG_INFO("Endpoint to operate a batch of actions reached.");
+
+  WebServer::runApi(request, &RestApi::operateBatch);
+}
+
+void WebServer::handleFetchAllScenes(AsyncWebServerRequest* request)
+{
+  LOG_INFO("Endpoint to fetch all scenes reached.");
+
+  WebServer* instance = WebServer::getInstance();
+  String etag = instance->getStateETag();
+  if (WebServer::handleNotModified(request, etag))
   {
-    request->send(400, "application/json", "{\"message\":\"" + result.errorMsg + "\"}");
     return;
   }
-  String serialized = instance->m_serializer->serializeRemote(result.data);
-  request->send(200, "application/json", serialized);
+  WebServer::sendListing(request, instance->m_api.fetchAllScenes(), etag);
 }
 
-void WebServer::handleUpdateRemote(AsyncWebServerRequest* request)
+void WebServer::handleCreateScene(AsyncWebServerRequest* request)
 {
-  LOG_INFO("Endpoint to update a remote reached.");
+  LOG_INFO("Endpoint to create a scene reached.");
 
-  unsigned long remoteId = strtoul(request->pathArg(0).c_str(), nullptr, 10);
+  WebServer::runApi(request, &RestApi::createScene);
+}
 
-  String name;
-  unsigned int rollingCode = 0;
+void WebServer::handleDeleteScene(AsyncWebServerRequest* request)
+{
+  LOG_INFO("Endpoint to delete a scene reached.");
 
-  if (request->hasParam("name", true))
-  {
-    AsyncWebParameter* p = request->getParam("name", true);
-    name = p->value();
-  }
+  WebServer::runApi(request, &RestApi::deleteScene);
+}
+
+void WebServer::handleFetchAllSchedules(AsyncWebServerRequest* request)
+{
+  LOG_INFO("Endpoint to fetch all schedules reached.");
 
-  if (request->hasParam("rolling_code", true))
+  WebServer* instance = WebServer::getInstance();
+  String etag = instance->getStateETag();
+  if (WebServer::handleNotModified(request, etag))
   {
-    AsyncWebParameter* p = request->getParam("rolling_code", true);
-    rollingCode = int(p->value().toInt());
+    return;
   }
+  WebServer::sendListing(request, instance->m_api.fetchAllSchedules(), etag);
+}
 
-  WebServer* instance = WebServer::getInstance();
-  Result<Remote> result = instance->m_controller->updateRemote(remoteId, name.c_str(), rollingCode);
+void WebServer::handleCreateSchedule(AsyncWebServerRequest* request)
+{
+  LOG_INFO("Endpoint to create a schedule reached.");
 
-  if (!result.isSuccess)
+  WebServer::runApi(request, &RestApi::createSchedule);
+}
+
+void WebServer::handleDeleteSchedule(AsyncWebServerRequest* request)
+{
+  LOG_INFO("Endpoint to delete a schedule reached.");
+
+  WebServer::runApi(request, &RestApi::deleteSchedule);
+}
+
+void WebServer::handleFetchLocation(AsyncWebServerRequest* request)
+{
+  LOG_INFO("Endpoint to fetch the location reached.");
+
+  WebServer* instance = WebServer::getInstance();
+  String etag = instance->getStateETag();
+  if (WebServer::handleNotModified(request, etag))
   {
-    request->send(400, "application/json", "{\"message\":\"" + result.errorMsg + "\"}");
     return;
   }
-  String serialized = instance->m_serializer->serializeRemote(result.data);
-  request->send(200, "application/json", serialized);
+  WebServer::runApi(request, &RestApi::fetchLocation, etag);
 }
 
-void WebServer::handleDeleteRemote(AsyncWebServerRequest* request)
+void WebServer::handleUpdateLocation(AsyncWebServerRequest* request)
 {
-  LOG_INFO("Endpoint to delete a remote reached.");
+  LOG_INFO("Endpoint to update the location reached.");
 
-  unsigned long remoteId = strtoul(request->pathArg(0).c_str(), nullptr, 10);
+  WebServer::runApi(request, &RestApi::updateLocation);
+}
 
-  WebServer* instance = WebServer::getInstance();
-  Result<Remote> result = instance->m_controller->deleteRemote(remoteId);
+void WebServer::handleBatch(AsyncWebServerRequest* request)
+{
+  LOG_INFO("Endpoint to run a batch of requests reached.");
 
-  if (!result.isSuccess)
+  const char* body = RouterHandler::getJsonBody(request);
+  if (body == nullptr)
   {
-    request->send(400, "application/json", "{\"message\":\"" + result.errorMsg + "\"}");
+    request->send(
+        400, "application/json", "{\"message\":\"An application/json body is expected.\"}");
     return;
   }
-  String serialized = instance->m_serializer->serializeRemote(result.data);
+
+  // Each sub-request runs as soon as it is read, as it would alone, and its response is written
+  // right away. A failure does not stop the next ones.
+  WebServer* instance = WebServer::getInstance();
+  AsyncResponseStream* response = request->beginResponseStream("application/json");
+  response->print('[');
+  int size = instance->m_serializer->deserializeBatchRequests(body, MAX_BATCH_REQUESTS,
+      [instance, response, first = true](const BatchRequest& subRequest) mutable
+      {
+        if (!first)
+        {
+          response->print(',');
+        }
+        first = false;
+
+        RouteMatch match;
+        RouteBatchHandler handler = instance->m_router->findBatchHandler(subRequest, match);
+        if (handler == nullptr)
+        {
+          instance->m_serializer->serializeBatchResponse(*response,
+              BatchResponse { 404,
+                instance->m_serializer->serializeMessage(
+                    "This request is not allowed in a batch.") });
+          return;
+        }
+        instance->m_serializer->serializeBatchResponse(
+            *response, (instance->m_api.*handler)(match, subRequest.body));
+      });
+  if (size < 0)
+  {
+    delete response; // Nothing was run nor written
+    request->send(400, "application/json",
+        "{\"message\":\"The requests are malformed, or more than " + String(MAX_BATCH_REQUESTS)
+            + ".\"}");
+    return;
+  }
+  response->print(']');
+  request->send(response);
+}
+
+void WebServer::handleFetchOta(AsyncWebServerRequest* request)
+{
+  LOG_INFO("Endpoint to fetch the update progress reached.");
+
+  WebServer* instance = WebServer::getInstance();
+  String serialized = instance->m_serializer->serializeUpdateProgress(
+      instance->m_updater->getProgress());
   request->send(200, "application/json", serialized);
 }
 
-void WebServer::handleActionRemote(AsyncWebServerRequest* request)
+/**
+ * @brief Called for each chunk of the uploaded image, written straight into the partition.
+ *
+ */
+void WebServer::handleOtaUpload(AsyncWebServerRequest* request, const String& filename,
+    size_t index, uint8_t* data, size_t length, bool final)
 {
-  LOG_INFO("Endpoint to operate an action on a remote reached.");
+  WebServer* instance = WebServer::getInstance();
+  OtaUpdater* updater = instance->m_updater;
+
+  if (index == 0)
+  {
+    LOG_INFO("Endpoint to update the firmware reached:", filename);
+    if (!request->authenticate(instance->m_otaCredentials.c_str()))
+    {
+      return; // Nothing is written, answered by handleOtaDone
+    }
+    if (updater->getProgress().state == UpdateState::RUNNING
+        && millis() - instance->m_otaLastChunk >= OTA_IDLE_TIMEOUT_MS)
+    {
+      updater->abort(); // Its client is gone
+    }
+
+    UpdateTarget target = UpdateTarget::FIRMWARE;
+    if (request->hasParam("target") && request->getParam("target")->value() == "filesystem")
+    {
+      target = UpdateTarget::FILESYSTEM;
+    }
+    String sha256;
+    if (request->hasParam("sha256"))
+    {
+      sha256 = request->getParam("sha256")->value();
+    }
 
-  unsigned long remoteId = strtoul(request->pathArg(0).c_str(), nullptr, 10);
+    Result<UpdateProgress> result
+        = updater->begin(target, sha256.c_str(), request->contentLength());
+    if (!result.isSuccess)
+    {
+      return;
+    }
+    instance->m_otaRequest = request;
+    instance->m_otaReportedStep = 0;
+  }
+  if (request != instance->m_otaRequest)
+  {
+    return; // Another update is running
+  }
+  instance->m_otaLastChunk = millis();
 
-  String action;
-  if (request->hasParam("action", true))
+  Result<UpdateProgress> result = updater->write(data, length);
+  if (result.isSuccess && final)
   {
-    AsyncWebParameter* p = request->getParam("action", true);
-    action = p->value();
+    result = updater->end();
   }
 
+  // Pushed every 10%, and once done or failed
+  const uint8_t step = result.data.written * 10 / result.data.total;
+  if (step > instance->m_otaReportedStep || result.data.state != UpdateState::RUNNING)
+  {
+    instance->m_otaReportedStep = step;
+    if (instance->m_events != nullptr && instance->m_events->count() > 0)
+    {
+      instance->pushEvent("ota", instance->m_serializer->serializeUpdateProgress(result.data));
+    }
+  }
+}
+
+/**
+ * @brief Called once the upload is complete. A written update is installed by a restart.
+ *
+ */
+void WebServer::handleOtaDone(AsyncWebServerRequest* request)
+{
   WebServer* instance = WebServer::getInstance();
-  Result<String> result = instance->m_controller->operateRemote(remoteId, action.c_str());
+  if (!request->authenticate(instance->m_otaCredentials.c_str()))
+  {
+    request->requestAuthentication(OTA_REALM);
+    return;
+  }
+  if (request != instance->m_otaRequest)
+  {
+    const String message = instance->m_updater->getProgress().state == UpdateState::RUNNING
+        ? "Another update is running."
+        : instance->m_updater->getError();
+    request->send(instance->m_otaRequest == nullptr ? 400 : 409, "application/json",
+        instance->m_serializer->serializeMessage(
+            message.length() > 0 ? message.c_str() : "No image uploaded."));
+    return;
+  }
+  instance->m_otaRequest = nullptr;
 
-  if (!result.isSuccess)
+  const UpdateProgress& progress = instance->m_updater->getProgress();
+  if (progress.state != UpdateState::DONE)
   {
-    request->send(400, "application/json", "{\"message\":\"" + result.errorMsg + "\"}");
+    instance->m_updater->abort(); // The upload ended before its last chunk
+    request->send(400, "application/json",
+        instance->m_serializer->serializeMessage(instance->m_updater->getError().c_str()));
     return;
   }
-  request->send(200, "application/json", "{\"message\":\"" + result.data + "\"}");
+  request->send(
+      200, "application/json", instance->m_serializer->serializeUpdateProgress(progress));
+  instance->m_controller->askSystemRestart();
+}
+
+void WebServer::handleEventsConnect(AsyncEventSourceClient* client)
+{
+  LOG_INFO("Client connected to the events.");
+  WebServer* instance = WebServer::getInstance();
+  if (instance->m_events->count() > MAX_EVENT_CLIENTS)
+  {
+    LOG_WARN("Too many clients listening to the events.");
+    client->close();
+    return;
+  }
+  if (client->lastId() != 0 && client->lastId() != instance->m_lastEventId)
+  {
+    // Reconnection after missed events
+    client->send("{}", "resync", instance->m_lastEventId);
+  }
 }
 
 void WebServer::handleHTMLHomePage(AsyncWebServerRequest* request)
@@ -393,5 +778,188 @@ void WebServer::handleHTMLNotFoundPage(AsyncWebServerRequest* request)
 {
   LOG_INFO("HTML 404 Not Found reached.");
 
+#ifdef EMBED_ASSETS
+  request->send(404, "text/plain", "Not found");
+#else
   request->send(LittleFS, "/404.html", String());
-}
\ No newline at end of file
+#endif
+}
+
+// PRIVATE
+
+/**
+ * @brief Read a param of the body, a form param or a field of an application/json body.
+ *
+ * @param request The request
+ * @param name The name of the param
+ * @param value Set to the value of the param
+ * @return true if the param is present.
+ */
+bool WebServer::getBodyParam(AsyncWebServerRequest* request, const char* name, String& value)
+{
+  return WebServer::getBodyFields(request).get(name, value);
+}
+
+/**
+ * @brief The params of the body, read once per request: the fields of an application/json body,
+ * then the form params, which replace the fields of the same name. Only valid in a route handler.
+ *
+ * @param request The request
+ * @return The params, kept by the router until the handler returns.
+ */
+BodyFields& WebServer::getBodyFields(AsyncWebServerRequest* request)
+{
+  RouteContext* context = RouterHandler::getContext(request);
+  if (!context->parsed)
+  {
+    context->parsed = true;
+    if (context->body != nullptr)
+    {
+      WebServer::getInstance()->m_serializer->deserializeFields(context->body, context->fields);
+    }
+    for (size_t i = 0; i < request->params(); i++)
+    {
+      const AsyncWebParameter* param = request->getParam(i);
+      if (param->isPost() && !param->isFile())
+      {
+        context->fields.set(param->name().c_str(), param->value());
+      }
+    }
+  }
+  return context->fields;
+}
+
+/**
+ * @brief Run a route of the REST API and send its response.
+ *
+ * @param request The request
+ * @param handler The route
+ * @param etag The ETag of the state, added to a 200. None if empty.
+ */
+void WebServer::runApi(AsyncWebServerRequest* request, ApiHandler handler, const String& etag)
+{
+  WebServer* instance = WebServer::getInstance();
+  const BatchResponse result = (instance->m_api.*handler)(
+      RouterHandler::getContext(request)->match, WebServer::getBodyFields(request));
+
+  AsyncWebServerResponse* response
+      = request->beginResponse(result.status, "application/json", result.body);
+  if (etag.length() > 0 && result.status == 200)
+  {
+    response->addHeader("ETag", etag);
+  }
+  if (result.location.length() > 0)
+  {
+    response->addHeader("Location", result.location);
+  }
+  request->send(response);
+}
+
+/**
+ * @brief Send a listing of the REST API in chunks, or its error.
+ *
+ * @param request The request
+ * @param result The writer of the listing
+ * @param etag The ETag of the state
+ */
+void WebServer::sendListing(
+    AsyncWebServerRequest* request, const Result<ChunkedWriter>& result, const String& etag)
+{
+  if (!result.isSuccess)
+  {
+    request->send(400, "application/json",
+        WebServer::getInstance()->m_serializer->serializeMessage(result.errorMsg.c_str()));
+    return;
+  }
+  WebServer::sendChunked(request, "application/json", result.data, etag);
+}
+
+/**
+ * @brief Write an item of the metrics: the registry first, then the load of the server and the
+ * durations of each route.
+ *
+ * @param output The output
+ * @param item The index of the item
+ * @return false past the last item.
+ */
+bool WebServer::writeMetrics(Print& output, const uint8_t item)
+{
+  if (item < Metrics::ITEMS)
+  {
+    Metrics::write(output, item);
+    return true;
+  }
+  if (item == Metrics::ITEMS)
+  {
+    Metrics::writeGauge(output, "esprtsomfy_free_heap_bytes", ESP.getFreeHeap());
+    Metrics::writeGauge(
+        output, "esprtsomfy_http_requests_in_flight", this->m_admission.getInFlight());
+    Metrics::writeCounter(
+        output, "esprtsomfy_http_shed_limit_total", this->m_admission.getShedByLimit());
+    Metrics::writeCounter(
+        output, "esprtsomfy_http_shed_heap_total", this->m_admission.getShedByHeap());
+    return true;
+  }
+  return this->m_router->writeMetrics(output, item - Metrics::ITEMS - 1);
+}
+
+/**
+ * @brief Send a body written item by item in chunks. Only the item being sent is held in RAM.
+ *
+ * @param request The request to answer
+ * @param contentType The type of the body
+ * @param writer The body
+ * @param etag The ETag of the body, none if empty
+ */
+void WebServer::sendChunked(AsyncWebServerRequest* request, const char* contentType,
+    ChunkedWriter writer, const String& etag)
+{
+  AsyncWebServerResponse* response = request->beginChunkedResponse(contentType,
+      [writer](uint8_t* buffer, size_t maxLen, size_t index) mutable -> size_t
+      {
+        return writer.fill(buffer, maxLen); // An empty chunk ends the response
+      });
+  if (etag.length() > 0)
+  {
+    response->addHeader("ETag", etag);
+  }
+  request->send(response);
+}
+
+/**
+ * @brief The ETag of the current state. The version restarts from 0 at each boot, the boot id
+ * keeps the ETags of the previous boots from matching.
+ *
+ * @return The quoted ETag, ie: "5f3a9c1e-42"
+ */
+String WebServer::getStateETag()
+{
+  return "\"" + String(this->m_bootId, HEX) + "-" + String(this->m_controller->getStateVersion())
+      + "\"";
+}
+
+/**
+ * @brief Answer 304 Not Modified if the client already has this version. Must be called before
+ * reading the database, so an idle poll costs neither EEPROM reads nor serialization.
+ *
+ * @param request The request
+ * @param etag The ETag of the current state
+ * @return true if the response has been sent.
+ */
+bool WebServer::handleNotModified(AsyncWebServerRequest* request, const String& etag)
+{
+  if (!request->hasHeader(IF_NONE_MATCH_HEADER) || request->header(IF_NONE_MATCH_HEADER) != etag)
+  {
+    return false;
+  }
+  AsyncWebServerResponse* response = request->beginResponse(304);
+  response->addHeader("ETag", etag);
+  request->send(response);
+  return true;
+}
+
+void WebServer::pushEvent(const char* name, const String& data)
+{
+  ++this->m_lastEventId;
+  this->m_events->send(data.c_str(), name, this->m_lastEventId);
+}
@@ -105,7 +105,7 @@ String NetworkWifiClient::getMacAddress() { return WiFi.macAddress(); }
 bool NetworkWifiClient::isConnected() { return (WiFi.status() == WL_CONNECTED); }
 
 /**
- * @brief Scan networks
+ * @brief Scan networks, blocking. Only before the connection, it is dropped.
  *
  */
 void NetworkWifiClient::scanNetworks()
@@ -114,25 +114,67 @@ void NetworkWifiClient::scanNetworks()
   WiFi.disconnect();
   delay(100);
 
-  int count = WiFi.scanNetworks(false);
-  if (count == 0)
+  this->storeNetworks(WiFi.scanNetworks(false));
+}
+
+/**
+ * @brief Start a scan in the background. A scan already running is shared, it is not restarted.
+ * The connection to the current network is kept, only the channels are visited in between.
+ *
+ * @return NetworkScan
+ */
+NetworkScan NetworkWifiClient::startScan()
+{
+  if (!this->m_scanning)
   {
-    LOG_WARN("No Wifi Networks detected.");
+    LOG_INFO("Scanning the wifi networks in the background...");
+    WiFi.scanNetworks(true);
+    this->m_scanning = true;
   }
-  else
+  return this->getScan();
+}
+
+/**
+ * @brief Collect the networks of the scan once it is done. Called from the main loop.
+ *
+ * @return true, if new networks are available
+ * @return false, otherwise
+ */
+bool NetworkWifiClient::handleScan()
+{
+  if (!this->m_scanning)
+  {
+    return false;
+  }
+  int count = WiFi.scanComplete();
+  if (count == WIFI_SCAN_RUNNING)
   {
-    for (int i = 0; i < count && i < MAX_NETWORK_SCAN; ++i)
-    {
-      // Get SSID and RSSI for each network found
-      strcpy(this->m_networks[i].SSID, WiFi.SSID(i).c_str());
-      this->m_networks[i].RSSI = WiFi.RSSI(i); // Signal strength in dBm
-    }
-    for (int i = count; i < MAX_NETWORK_SCAN; ++i)
-    {
-      strcpy(this->m_networks[i].SSID, "");
-      this->m_networks[i].RSSI = -255;
-    }
+    return false;
   }
+
+  this->m_scanning = false;
+  if (count < 0)
+  {
+    LOG_ERROR("The wifi scan failed. The previous networks are kept.");
+    return false;
+  }
+  this->storeNetworks(count);
+  return true;
+}
+
+/**
+ * @brief Get the state of the scan
+ *
+ * @return NetworkScan
+ */
+NetworkScan NetworkWifiClient::getScan()
+{
+  NetworkScan scan;
+  scan.scanning = this->m_scanning;
+  scan.scanned = this->m_scanned;
+  scan.age = this->m_scanned ? (millis() - this->m_scannedAt) / 1000 : 0;
+  scan.count = this->m_count;
+  return scan;
 }
 
 /**
@@ -148,3 +190,31 @@ void NetworkWifiClient::getNetworks(Network networks[])
     strcpy(networks[i].SSID, this->m_networks[i].SSID);
   }
 }
+
+// PRIVATE
+
+void NetworkWifiClient::storeNetworks(const int count)
+{
+  if (count <= 0)
+  {
+    LOG_WARN("No Wifi Networks detected.");
+  }
+  this->m_count = 0;
+  for (int i = 0; i < count && i < MAX_NETWORK_SCAN; ++i)
+  {
+    // Get SSID and RSSI for each network found
+    strncpy(this->m_networks[i].SSID, WiFi.SSID(i).c_str(), sizeof(this->m_networks[i].SSID) - 1);
+    this->m_networks[i].SSID[sizeof(this->m_networks[i].SSID) - 1] = '\0';
+    this->m_networks[i].RSSI = WiFi.RSSI(i); // Signal strength in dBm
+    ++this->m_count;
+  }
+  for (int i = this->m_count; i < MAX_NETWORK_SCAN; ++i)
+  {
+    strcpy(this->m_networks[i].SSID, "");
+    this->m_networks[i].RSSI = -255;
+  }
+  WiFi.scanDelete(); // Copied, the results of the SDK are freed
+
+  this->m_scanned = true;
+  this->m_scannedAt = millis();
+}
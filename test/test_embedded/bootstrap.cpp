@@ -5,6 +5,17 @@
 #include "./test_eepromDatabase.h"
 #include "./test_RTSTransmitter.h"
 #include "./test_controller.h"
+#include "./test_scheduler.h"
+#include "./test_eventBus.h"
+#include "./test_router.h"
+#include "./test_admissionControl.h"
+#include "./test_metrics.h"
+#include "./test_otaUpdater.h"
+#include "./test_mqttTopic.h"
+#include "./test_reconnectBackoff.h"
+#include "./test_mqttOutbox.h"
+#include "./test_homeAssistant.h"
+#include "./test_mqttClient.h"
 
 void setUp(void)
 {
@@ -22,11 +33,21 @@ void tearDown(void)
   FakeDatabase::shouldFailCreateRemote = false;
   FakeDatabase::shouldFailUpdateNetworkConfiguration = false;
   FakeDatabase::shouldFailUpdateMQTTConfiguration = false;
+  FakeDatabase::shouldFailCreateScene = false;
+  FakeDatabase::shouldReturnEmptyScene = false;
+  FakeDatabase::shouldFailCreateSchedule = false;
+  FakeDatabase::shouldReturnEmptySchedule = false;
+  FakeDatabase::shouldFailUpdateLocation = false;
 
   FakeTransmitter::sendUPCommandCalled = false;
   FakeTransmitter::sendSTOPCommandCalled = false;
   FakeTransmitter::sendDOWNCommandCalled = false;
   FakeTransmitter::sendPROGCommandCalled = false;
+
+  FakeNetworkClient::scanning = false;
+  FakeNetworkClient::scanDone = false;
+
+  Metrics::reset();
 }
 
 void RUN_UNITY_TESTS()
@@ -38,6 +59,28 @@ void RUN_UNITY_TESTS()
   RUN_EEPROMDATABASE_TESTS();
   // Controller tests
   RUN_CONTROLLER_TESTS();
+  // Scheduler tests
+  RUN_SCHEDULER_TESTS();
+  // EventBus tests
+  RUN_EVENTBUS_TESTS();
+  // Router tests
+  RUN_ROUTER_TESTS();
+  // AdmissionControl tests
+  RUN_ADMISSIONCONTROL_TESTS();
+  // Metrics tests
+  RUN_METRICS_TESTS();
+  // OtaUpdater tests
+  RUN_OTAUPDATER_TESTS();
+  // MQTT topic tests
+  RUN_MQTTTOPIC_TESTS();
+  // Reconnect backoff tests
+  RUN_RECONNECTBACKOFF_TESTS();
+  // MQTT outbox tests
+  RUN_MQTTOUTBOX_TESTS();
+  // Home Assistant tests
+  RUN_HOMEASSISTANT_TESTS();
+  // MQTT client tests
+  RUN_MQTTCLIENT_TESTS();
   // RTS Transmitter tests
   RUN_RTSTRANSMITTER_TESTS();
   UNITY_END();
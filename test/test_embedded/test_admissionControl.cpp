@@ -0,0 +1,78 @@
+#include <unity.h>
+#include <Arduino.h>
+
+#include <admissionControl.h>
+#include "./test_admissionControl.h"
+
+const uint32_t TEST_ENOUGH_HEAP = 20000;
+
+// TEST ADMISSION CONTROL
+// ############################################################################
+
+void RUN_ADMISSIONCONTROL_TESTS(void)
+{
+  RUN_TEST(test_METHOD_admit_WITH_free_slot_SHOULD_admit_until_limit);
+  RUN_TEST(test_METHOD_admit_WITH_full_slots_SHOULD_keep_reserved_slots_for_commands);
+  RUN_TEST(test_METHOD_admit_WITH_low_heap_SHOULD_shed_normal_before_commands);
+  RUN_TEST(test_METHOD_release_WITH_admitted_request_SHOULD_free_slot);
+}
+
+void test_METHOD_admit_WITH_free_slot_SHOULD_admit_until_limit(void)
+{
+  AdmissionControl admission(2, 0, 8000, 4000);
+
+  TEST_ASSERT_TRUE(
+      admission.admit(RequestPriority::NORMAL, TEST_ENOUGH_HEAP) == Admission::ADMITTED);
+  TEST_ASSERT_TRUE(
+      admission.admit(RequestPriority::NORMAL, TEST_ENOUGH_HEAP) == Admission::ADMITTED);
+  TEST_ASSERT_TRUE(
+      admission.admit(RequestPriority::NORMAL, TEST_ENOUGH_HEAP) == Admission::SHED_LIMIT);
+  TEST_ASSERT_EQUAL(2, admission.getInFlight());
+  TEST_ASSERT_EQUAL(1, admission.getShedByLimit());
+  TEST_ASSERT_EQUAL(0, admission.getShedByHeap());
+}
+
+void test_METHOD_admit_WITH_full_slots_SHOULD_keep_reserved_slots_for_commands(void)
+{
+  AdmissionControl admission(1, 1, 8000, 4000);
+
+  admission.admit(RequestPriority::NORMAL, TEST_ENOUGH_HEAP);
+
+  TEST_ASSERT_TRUE(
+      admission.admit(RequestPriority::NORMAL, TEST_ENOUGH_HEAP) == Admission::SHED_LIMIT);
+  TEST_ASSERT_TRUE(
+      admission.admit(RequestPriority::COMMAND, TEST_ENOUGH_HEAP) == Admission::ADMITTED);
+  TEST_ASSERT_TRUE(
+      admission.admit(RequestPriority::COMMAND, TEST_ENOUGH_HEAP) == Admission::SHED_LIMIT);
+  TEST_ASSERT_EQUAL(2, admission.getInFlight());
+  TEST_ASSERT_EQUAL(2, admission.getShedByLimit());
+}
+
+void test_METHOD_admit_WITH_low_heap_SHOULD_shed_normal_before_commands(void)
+{
+  AdmissionControl admission(4, 0, 8000, 4000);
+
+  TEST_ASSERT_TRUE(admission.admit(RequestPriority::NORMAL, 6000) == Admission::SHED_HEAP);
+  TEST_ASSERT_TRUE(admission.admit(RequestPriority::COMMAND, 6000) == Admission::ADMITTED);
+  TEST_ASSERT_TRUE(admission.admit(RequestPriority::COMMAND, 2000) == Admission::SHED_HEAP);
+  TEST_ASSERT_EQUAL(1, admission.getInFlight());
+  TEST_ASSERT_EQUAL(2, admission.getShedByHeap());
+  TEST_ASSERT_EQUAL(0, admission.getShedByLimit());
+}
+
+void test_METHOD_release_WITH_admitted_request_SHOULD_free_slot(void)
+{
+  AdmissionControl admission(1, 0, 8000, 4000);
+
+  admission.admit(RequestPriority::NORMAL, TEST_ENOUGH_HEAP);
+  admission.release();
+
+  TEST_ASSERT_EQUAL(0, admission.getInFlight());
+  TEST_ASSERT_TRUE(
+      admission.admit(RequestPriority::NORMAL, TEST_ENOUGH_HEAP) == Admission::ADMITTED);
+
+  admission.release();
+  admission.release(); // Never below zero
+
+  TEST_ASSERT_EQUAL(0, admission.getInFlight());
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <admissionControl.h>
+
+void RUN_ADMISSIONCONTROL_TESTS(void);
+
+void test_METHOD_admit_WITH_free_slot_SHOULD_admit_until_limit(void);
+void test_METHOD_admit_WITH_full_slots_SHOULD_keep_reserved_slots_for_commands(void);
+void test_METHOD_admit_WITH_low_heap_SHOULD_shed_normal_before_commands(void);
+void test_METHOD_release_WITH_admitted_request_SHOULD_free_slot(void);
@@ -4,10 +4,14 @@
 
 #include <remote.h>
 #include <result.h>
+#include <event.h>
+#include <command.h>
 #include <networks.h>
 #include <systemInfos.h>
 #include <controller.h>
+#include <remoteAction.h>
 #include "./test_controller.h"
+#include "./test_eventBus.h"
 
 // Fake SystemManager
 bool FakeSystemManager::requestRestartCalled = false;
@@ -22,6 +26,13 @@ bool FakeDatabase::shouldReturnEmptyRemote = false;
 bool FakeDatabase::shouldFailCreateRemote = false;
 bool FakeDatabase::shouldFailUpdateNetworkConfiguration = false;
 bool FakeDatabase::shouldFailUpdateMQTTConfiguration = false;
+bool FakeDatabase::shouldFailCreateScene = false;
+bool FakeDatabase::shouldReturnEmptyScene = false;
+bool FakeDatabase::shouldFailCreateSchedule = false;
+bool FakeDatabase::shouldReturnEmptySchedule = false;
+bool FakeDatabase::shouldFailUpdateLocation = false;
+// Deduplication is only enabled by the tests covering it
+unsigned short FakeDatabase::remoteDedupWindow = 0;
 
 void FakeDatabase::init() { }
 
@@ -62,7 +73,16 @@ Remote FakeDatabase::createRemote(const char* name)
   return remote;
 }
 
-void FakeDatabase::getAllRemotes(Remote remotes[]) { }
+void FakeDatabase::getAllRemotes(Remote remotes[])
+{
+  for (unsigned short i = 0; i < MAX_REMOTES; ++i)
+  {
+    remotes[i] = Remote { 0, 0, "" };
+  }
+  remotes[0] = Remote { 1, 42, "foo" };
+  remotes[0].dedupWindow = this->remoteDedupWindow;
+  remotes[1] = Remote { 2, 7, "bar" };
+}
 
 Remote FakeDatabase::getRemote(const unsigned long& id)
 {
@@ -74,6 +94,7 @@ Remote FakeDatabase::getRemote(const unsigned long& id)
   remote.id = 1;
   remote.rollingCode = 42;
   strcpy(remote.name, "foo");
+  remote.dedupWindow = this->remoteDedupWindow;
   return remote;
 }
 
@@ -95,6 +116,75 @@ bool FakeDatabase::deleteRemote(const unsigned long& id)
   return true;
 }
 
+Scene FakeDatabase::createScene(const Scene& scene)
+{
+  Scene created = scene;
+  created.id = this->shouldFailCreateScene ? 0 : 1;
+  return created;
+}
+
+void FakeDatabase::getAllScenes(Scene scenes[]) { }
+
+Scene FakeDatabase::getScene(const unsigned short& id)
+{
+  Scene scene = { 0, "", 0, {} };
+  if (this->shouldReturnEmptyScene)
+  {
+    return scene;
+  }
+  scene.id = 1;
+  strcpy(scene.name, "south");
+  scene.size = 2;
+  scene.operations[0] = RemoteOperation { 1, RemoteAction::DOWN };
+  scene.operations[1] = RemoteOperation { 2, RemoteAction::DOWN };
+  return scene;
+}
+
+bool FakeDatabase::deleteScene(const unsigned short& id) { return true; }
+
+Schedule FakeDatabase::createSchedule(const Schedule& schedule)
+{
+  Schedule created = schedule;
+  created.id = this->shouldFailCreateSchedule ? 0 : 1;
+  return created;
+}
+
+void FakeDatabase::getAllSchedules(Schedule schedules[])
+{
+  for (unsigned short i = 0; i < MAX_SCHEDULES; ++i)
+  {
+    schedules[i] = Schedule { 0, 0, RemoteAction::UNKNOWN, ScheduleTrigger::UNKNOWN, 0, "" };
+  }
+  schedules[0] = Schedule { 1, 1, RemoteAction::DOWN, ScheduleTrigger::TIME, 0, "0 8 * * *" };
+}
+
+Schedule FakeDatabase::getSchedule(const unsigned short& id)
+{
+  Schedule schedule = { 0, 0, RemoteAction::UNKNOWN, ScheduleTrigger::UNKNOWN, 0, "" };
+  if (this->shouldReturnEmptySchedule)
+  {
+    return schedule;
+  }
+  return Schedule { 1, 1, RemoteAction::DOWN, ScheduleTrigger::TIME, 0, "0 8 * * *" };
+}
+
+bool FakeDatabase::deleteSchedule(const unsigned short& id) { return true; }
+
+Location FakeDatabase::getLocation()
+{
+  Location location = { 48.85f, 2.35f, "UTC0" };
+  return location;
+}
+
+bool FakeDatabase::setLocation(const Location& location)
+{
+  if (this->shouldFailUpdateLocation)
+  {
+    return false;
+  }
+  return true;
+}
+
 MQTTConfiguration FakeDatabase::getMQTTConfiguration()
 {
   MQTTConfiguration conf = { true, "foo.foo", 1234, "foo", "bar" };
@@ -146,6 +236,29 @@ bool FakeNetworkClient::isConnected() { return true; };
 void FakeNetworkClient::getNetworks(Network networks[]) {};
 void FakeNetworkClient::scanNetworks() {};
 
+bool FakeNetworkClient::scanning = false;
+bool FakeNetworkClient::scanDone = false;
+
+NetworkScan FakeNetworkClient::startScan()
+{
+  FakeNetworkClient::scanning = true;
+  return this->getScan();
+}
+
+bool FakeNetworkClient::handleScan()
+{
+  if (FakeNetworkClient::scanDone)
+  {
+    FakeNetworkClient::scanning = false;
+  }
+  return FakeNetworkClient::scanDone;
+}
+
+NetworkScan FakeNetworkClient::getScan()
+{
+  return NetworkScan { FakeNetworkClient::scanning, true, 12, 3 };
+}
+
 // TEST CONTROLLER
 // ############################################################################
 
@@ -165,6 +278,7 @@ void RUN_CONTROLLER_TESTS(void)
   RUN_TEST(
       test_METHOD_fetchRemote_WITH_remote_not_found_SHOULD_return_result_WITH_success_to_false);
   RUN_TEST(test_METHOD_fetchRemote_SHOULD_return_result_WITH_success_to_true);
+  RUN_TEST(test_METHOD_fetchAllRemotes_SHOULD_return_every_field_of_the_remotes);
   RUN_TEST(test_METHOD_createRemote_WITH_null_name_SHOULD_return_result_WITH_success_to_false);
   RUN_TEST(test_METHOD_createRemote_WITH_empty_name_SHOULD_return_result_WITH_success_to_false);
   RUN_TEST(test_METHOD_createRemote_WITH_name_too_long_SHOULD_return_result_WITH_success_to_false);
@@ -188,6 +302,9 @@ void RUN_CONTROLLER_TESTS(void)
       test_METHOD_updateRemote_WITH_valid_remote_AND_rolling_code_provided_SHOULD_return_result_WITH_success_to_true);
   RUN_TEST(
       test_METHOD_updateRemote_WITH_valid_remote_AND_valid_data_AND_database_fail_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(test_METHOD_updateRemote_WITH_dedup_window_SHOULD_store_it_AND_publish_the_change);
+  RUN_TEST(
+      test_METHOD_updateRemote_WITH_dedup_window_out_of_range_SHOULD_return_result_WITH_success_to_false);
   RUN_TEST(
       test_METHOD_operateRemote_WITH_empty_remote_id_SHOULD_return_result_WITH_success_to_false);
   RUN_TEST(test_METHOD_operateRemote_WITH_null_action_SHOULD_return_result_WITH_success_to_false);
@@ -206,6 +323,68 @@ void RUN_CONTROLLER_TESTS(void)
       test_METHOD_operateRemote_WITH_valide_remote_AND_pair_action_SHOULD_return_result_WITH_success_to_true);
   RUN_TEST(
       test_METHOD_operateRemote_WITH_valide_remote_AND_reset_action_SHOULD_return_result_WITH_success_to_true);
+  RUN_TEST(
+      test_METHOD_operateRemote_WITH_unknown_remote_action_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(
+      test_METHOD_operateRemote_WITH_valide_remote_AND_down_remote_action_SHOULD_return_result_WITH_success_to_true);
+  RUN_TEST(test_METHOD_operateRemote_SHOULD_publish_one_change_WITH_last_action_AND_rolling_code);
+  RUN_TEST(test_METHOD_parseRemoteAction_WITH_valid_names_SHOULD_return_remote_actions);
+  RUN_TEST(test_METHOD_parseRemoteAction_WITH_invalid_names_SHOULD_return_unknown);
+  RUN_TEST(test_METHOD_parseRemoteOperations_WITH_valid_list_SHOULD_return_operations);
+  RUN_TEST(test_METHOD_parseRemoteOperations_WITH_malformed_list_SHOULD_return_error);
+  RUN_TEST(test_METHOD_operateBatch_WITH_no_operation_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(
+      test_METHOD_operateBatch_WITH_unknown_remote_SHOULD_return_result_WITH_success_to_false_AND_queue_nothing);
+  RUN_TEST(test_METHOD_operateBatch_WITH_valid_operations_SHOULD_queue_one_command_per_operation);
+  RUN_TEST(test_METHOD_operateBatch_WITH_queue_too_small_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(
+      test_METHOD_submitCommand_WITH_not_found_remote_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(
+      test_METHOD_submitCommand_WITH_valid_remote_SHOULD_return_pending_command_AND_send_nothing);
+  RUN_TEST(
+      test_METHOD_submitCommand_WITH_too_many_pending_commands_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(test_METHOD_handleCommands_WITH_pending_command_SHOULD_send_it_AND_mark_it_done);
+  RUN_TEST(test_METHOD_handleCommands_WITH_database_fail_SHOULD_mark_command_failed);
+  RUN_TEST(
+      test_METHOD_handleCommands_WITH_remote_deleted_since_submission_SHOULD_fail_without_sending);
+  RUN_TEST(
+      test_METHOD_fetchCommand_WITH_unknown_request_id_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(
+      test_METHOD_submitCommand_WITH_same_command_in_dedup_window_SHOULD_return_previous_command);
+  RUN_TEST(test_METHOD_submitCommand_WITH_other_action_in_dedup_window_SHOULD_return_new_command);
+  RUN_TEST(test_METHOD_submitCommand_WITH_same_idempotency_key_SHOULD_return_previous_command);
+  RUN_TEST(
+      test_METHOD_submitCommand_WITH_idempotency_key_of_another_command_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(test_METHOD_createScene_WITH_empty_name_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(
+      test_METHOD_createScene_WITH_invalid_operation_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(test_METHOD_createScene_WITH_database_fail_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(test_METHOD_createScene_SHOULD_return_result_WITH_success_to_true);
+  RUN_TEST(
+      test_METHOD_deleteScene_WITH_not_found_scene_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(
+      test_METHOD_operateScene_WITH_not_found_scene_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(test_METHOD_operateScene_SHOULD_queue_the_operations_of_the_scene);
+  RUN_TEST(test_METHOD_createSchedule_WITH_invalid_cron_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(
+      test_METHOD_createSchedule_WITH_offset_out_of_range_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(
+      test_METHOD_createSchedule_WITH_not_found_remote_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(
+      test_METHOD_createSchedule_WITH_database_fail_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(
+      test_METHOD_createSchedule_SHOULD_return_result_WITH_success_to_true_AND_change_revision);
+  RUN_TEST(
+      test_METHOD_deleteSchedule_WITH_not_found_schedule_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(
+      test_METHOD_updateLocation_WITH_invalid_latitude_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(
+      test_METHOD_updateLocation_WITH_empty_timezone_SHOULD_return_result_WITH_success_to_false);
+  RUN_TEST(test_METHOD_updateLocation_SHOULD_return_result_WITH_success_to_true);
+  RUN_TEST(test_METHOD_getStateVersion_WITH_fetch_OR_failed_update_SHOULD_not_change);
+  RUN_TEST(test_METHOD_getStateVersion_WITH_successful_updates_SHOULD_increase);
+  RUN_TEST(test_METHOD_scanNetworks_WITH_scan_started_SHOULD_return_scanning);
+  RUN_TEST(test_METHOD_handleNetworkScan_WITH_scan_done_SHOULD_increase_state_version);
   RUN_TEST(test_METHOD_fetchNetworkConfiguration_SHOULD_return_result_WITH_success_to_true);
   RUN_TEST(
       test_METHOD_updateNetworkConfiguration_WITH_valid_data_SHOULD_return_result_WITH_success_to_true);
@@ -292,6 +471,20 @@ void test_METHOD_fetchAllRemotes_SHOULD_return_result_WITH_success_to_true(void)
   TEST_ASSERT_EQUAL_STRING_LEN("", result.errorMsg.c_str(), 0);
 }
 
+void test_METHOD_fetchAllRemotes_SHOULD_return_every_field_of_the_remotes(void)
+{
+  FakeDatabase::remoteDedupWindow = 60000;
+
+  Result<Remote[MAX_REMOTES]> result = controllerTest.fetchAllRemotes();
+  FakeDatabase::remoteDedupWindow = 0;
+
+  TEST_ASSERT_EQUAL(1, result.data[0].id);
+  TEST_ASSERT_EQUAL(42, result.data[0].rollingCode);
+  TEST_ASSERT_EQUAL_STRING("foo", result.data[0].name);
+  TEST_ASSERT_EQUAL(60000, result.data[0].dedupWindow);
+  TEST_ASSERT_EQUAL(0, result.data[2].id);
+}
+
 void test_METHOD_createRemote_WITH_null_name_SHOULD_return_result_WITH_success_to_false(void)
 {
   Result<Remote> result = controllerTest.createRemote(nullptr);
@@ -446,6 +639,34 @@ void test_METHOD_updateRemote_WITH_valid_remote_AND_valid_data_AND_database_fail
   TEST_ASSERT_GREATER_OR_EQUAL(1, result.errorMsg.length());
 }
 
+void test_METHOD_updateRemote_WITH_dedup_window_SHOULD_store_it_AND_publish_the_change(void)
+{
+  FakeSubscriber subscriber;
+  controllerTest.dispatchEvents(); // Events of the previous tests
+  controllerTest.subscribe(&subscriber);
+
+  Result<Remote> result = controllerTest.updateRemote(1, nullptr, 0, 2500);
+  controllerTest.dispatchEvents();
+  controllerTest.unsubscribe(&subscriber);
+
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_EQUAL(2500, result.data.dedupWindow);
+  TEST_ASSERT_EQUAL_STRING("foo", result.data.name);
+  TEST_ASSERT_EQUAL(1, subscriber.notifiedCalls);
+  TEST_ASSERT_EQUAL(REMOTE_CHANGE_DEDUP_WINDOW, subscriber.lastEvent.remote.changes);
+}
+
+void test_METHOD_updateRemote_WITH_dedup_window_out_of_range_SHOULD_return_result_WITH_success_to_false(
+    void)
+{
+  Result<Remote> negative = controllerTest.updateRemote(1, nullptr, 0, -5);
+  Result<Remote> tooLong = controllerTest.updateRemote(1, nullptr, 0, 65536);
+
+  TEST_ASSERT_FALSE(negative.isSuccess);
+  TEST_ASSERT_FALSE(tooLong.isSuccess);
+  TEST_ASSERT_GREATER_OR_EQUAL(1, tooLong.errorMsg.length());
+}
+
 void test_METHOD_operateRemote_WITH_empty_remote_id_SHOULD_return_result_WITH_success_to_false(void)
 {
   Result<String> result = controllerTest.operateRemote(0, "up");
@@ -548,6 +769,525 @@ void test_METHOD_operateRemote_WITH_valide_remote_AND_reset_action_SHOULD_return
   TEST_ASSERT_EQUAL_STRING_LEN("", result.errorMsg.c_str(), 0);
 }
 
+void test_METHOD_operateRemote_SHOULD_publish_one_change_WITH_last_action_AND_rolling_code(void)
+{
+  FakeSubscriber subscriber;
+  controllerTest.dispatchEvents(); // Events of the previous tests
+  controllerTest.subscribe(&subscriber);
+
+  controllerTest.operateRemote(1, RemoteAction::UP);
+  controllerTest.dispatchEvents();
+  controllerTest.unsubscribe(&subscriber);
+
+  TEST_ASSERT_EQUAL(1, subscriber.notifiedCalls);
+  TEST_ASSERT_EQUAL(REMOTE_CHANGE_LAST_ACTION | REMOTE_CHANGE_ROLLING_CODE,
+      subscriber.lastEvent.remote.changes);
+  TEST_ASSERT_TRUE(subscriber.lastEvent.remote.lastAction == RemoteAction::UP);
+  TEST_ASSERT_EQUAL(43, subscriber.lastEvent.remote.remote.rollingCode);
+}
+
+void test_METHOD_operateRemote_WITH_unknown_remote_action_SHOULD_return_result_WITH_success_to_false(
+    void)
+{
+  Result<String> result = controllerTest.operateRemote(1, RemoteAction::UNKNOWN);
+
+  TEST_ASSERT_EQUAL_STRING_LEN("", result.data.c_str(), 0);
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_GREATER_OR_EQUAL(1, result.errorMsg.length());
+}
+
+void test_METHOD_operateRemote_WITH_valide_remote_AND_down_remote_action_SHOULD_return_result_WITH_success_to_true(
+    void)
+{
+  Result<String> result = controllerTest.operateRemote(1, RemoteAction::DOWN);
+
+  TEST_ASSERT_EQUAL_STRING("Command DOWN sent.", result.data.c_str());
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_EQUAL_STRING_LEN("", result.errorMsg.c_str(), 0);
+  TEST_ASSERT_TRUE(FakeTransmitter::sendDOWNCommandCalled);
+  TEST_ASSERT_FALSE(FakeTransmitter::sendUPCommandCalled);
+}
+
+void test_METHOD_parseRemoteAction_WITH_valid_names_SHOULD_return_remote_actions(void)
+{
+  TEST_ASSERT_TRUE(parseRemoteAction("up") == RemoteAction::UP);
+  TEST_ASSERT_TRUE(parseRemoteAction("stop") == RemoteAction::STOP);
+  TEST_ASSERT_TRUE(parseRemoteAction("down") == RemoteAction::DOWN);
+  TEST_ASSERT_TRUE(parseRemoteAction("pair") == RemoteAction::PAIR);
+  TEST_ASSERT_TRUE(parseRemoteAction("reset") == RemoteAction::RESET);
+  TEST_ASSERT_EQUAL_STRING("up", getRemoteActionDescriptor(RemoteAction::UP).name);
+}
+
+void test_METHOD_parseRemoteAction_WITH_invalid_names_SHOULD_return_unknown(void)
+{
+  TEST_ASSERT_TRUE(parseRemoteAction(nullptr) == RemoteAction::UNKNOWN);
+  TEST_ASSERT_TRUE(parseRemoteAction("") == RemoteAction::UNKNOWN);
+  TEST_ASSERT_TRUE(parseRemoteAction("UP") == RemoteAction::UNKNOWN);
+  TEST_ASSERT_TRUE(parseRemoteAction("foo") == RemoteAction::UNKNOWN);
+}
+
+void test_METHOD_parseRemoteOperations_WITH_valid_list_SHOULD_return_operations(void)
+{
+  RemoteOperation operations[MAX_BATCH_OPERATIONS];
+  int count = parseRemoteOperations("1:up,2:down,1:reset", operations, MAX_BATCH_OPERATIONS);
+
+  TEST_ASSERT_EQUAL(3, count);
+  TEST_ASSERT_EQUAL(1, operations[0].remoteId);
+  TEST_ASSERT_TRUE(operations[0].action == RemoteAction::UP);
+  TEST_ASSERT_EQUAL(2, operations[1].remoteId);
+  TEST_ASSERT_TRUE(operations[1].action == RemoteAction::DOWN);
+  TEST_ASSERT_EQUAL(1, operations[2].remoteId);
+  TEST_ASSERT_TRUE(operations[2].action == RemoteAction::RESET);
+}
+
+void test_METHOD_parseRemoteOperations_WITH_malformed_list_SHOULD_return_error(void)
+{
+  RemoteOperation operations[2];
+
+  TEST_ASSERT_EQUAL(-1, parseRemoteOperations(nullptr, operations, 2));
+  TEST_ASSERT_EQUAL(-1, parseRemoteOperations("1:foo", operations, 2));
+  TEST_ASSERT_EQUAL(-1, parseRemoteOperations("up", operations, 2));
+  TEST_ASSERT_EQUAL(-1, parseRemoteOperations("1:", operations, 2));
+  TEST_ASSERT_EQUAL(-1, parseRemoteOperations("1:up,2:up,3:up", operations, 2));
+}
+
+void test_METHOD_operateBatch_WITH_no_operation_SHOULD_return_result_WITH_success_to_false(void)
+{
+  Result<BatchReport> result = controllerTest.operateBatch(nullptr, 0);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_EQUAL(0, result.data.size);
+  TEST_ASSERT_GREATER_OR_EQUAL(1, result.errorMsg.length());
+}
+
+void test_METHOD_operateBatch_WITH_unknown_remote_SHOULD_return_result_WITH_success_to_false_AND_queue_nothing(
+    void)
+{
+  RemoteOperation operations[] = { { 1, RemoteAction::UP }, { 42, RemoteAction::DOWN } };
+  Result<BatchReport> result = controllerTest.operateBatch(operations, 2);
+  controllerTest.handleCommands();
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_GREATER_OR_EQUAL(1, result.errorMsg.length());
+  TEST_ASSERT_FALSE(FakeTransmitter::sendUPCommandCalled);
+  TEST_ASSERT_FALSE(FakeTransmitter::sendDOWNCommandCalled);
+}
+
+void test_METHOD_operateBatch_WITH_valid_operations_SHOULD_queue_one_command_per_operation(void)
+{
+  RemoteOperation operations[]
+      = { { 1, RemoteAction::UP }, { 2, RemoteAction::DOWN }, { 1, RemoteAction::STOP } };
+  Result<BatchReport> result = controllerTest.operateBatch(operations, 3);
+  bool sendUPCommandCalled = FakeTransmitter::sendUPCommandCalled;
+  for (unsigned short i = 0; i < 3; ++i)
+  {
+    controllerTest.handleCommands();
+  }
+
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_EQUAL_STRING_LEN("", result.errorMsg.c_str(), 0);
+  TEST_ASSERT_FALSE(sendUPCommandCalled);
+  TEST_ASSERT_EQUAL(3, result.data.size);
+  TEST_ASSERT_EQUAL(2, result.data.operations[1].remoteId);
+  TEST_ASSERT_TRUE(result.data.operations[1].action == RemoteAction::DOWN);
+  TEST_ASSERT_EQUAL(result.data.requestIds[0] + 1, result.data.requestIds[1]);
+  TEST_ASSERT_EQUAL(result.data.requestIds[1] + 1, result.data.requestIds[2]);
+  for (unsigned short i = 0; i < 3; ++i)
+  {
+    Result<Command> command = controllerTest.fetchCommand(result.data.requestIds[i]);
+    TEST_ASSERT_TRUE(command.data.status == CommandStatus::DONE);
+    TEST_ASSERT_EQUAL(operations[i].remoteId, command.data.remoteId);
+  }
+  TEST_ASSERT_TRUE(FakeTransmitter::sendUPCommandCalled);
+  TEST_ASSERT_TRUE(FakeTransmitter::sendDOWNCommandCalled);
+  TEST_ASSERT_TRUE(FakeTransmitter::sendSTOPCommandCalled);
+}
+
+void test_METHOD_operateBatch_WITH_queue_too_small_SHOULD_return_result_WITH_success_to_false(void)
+{
+  for (unsigned short i = 0; i < MAX_COMMANDS - 1; ++i)
+  {
+    TEST_ASSERT_TRUE(controllerTest.submitCommand(1, RemoteAction::UP).isSuccess);
+  }
+
+  RemoteOperation operations[] = { { 1, RemoteAction::DOWN }, { 2, RemoteAction::DOWN } };
+  Result<BatchReport> result = controllerTest.operateBatch(operations, 2);
+  for (unsigned short i = 0; i < MAX_COMMANDS; ++i)
+  {
+    controllerTest.handleCommands(); // Drain the queue for the next tests
+  }
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_GREATER_OR_EQUAL(1, result.errorMsg.length());
+  TEST_ASSERT_FALSE(FakeTransmitter::sendDOWNCommandCalled);
+}
+
+void test_METHOD_submitCommand_WITH_not_found_remote_SHOULD_return_result_WITH_success_to_false(
+    void)
+{
+  FakeDatabase::shouldReturnEmptyRemote = true;
+
+  Result<Command> result = controllerTest.submitCommand(42, RemoteAction::UP);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_EQUAL(0, result.data.requestId);
+  TEST_ASSERT_TRUE(result.data.error == CommandError::REMOTE_NOT_FOUND);
+  TEST_ASSERT_GREATER_OR_EQUAL(1, result.errorMsg.length());
+}
+
+void test_METHOD_submitCommand_WITH_valid_remote_SHOULD_return_pending_command_AND_send_nothing(
+    void)
+{
+  Result<Command> result = controllerTest.submitCommand(1, RemoteAction::DOWN);
+  bool sendDOWNCommandCalled = FakeTransmitter::sendDOWNCommandCalled;
+  controllerTest.handleCommands(); // Drain the queue for the next tests
+
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_FALSE(sendDOWNCommandCalled);
+  TEST_ASSERT_NOT_EQUAL(0, result.data.requestId);
+  TEST_ASSERT_EQUAL(1, result.data.remoteId);
+  TEST_ASSERT_TRUE(result.data.action == RemoteAction::DOWN);
+  TEST_ASSERT_TRUE(result.data.status == CommandStatus::PENDING);
+}
+
+void test_METHOD_submitCommand_WITH_too_many_pending_commands_SHOULD_return_result_WITH_success_to_false(
+    void)
+{
+  for (unsigned short i = 0; i < MAX_COMMANDS; ++i)
+  {
+    TEST_ASSERT_TRUE(controllerTest.submitCommand(1, RemoteAction::UP).isSuccess);
+  }
+  Result<Command> result = controllerTest.submitCommand(1, RemoteAction::UP);
+  for (unsigned short i = 0; i < MAX_COMMANDS; ++i)
+  {
+    controllerTest.handleCommands(); // Drain the queue for the next tests
+  }
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_GREATER_OR_EQUAL(1, result.errorMsg.length());
+  TEST_ASSERT_TRUE(result.data.error == CommandError::QUEUE_FULL);
+}
+
+void test_METHOD_handleCommands_WITH_pending_command_SHOULD_send_it_AND_mark_it_done(void)
+{
+  Result<Command> submitted = controllerTest.submitCommand(1, RemoteAction::STOP);
+  TEST_ASSERT_FALSE(FakeTransmitter::sendSTOPCommandCalled);
+
+  controllerTest.handleCommands();
+  Result<Command> result = controllerTest.fetchCommand(submitted.data.requestId);
+
+  TEST_ASSERT_TRUE(FakeTransmitter::sendSTOPCommandCalled);
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_EQUAL(submitted.data.requestId, result.data.requestId);
+  TEST_ASSERT_TRUE(result.data.status == CommandStatus::DONE);
+  TEST_ASSERT_EQUAL(42, result.data.rollingCode);
+  TEST_ASSERT_TRUE(result.data.error == CommandError::NONE);
+  TEST_ASSERT_TRUE(result.data.timings.total >= result.data.timings.queue
+          + result.data.timings.transmit + result.data.timings.commit);
+}
+
+void test_METHOD_handleCommands_WITH_database_fail_SHOULD_mark_command_failed(void)
+{
+  Result<Command> submitted = controllerTest.submitCommand(1, RemoteAction::UP);
+  FakeDatabase::shouldFailUpdateRemote = true;
+
+  controllerTest.handleCommands();
+  Result<Command> result = controllerTest.fetchCommand(submitted.data.requestId);
+
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_TRUE(result.data.status == CommandStatus::FAILED);
+  TEST_ASSERT_TRUE(result.data.error == CommandError::COMMIT_FAILED);
+}
+
+void test_METHOD_handleCommands_WITH_remote_deleted_since_submission_SHOULD_fail_without_sending(
+    void)
+{
+  Result<Command> submitted = controllerTest.submitCommand(1, RemoteAction::DOWN);
+  FakeDatabase::shouldReturnEmptyRemote = true;
+
+  controllerTest.handleCommands();
+  Result<Command> result = controllerTest.fetchCommand(submitted.data.requestId);
+
+  TEST_ASSERT_FALSE(FakeTransmitter::sendDOWNCommandCalled);
+  TEST_ASSERT_TRUE(result.data.status == CommandStatus::FAILED);
+  TEST_ASSERT_TRUE(result.data.error == CommandError::REMOTE_NOT_FOUND);
+}
+
+void test_METHOD_fetchCommand_WITH_unknown_request_id_SHOULD_return_result_WITH_success_to_false(
+    void)
+{
+  Result<Command> result = controllerTest.fetchCommand(123456);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_GREATER_OR_EQUAL(1, result.errorMsg.length());
+}
+
+void test_METHOD_submitCommand_WITH_same_command_in_dedup_window_SHOULD_return_previous_command(
+    void)
+{
+  unsigned long suppressed = controllerTest.fetchSystemInfos().data.suppressedCommands;
+  FakeDatabase::remoteDedupWindow = 60000;
+
+  Result<Command> first = controllerTest.submitCommand(3, RemoteAction::UP);
+  Result<Command> second = controllerTest.submitCommand(3, RemoteAction::UP);
+  controllerTest.handleCommands(); // Drain the queue for the next tests
+  FakeDatabase::remoteDedupWindow = 0;
+
+  TEST_ASSERT_TRUE(second.isSuccess);
+  TEST_ASSERT_EQUAL(first.data.requestId, second.data.requestId);
+  TEST_ASSERT_EQUAL(suppressed + 1, controllerTest.fetchSystemInfos().data.suppressedCommands);
+}
+
+void test_METHOD_submitCommand_WITH_other_action_in_dedup_window_SHOULD_return_new_command(void)
+{
+  FakeDatabase::remoteDedupWindow = 60000;
+
+  Result<Command> first = controllerTest.submitCommand(3, RemoteAction::DOWN);
+  Result<Command> second = controllerTest.submitCommand(3, RemoteAction::STOP);
+  controllerTest.handleCommands(); // Drain the queue for the next tests
+  controllerTest.handleCommands();
+  FakeDatabase::remoteDedupWindow = 0;
+
+  TEST_ASSERT_TRUE(second.isSuccess);
+  TEST_ASSERT_NOT_EQUAL(first.data.requestId, second.data.requestId);
+}
+
+void test_METHOD_submitCommand_WITH_same_idempotency_key_SHOULD_return_previous_command(void)
+{
+  Result<Command> first = controllerTest.submitCommand(4, RemoteAction::DOWN, "retry-key");
+  controllerTest.handleCommands();
+  FakeTransmitter::sendDOWNCommandCalled = false;
+
+  Result<Command> second = controllerTest.submitCommand(4, RemoteAction::DOWN, "retry-key");
+  controllerTest.handleCommands();
+
+  TEST_ASSERT_TRUE(second.isSuccess);
+  TEST_ASSERT_EQUAL(first.data.requestId, second.data.requestId);
+  TEST_ASSERT_TRUE(second.data.status == CommandStatus::DONE);
+  TEST_ASSERT_FALSE(FakeTransmitter::sendDOWNCommandCalled);
+}
+
+void test_METHOD_submitCommand_WITH_idempotency_key_of_another_command_SHOULD_return_result_WITH_success_to_false(
+    void)
+{
+  controllerTest.submitCommand(5, RemoteAction::UP, "used-key");
+  controllerTest.handleCommands(); // Drain the queue for the next tests
+
+  Result<Command> result = controllerTest.submitCommand(5, RemoteAction::DOWN, "used-key");
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_GREATER_OR_EQUAL(1, result.errorMsg.length());
+}
+
+void test_METHOD_createScene_WITH_empty_name_SHOULD_return_result_WITH_success_to_false(void)
+{
+  RemoteOperation operations[] = { { 1, RemoteAction::UP } };
+  Result<Scene> result = controllerTest.createScene("", operations, 1);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_EQUAL(0, result.data.id);
+  TEST_ASSERT_GREATER_OR_EQUAL(1, result.errorMsg.length());
+}
+
+void test_METHOD_createScene_WITH_invalid_operation_SHOULD_return_result_WITH_success_to_false(
+    void)
+{
+  RemoteOperation operations[] = { { 1, RemoteAction::UNKNOWN } };
+  Result<Scene> result = controllerTest.createScene("south", operations, 1);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_EQUAL(0, result.data.id);
+  TEST_ASSERT_GREATER_OR_EQUAL(1, result.errorMsg.length());
+}
+
+void test_METHOD_createScene_WITH_database_fail_SHOULD_return_result_WITH_success_to_false(void)
+{
+  FakeDatabase::shouldFailCreateScene = true;
+
+  RemoteOperation operations[] = { { 1, RemoteAction::UP } };
+  Result<Scene> result = controllerTest.createScene("south", operations, 1);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_EQUAL(0, result.data.id);
+  TEST_ASSERT_GREATER_OR_EQUAL(1, result.errorMsg.length());
+}
+
+void test_METHOD_createScene_SHOULD_return_result_WITH_success_to_true(void)
+{
+  RemoteOperation operations[] = { { 1, RemoteAction::DOWN }, { 2, RemoteAction::DOWN } };
+  Result<Scene> result = controllerTest.createScene("south", operations, 2);
+
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_EQUAL(1, result.data.id);
+  TEST_ASSERT_EQUAL_STRING("south", result.data.name);
+  TEST_ASSERT_EQUAL(2, result.data.size);
+  TEST_ASSERT_EQUAL(2, result.data.operations[1].remoteId);
+  TEST_ASSERT_EQUAL_STRING_LEN("", result.errorMsg.c_str(), 0);
+}
+
+void test_METHOD_deleteScene_WITH_not_found_scene_SHOULD_return_result_WITH_success_to_false(void)
+{
+  FakeDatabase::shouldReturnEmptyScene = true;
+
+  Result<Scene> result = controllerTest.deleteScene(1);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_GREATER_OR_EQUAL(1, result.errorMsg.length());
+}
+
+void test_METHOD_operateScene_WITH_not_found_scene_SHOULD_return_result_WITH_success_to_false(void)
+{
+  FakeDatabase::shouldReturnEmptyScene = true;
+
+  Result<BatchReport> result = controllerTest.operateScene(1);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_FALSE(FakeTransmitter::sendDOWNCommandCalled);
+  TEST_ASSERT_GREATER_OR_EQUAL(1, result.errorMsg.length());
+}
+
+void test_METHOD_operateScene_SHOULD_queue_the_operations_of_the_scene(void)
+{
+  Result<BatchReport> result = controllerTest.operateScene(1);
+  bool sendDOWNCommandCalled = FakeTransmitter::sendDOWNCommandCalled;
+  controllerTest.handleCommands();
+  controllerTest.handleCommands();
+
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_FALSE(sendDOWNCommandCalled);
+  TEST_ASSERT_EQUAL(2, result.data.size);
+  TEST_ASSERT_EQUAL(2, result.data.operations[1].remoteId);
+  TEST_ASSERT_TRUE(FakeTransmitter::sendDOWNCommandCalled);
+}
+
+void test_METHOD_createSchedule_WITH_invalid_cron_SHOULD_return_result_WITH_success_to_false(void)
+{
+  Result<Schedule> result = controllerTest.createSchedule(
+      1, RemoteAction::DOWN, ScheduleTrigger::TIME, 0, "0 25 * * *");
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_GREATER_OR_EQUAL(1, result.errorMsg.length());
+}
+
+void test_METHOD_createSchedule_WITH_offset_out_of_range_SHOULD_return_result_WITH_success_to_false(
+    void)
+{
+  Result<Schedule> result = controllerTest.createSchedule(
+      1, RemoteAction::DOWN, ScheduleTrigger::SUNSET, 721, "* * * * *");
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_GREATER_OR_EQUAL(1, result.errorMsg.length());
+}
+
+void test_METHOD_createSchedule_WITH_not_found_remote_SHOULD_return_result_WITH_success_to_false(
+    void)
+{
+  FakeDatabase::shouldReturnEmptyRemote = true;
+
+  Result<Schedule> result = controllerTest.createSchedule(
+      1, RemoteAction::DOWN, ScheduleTrigger::TIME, 0, "0 8 * * *");
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_GREATER_OR_EQUAL(1, result.errorMsg.length());
+}
+
+void test_METHOD_createSchedule_WITH_database_fail_SHOULD_return_result_WITH_success_to_false(void)
+{
+  FakeDatabase::shouldFailCreateSchedule = true;
+  unsigned long revision = controllerTest.getSchedulesRevision();
+
+  Result<Schedule> result = controllerTest.createSchedule(
+      1, RemoteAction::DOWN, ScheduleTrigger::TIME, 0, "0 8 * * *");
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_EQUAL(revision, controllerTest.getSchedulesRevision());
+  TEST_ASSERT_GREATER_OR_EQUAL(1, result.errorMsg.length());
+}
+
+void test_METHOD_createSchedule_SHOULD_return_result_WITH_success_to_true_AND_change_revision(void)
+{
+  unsigned long revision = controllerTest.getSchedulesRevision();
+
+  Result<Schedule> result = controllerTest.createSchedule(
+      1, RemoteAction::UP, ScheduleTrigger::SUNRISE, -30, "* * * * 1-5");
+
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_EQUAL(1, result.data.id);
+  TEST_ASSERT_EQUAL(1, result.data.remoteId);
+  TEST_ASSERT_EQUAL(-30, result.data.offset);
+  TEST_ASSERT_EQUAL_STRING("* * * * 1-5", result.data.cron);
+  TEST_ASSERT_NOT_EQUAL(revision, controllerTest.getSchedulesRevision());
+  TEST_ASSERT_EQUAL_STRING_LEN("", result.errorMsg.c_str(), 0);
+}
+
+void test_METHOD_deleteSchedule_WITH_not_found_schedule_SHOULD_return_result_WITH_success_to_false(
+    void)
+{
+  FakeDatabase::shouldReturnEmptySchedule = true;
+
+  Result<Schedule> result = controllerTest.deleteSchedule(1);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_GREATER_OR_EQUAL(1, result.errorMsg.length());
+}
+
+void test_METHOD_updateLocation_WITH_invalid_latitude_SHOULD_return_result_WITH_success_to_false(
+    void)
+{
+  Result<Location> result = controllerTest.updateLocation(91, 2.35, "UTC0");
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_GREATER_OR_EQUAL(1, result.errorMsg.length());
+}
+
+void test_METHOD_updateLocation_WITH_empty_timezone_SHOULD_return_result_WITH_success_to_false(void)
+{
+  Result<Location> result = controllerTest.updateLocation(48.85, 2.35, "");
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_GREATER_OR_EQUAL(1, result.errorMsg.length());
+}
+
+void test_METHOD_updateLocation_SHOULD_return_result_WITH_success_to_true(void)
+{
+  Result<Location> result
+      = controllerTest.updateLocation(48.85, 2.35, "CET-1CEST,M3.5.0,M10.5.0/3");
+
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_EQUAL_FLOAT(48.85, result.data.latitude);
+  TEST_ASSERT_EQUAL_STRING("CET-1CEST,M3.5.0,M10.5.0/3", result.data.timezone);
+  TEST_ASSERT_EQUAL_STRING_LEN("", result.errorMsg.c_str(), 0);
+}
+
+void test_METHOD_getStateVersion_WITH_fetch_OR_failed_update_SHOULD_not_change(void)
+{
+  unsigned long version = controllerTest.getStateVersion();
+
+  controllerTest.fetchAllRemotes();
+  controllerTest.fetchSystemInfos();
+  controllerTest.fetchLocation();
+  FakeDatabase::shouldFailUpdateRemote = true;
+  controllerTest.updateRemote(1, "bar", 0);
+
+  TEST_ASSERT_EQUAL(version, controllerTest.getStateVersion());
+}
+
+void test_METHOD_getStateVersion_WITH_successful_updates_SHOULD_increase(void)
+{
+  unsigned long version = controllerTest.getStateVersion();
+
+  controllerTest.updateRemote(1, "bar", 0);
+  TEST_ASSERT_GREATER_THAN(version, controllerTest.getStateVersion());
+
+  version = controllerTest.getStateVersion();
+  controllerTest.operateRemote(1, RemoteAction::UP);
+  TEST_ASSERT_GREATER_THAN(version, controllerTest.getStateVersion());
+
+  version = controllerTest.getStateVersion();
+  controllerTest.updateLocation(48.85, 2.35, "UTC0");
+  TEST_ASSERT_GREATER_THAN(version, controllerTest.getStateVersion());
+}
+
 void test_METHOD_fetchNetworkConfiguration_SHOULD_return_result_WITH_success_to_true(void)
 {
   Result<NetworkConfiguration> result = controllerTest.fetchNetworkConfiguration();
@@ -701,4 +1441,27 @@ void test_METHOD_updateMQTTConfiguration_WITH_update_fail_SHOULD_return_result_W
 
   TEST_ASSERT_FALSE(result.isSuccess);
   TEST_ASSERT_GREATER_OR_EQUAL(1, result.errorMsg.length());
-}
\ No newline at end of file
+}
+
+void test_METHOD_scanNetworks_WITH_scan_started_SHOULD_return_scanning(void)
+{
+  Result<NetworkScan> result = controllerTest.scanNetworks();
+
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_TRUE(result.data.scanning);
+  TEST_ASSERT_TRUE(controllerTest.fetchNetworkScan().data.scanning);
+}
+
+void test_METHOD_handleNetworkScan_WITH_scan_done_SHOULD_increase_state_version(void)
+{
+  controllerTest.scanNetworks();
+  unsigned long version = controllerTest.getStateVersion();
+
+  controllerTest.handleNetworkScan();
+  TEST_ASSERT_EQUAL(version, controllerTest.getStateVersion());
+
+  FakeNetworkClient::scanDone = true;
+  controllerTest.handleNetworkScan();
+  TEST_ASSERT_GREATER_THAN(version, controllerTest.getStateVersion());
+  TEST_ASSERT_FALSE(controllerTest.fetchNetworkScan().data.scanning);
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <result.h>
+#include <scene.h>
+#include <schedule.h>
 #include <networks.h>
 #include <mqttConfig.h>
 #include <systemInfos.h>
@@ -29,6 +31,12 @@ class FakeDatabase : public DatabaseAbstract
   static bool shouldFailCreateRemote;
   static bool shouldFailUpdateNetworkConfiguration;
   static bool shouldFailUpdateMQTTConfiguration;
+  static bool shouldFailCreateScene;
+  static bool shouldReturnEmptyScene;
+  static bool shouldFailCreateSchedule;
+  static bool shouldReturnEmptySchedule;
+  static bool shouldFailUpdateLocation;
+  static unsigned short remoteDedupWindow;
 
   void init();
   bool migrate();
@@ -45,6 +53,18 @@ class FakeDatabase : public DatabaseAbstract
   bool updateRemote(const Remote& remote);
   bool deleteRemote(const unsigned long& id);
 
+  Scene createScene(const Scene& scene);
+  void getAllScenes(Scene scenes[]);
+  Scene getScene(const unsigned short& id);
+  bool deleteScene(const unsigned short& id);
+
+  Schedule createSchedule(const Schedule& schedule);
+  void getAllSchedules(Schedule schedules[]);
+  Schedule getSchedule(const unsigned short& id);
+  bool deleteSchedule(const unsigned short& id);
+  Location getLocation();
+  bool setLocation(const Location& location);
+
   MQTTConfiguration getMQTTConfiguration();
   bool setMQTTConfiguration(const MQTTConfiguration& mqttConfig);
 };
@@ -66,12 +86,18 @@ class FakeTransmitter : public TransmitterAbstract
 class FakeNetworkClient : public NetworkClientAbstract
 {
   public:
+  static bool scanning;
+  static bool scanDone; // Returned by handleScan
+
   bool connect(const NetworkConfiguration& conf);
   bool connect(const char* ssid, const char* password);
   String getIP();
   String getMacAddress();
   bool isConnected();
   void scanNetworks();
+  NetworkScan startScan();
+  bool handleScan();
+  NetworkScan getScan();
   void getNetworks(Network networks[]);
 };
 
@@ -88,6 +114,7 @@ void test_METHOD_fetchRemote_WITH_remote_not_found_SHOULD_return_result_WITH_suc
 void test_METHOD_fetchRemote_SHOULD_return_result_WITH_success_to_true(void);
 
 void test_METHOD_fetchAllRemotes_SHOULD_return_result_WITH_success_to_true(void);
+void test_METHOD_fetchAllRemotes_SHOULD_return_every_field_of_the_remotes(void);
 
 void test_METHOD_createRemote_WITH_null_name_SHOULD_return_result_WITH_success_to_false(void);
 void test_METHOD_createRemote_WITH_empty_name_SHOULD_return_result_WITH_success_to_false(void);
@@ -110,6 +137,9 @@ void test_METHOD_updateRemote_WITH_valid_remote_AND_valid_name_SHOULD_return_res
     void);
 void test_METHOD_updateRemote_WITH_valid_remote_AND_rolling_code_provided_SHOULD_return_result_WITH_success_to_true(
     void);
+void test_METHOD_updateRemote_WITH_dedup_window_SHOULD_store_it_AND_publish_the_change(void);
+void test_METHOD_updateRemote_WITH_dedup_window_out_of_range_SHOULD_return_result_WITH_success_to_false(
+    void);
 void test_METHOD_updateRemote_WITH_valid_remote_AND_valid_data_AND_database_fail_SHOULD_return_result_WITH_success_to_false(
     void);
 
@@ -130,6 +160,70 @@ void test_METHOD_operateRemote_WITH_valide_remote_AND_pair_action_SHOULD_return_
     void);
 void test_METHOD_operateRemote_WITH_valide_remote_AND_reset_action_SHOULD_return_result_WITH_success_to_true(
     void);
+void test_METHOD_operateRemote_WITH_unknown_remote_action_SHOULD_return_result_WITH_success_to_false(
+    void);
+void test_METHOD_operateRemote_WITH_valide_remote_AND_down_remote_action_SHOULD_return_result_WITH_success_to_true(
+    void);
+void test_METHOD_operateRemote_SHOULD_publish_one_change_WITH_last_action_AND_rolling_code(void);
+
+void test_METHOD_parseRemoteAction_WITH_valid_names_SHOULD_return_remote_actions(void);
+void test_METHOD_parseRemoteAction_WITH_invalid_names_SHOULD_return_unknown(void);
+
+void test_METHOD_parseRemoteOperations_WITH_valid_list_SHOULD_return_operations(void);
+void test_METHOD_parseRemoteOperations_WITH_malformed_list_SHOULD_return_error(void);
+
+void test_METHOD_operateBatch_WITH_no_operation_SHOULD_return_result_WITH_success_to_false(void);
+void test_METHOD_operateBatch_WITH_unknown_remote_SHOULD_return_result_WITH_success_to_false_AND_queue_nothing(
+    void);
+void test_METHOD_operateBatch_WITH_valid_operations_SHOULD_queue_one_command_per_operation(void);
+void test_METHOD_operateBatch_WITH_queue_too_small_SHOULD_return_result_WITH_success_to_false(void);
+
+void test_METHOD_submitCommand_WITH_not_found_remote_SHOULD_return_result_WITH_success_to_false(
+    void);
+void test_METHOD_submitCommand_WITH_valid_remote_SHOULD_return_pending_command_AND_send_nothing(
+    void);
+void test_METHOD_submitCommand_WITH_too_many_pending_commands_SHOULD_return_result_WITH_success_to_false(
+    void);
+void test_METHOD_handleCommands_WITH_pending_command_SHOULD_send_it_AND_mark_it_done(void);
+void test_METHOD_handleCommands_WITH_database_fail_SHOULD_mark_command_failed(void);
+void test_METHOD_handleCommands_WITH_remote_deleted_since_submission_SHOULD_fail_without_sending(
+    void);
+void test_METHOD_fetchCommand_WITH_unknown_request_id_SHOULD_return_result_WITH_success_to_false(
+    void);
+void test_METHOD_submitCommand_WITH_same_command_in_dedup_window_SHOULD_return_previous_command(
+    void);
+void test_METHOD_submitCommand_WITH_other_action_in_dedup_window_SHOULD_return_new_command(void);
+void test_METHOD_submitCommand_WITH_same_idempotency_key_SHOULD_return_previous_command(void);
+void test_METHOD_submitCommand_WITH_idempotency_key_of_another_command_SHOULD_return_result_WITH_success_to_false(
+    void);
+
+void test_METHOD_createScene_WITH_empty_name_SHOULD_return_result_WITH_success_to_false(void);
+void test_METHOD_createScene_WITH_invalid_operation_SHOULD_return_result_WITH_success_to_false(
+    void);
+void test_METHOD_createScene_WITH_database_fail_SHOULD_return_result_WITH_success_to_false(void);
+void test_METHOD_createScene_SHOULD_return_result_WITH_success_to_true(void);
+void test_METHOD_deleteScene_WITH_not_found_scene_SHOULD_return_result_WITH_success_to_false(void);
+void test_METHOD_operateScene_WITH_not_found_scene_SHOULD_return_result_WITH_success_to_false(void);
+void test_METHOD_operateScene_SHOULD_queue_the_operations_of_the_scene(void);
+
+void test_METHOD_createSchedule_WITH_invalid_cron_SHOULD_return_result_WITH_success_to_false(void);
+void test_METHOD_createSchedule_WITH_offset_out_of_range_SHOULD_return_result_WITH_success_to_false(
+    void);
+void test_METHOD_createSchedule_WITH_not_found_remote_SHOULD_return_result_WITH_success_to_false(
+    void);
+void test_METHOD_createSchedule_WITH_database_fail_SHOULD_return_result_WITH_success_to_false(void);
+void test_METHOD_createSchedule_SHOULD_return_result_WITH_success_to_true_AND_change_revision(void);
+void test_METHOD_deleteSchedule_WITH_not_found_schedule_SHOULD_return_result_WITH_success_to_false(
+    void);
+void test_METHOD_updateLocation_WITH_invalid_latitude_SHOULD_return_result_WITH_success_to_false(
+    void);
+void test_METHOD_updateLocation_WITH_empty_timezone_SHOULD_return_result_WITH_success_to_false(
+    void);
+void test_METHOD_updateLocation_SHOULD_return_result_WITH_success_to_true(void);
+void test_METHOD_getStateVersion_WITH_fetch_OR_failed_update_SHOULD_not_change(void);
+void test_METHOD_getStateVersion_WITH_successful_updates_SHOULD_increase(void);
+void test_METHOD_scanNetworks_WITH_scan_started_SHOULD_return_scanning(void);
+void test_METHOD_handleNetworkScan_WITH_scan_done_SHOULD_increase_state_version(void);
 
 void test_METHOD_fetchNetworkConfiguration_SHOULD_return_result_WITH_success_to_true(void);
 
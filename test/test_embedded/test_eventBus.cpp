@@ -0,0 +1,163 @@
+#include <unity.h>
+#include <Arduino.h>
+
+#include <event.h>
+#include <remote.h>
+#include <command.h>
+#include <config.h>
+#include <eventBus.h>
+#include <remoteAction.h>
+#include "./test_eventBus.h"
+
+// Fake Subscriber
+void FakeSubscriber::notified(const Event& event)
+{
+  this->notifiedCalls++;
+  this->lastEvent = event;
+}
+
+// TEST EVENT BUS
+// ############################################################################
+
+void RUN_EVENTBUS_TESTS(void)
+{
+  RUN_TEST(test_METHOD_publish_SHOULD_not_deliver_the_event_before_dispatchEvents);
+  RUN_TEST(test_METHOD_dispatchEvents_WITH_queued_events_SHOULD_deliver_them_to_all_subscribers);
+  RUN_TEST(test_METHOD_dispatchEvents_WITH_filtered_subscriber_SHOULD_deliver_only_matching_events);
+  RUN_TEST(test_METHOD_publish_WITH_full_ring_SHOULD_return_false_AND_count_dropped_event);
+  RUN_TEST(test_METHOD_unsubscribe_SHOULD_stop_delivering_events);
+  RUN_TEST(test_METHOD_dispatchEvents_WITH_changes_of_one_remote_SHOULD_deliver_one_merged_change);
+  RUN_TEST(test_METHOD_dispatchEvents_WITH_deleted_remote_SHOULD_deliver_only_the_deletion);
+}
+
+void test_METHOD_publish_SHOULD_not_deliver_the_event_before_dispatchEvents(void)
+{
+  EventBus eventBus;
+  FakeSubscriber subscriber;
+  eventBus.subscribe(&subscriber);
+
+  bool isPublished = eventBus.publish(
+      RemoteChange { REMOTE_CHANGE_LAST_ACTION, RemoteAction::UP, Remote { 1, 42, "foo" } });
+
+  TEST_ASSERT_TRUE(isPublished);
+  TEST_ASSERT_EQUAL(0, subscriber.notifiedCalls);
+}
+
+void test_METHOD_dispatchEvents_WITH_queued_events_SHOULD_deliver_them_to_all_subscribers(void)
+{
+  EventBus eventBus;
+  FakeSubscriber subscriberA;
+  FakeSubscriber subscriberB;
+  eventBus.subscribe(&subscriberA);
+  eventBus.subscribe(&subscriberB);
+
+  Command command = { 7, 1, RemoteAction::DOWN, CommandStatus::DONE, 43, 0, "" };
+  eventBus.publish(command);
+  eventBus.publish(
+      RemoteChange { REMOTE_CHANGE_NAME, RemoteAction::UNKNOWN, Remote { 2, 7, "bar" } });
+  eventBus.dispatchEvents();
+
+  TEST_ASSERT_EQUAL(2, subscriberA.notifiedCalls);
+  TEST_ASSERT_EQUAL(2, subscriberB.notifiedCalls);
+  // Remote changes are delivered before the other events
+  TEST_ASSERT_TRUE(subscriberA.lastEvent.type == EventType::COMMAND);
+  TEST_ASSERT_EQUAL(7, subscriberA.lastEvent.command.requestId);
+
+  eventBus.dispatchEvents();
+
+  TEST_ASSERT_EQUAL(2, subscriberA.notifiedCalls);
+}
+
+void test_METHOD_dispatchEvents_WITH_filtered_subscriber_SHOULD_deliver_only_matching_events(void)
+{
+  EventBus eventBus;
+  FakeSubscriber subscriber;
+  eventBus.subscribe(&subscriber, EVENT_FILTER_COMMAND);
+
+  Command command = { 7, 1, RemoteAction::DOWN, CommandStatus::DONE, 43, 0, "" };
+  eventBus.publish(
+      RemoteChange { REMOTE_CHANGE_LAST_ACTION, RemoteAction::UP, Remote { 1, 42, "foo" } });
+  eventBus.publish(command);
+  eventBus.dispatchEvents();
+
+  TEST_ASSERT_EQUAL(1, subscriber.notifiedCalls);
+  TEST_ASSERT_TRUE(subscriber.lastEvent.type == EventType::COMMAND);
+  TEST_ASSERT_EQUAL(7, subscriber.lastEvent.command.requestId);
+}
+
+void test_METHOD_publish_WITH_full_ring_SHOULD_return_false_AND_count_dropped_event(void)
+{
+  EventBus eventBus;
+  FakeSubscriber subscriber;
+  eventBus.subscribe(&subscriber);
+
+  Command command = { 7, 1, RemoteAction::DOWN, CommandStatus::DONE, 43, 0, "" };
+  for (unsigned short i = 0; i < EVENT_BUS_CAPACITY; ++i)
+  {
+    command.requestId = i;
+    TEST_ASSERT_TRUE(eventBus.publish(command));
+  }
+  bool isPublished = eventBus.publish(command);
+
+  TEST_ASSERT_FALSE(isPublished);
+  TEST_ASSERT_EQUAL(1, eventBus.getDroppedEvents());
+
+  eventBus.dispatchEvents();
+
+  TEST_ASSERT_EQUAL(EVENT_BUS_CAPACITY, subscriber.notifiedCalls);
+  TEST_ASSERT_EQUAL(EVENT_BUS_CAPACITY - 1, subscriber.lastEvent.command.requestId);
+  TEST_ASSERT_TRUE(eventBus.publish(command));
+}
+
+void test_METHOD_unsubscribe_SHOULD_stop_delivering_events(void)
+{
+  EventBus eventBus;
+  FakeSubscriber subscriberA;
+  FakeSubscriber subscriberB;
+  eventBus.subscribe(&subscriberA);
+  eventBus.subscribe(&subscriberB);
+
+  eventBus.unsubscribe(&subscriberA);
+  eventBus.publish(
+      RemoteChange { REMOTE_CHANGE_DELETED, RemoteAction::UNKNOWN, Remote { 1, 42, "foo" } });
+  eventBus.dispatchEvents();
+
+  TEST_ASSERT_EQUAL(0, subscriberA.notifiedCalls);
+  TEST_ASSERT_EQUAL(1, subscriberB.notifiedCalls);
+}
+
+void test_METHOD_dispatchEvents_WITH_changes_of_one_remote_SHOULD_deliver_one_merged_change(void)
+{
+  EventBus eventBus;
+  FakeSubscriber subscriber;
+  eventBus.subscribe(&subscriber);
+
+  const uint8_t operated = REMOTE_CHANGE_LAST_ACTION | REMOTE_CHANGE_ROLLING_CODE;
+  eventBus.publish(RemoteChange { operated, RemoteAction::UP, Remote { 1, 43, "foo" } });
+  eventBus.publish(RemoteChange { operated, RemoteAction::STOP, Remote { 1, 44, "foo" } });
+  eventBus.publish(
+      RemoteChange { REMOTE_CHANGE_NAME, RemoteAction::UNKNOWN, Remote { 1, 44, "bar" } });
+  eventBus.dispatchEvents();
+
+  TEST_ASSERT_EQUAL(1, subscriber.notifiedCalls);
+  TEST_ASSERT_EQUAL(operated | REMOTE_CHANGE_NAME, subscriber.lastEvent.remote.changes);
+  TEST_ASSERT_TRUE(subscriber.lastEvent.remote.lastAction == RemoteAction::STOP);
+  TEST_ASSERT_EQUAL(44, subscriber.lastEvent.remote.remote.rollingCode);
+  TEST_ASSERT_EQUAL_STRING("bar", subscriber.lastEvent.remote.remote.name);
+}
+
+void test_METHOD_dispatchEvents_WITH_deleted_remote_SHOULD_deliver_only_the_deletion(void)
+{
+  EventBus eventBus;
+  FakeSubscriber subscriber;
+  eventBus.subscribe(&subscriber);
+
+  const uint8_t operated = REMOTE_CHANGE_LAST_ACTION | REMOTE_CHANGE_ROLLING_CODE;
+  eventBus.publish(RemoteChange { operated, RemoteAction::UP, Remote { 1, 43, "foo" } });
+  eventBus.publish(
+      RemoteChange { REMOTE_CHANGE_DELETED, RemoteAction::UNKNOWN, Remote { 1, 43, "foo" } });
+  eventBus.dispatchEvents();
+
+  TEST_ASSERT_EQUAL(1, subscriber.notifiedCalls);
+  TEST_ASSERT_EQUAL(REMOTE_CHANGE_DELETED, subscriber.lastEvent.remote.changes);
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <event.h>
+#include <eventBus.h>
+
+class FakeSubscriber : public EventSubscriber
+{
+  public:
+  // For tests
+  unsigned short notifiedCalls = 0;
+  Event lastEvent;
+
+  void notified(const Event& event);
+};
+
+void RUN_EVENTBUS_TESTS(void);
+
+void test_METHOD_publish_SHOULD_not_deliver_the_event_before_dispatchEvents(void);
+void test_METHOD_dispatchEvents_WITH_queued_events_SHOULD_deliver_them_to_all_subscribers(void);
+void test_METHOD_dispatchEvents_WITH_filtered_subscriber_SHOULD_deliver_only_matching_events(void);
+void test_METHOD_publish_WITH_full_ring_SHOULD_return_false_AND_count_dropped_event(void);
+void test_METHOD_unsubscribe_SHOULD_stop_delivering_events(void);
+void test_METHOD_dispatchEvents_WITH_changes_of_one_remote_SHOULD_deliver_one_merged_change(void);
+void test_METHOD_dispatchEvents_WITH_deleted_remote_SHOULD_deliver_only_the_deletion(void);
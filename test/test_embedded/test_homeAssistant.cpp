@@ -0,0 +1,93 @@
+#include <unity.h>
+#include <Arduino.h>
+
+#include <config.h>
+#include <remote.h>
+#include <homeAssistant.h>
+#include "./test_homeAssistant.h"
+
+const char TEST_DEVICE_ID[] = "esprtsomfy_5ccf7f0a1b2c";
+
+// TEST HOME ASSISTANT
+// ############################################################################
+
+void RUN_HOMEASSISTANT_TESTS(void)
+{
+  RUN_TEST(test_METHOD_formatDeviceId_WITH_mac_address_SHOULD_keep_lowercase_digits);
+  RUN_TEST(test_METHOD_formatCoverDiscoveryTopic_WITH_remote_id_SHOULD_format_config_topic);
+  RUN_TEST(test_METHOD_writeCoverDiscovery_WITH_remote_SHOULD_write_compact_config);
+  RUN_TEST(test_METHOD_writeCoverDiscovery_WITH_special_chars_SHOULD_escape_name);
+  RUN_TEST(test_METHOD_writeCoverDiscovery_WITH_longest_remote_SHOULD_fit_in_buffer);
+  RUN_TEST(test_METHOD_writeCoverDiscovery_WITH_small_buffer_SHOULD_return_zero);
+}
+
+void test_METHOD_formatDeviceId_WITH_mac_address_SHOULD_keep_lowercase_digits(void)
+{
+  char deviceId[MAX_DEVICE_ID_LENGTH];
+
+  formatDeviceId(deviceId, "5C:CF:7F:0A:1B:2C");
+
+  TEST_ASSERT_EQUAL_STRING(TEST_DEVICE_ID, deviceId);
+}
+
+void test_METHOD_formatCoverDiscoveryTopic_WITH_remote_id_SHOULD_format_config_topic(void)
+{
+  char topic[MAX_MQTT_TOPIC_LENGTH];
+
+  size_t length = formatCoverDiscoveryTopic(topic, sizeof(topic), 4294967295);
+
+  TEST_ASSERT_EQUAL_STRING("homeassistant/cover/esprtsomfy_4294967295/config", topic);
+  TEST_ASSERT_EQUAL(strlen(topic), length);
+}
+
+void test_METHOD_writeCoverDiscovery_WITH_remote_SHOULD_write_compact_config(void)
+{
+  Remote remote = { 12, 3, "Living" };
+  char buffer[MAX_DISCOVERY_PAYLOAD_LENGTH];
+
+  size_t length = writeCoverDiscovery(buffer, sizeof(buffer), remote, TEST_DEVICE_ID);
+
+  String expected = String("{\"~\":\"esprtsomfy/remotes/12\",\"name\":\"Living\",")
+      + "\"uniq_id\":\"esprtsomfy_5ccf7f0a1b2c_12\",\"cmd_t\":\"~/set/action\","
+      + "\"pl_open\":\"up\",\"pl_cls\":\"down\",\"pl_stop\":\"stop\",\"opt\":true,"
+      + "\"dev\":{\"ids\":[\"esprtsomfy_5ccf7f0a1b2c\"],\"name\":\"" + APP_NAME
+      + "\",\"mdl\":\"RTS bridge\",\"sw\":\"" + FIRMWARE_VERSION + "\"}}";
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), buffer);
+  TEST_ASSERT_EQUAL(expected.length(), length);
+}
+
+void test_METHOD_writeCoverDiscovery_WITH_special_chars_SHOULD_escape_name(void)
+{
+  Remote remote = { 1, 0, "a\"b\\c\n" };
+  char buffer[MAX_DISCOVERY_PAYLOAD_LENGTH];
+
+  writeCoverDiscovery(buffer, sizeof(buffer), remote, TEST_DEVICE_ID);
+
+  TEST_ASSERT_NOT_NULL(strstr(buffer, "\"name\":\"a\\\"b\\\\c\\u000a\","));
+}
+
+void test_METHOD_writeCoverDiscovery_WITH_longest_remote_SHOULD_fit_in_buffer(void)
+{
+  // Each char of the name is escaped as \u00XX
+  Remote remote = { 4294967295, 0, "" };
+  memset(remote.name, '\x01', MAX_REMOTE_NAME_LENGTH - 1);
+  remote.name[MAX_REMOTE_NAME_LENGTH - 1] = '\0';
+  char buffer[MAX_DISCOVERY_PAYLOAD_LENGTH];
+
+  size_t length = writeCoverDiscovery(buffer, sizeof(buffer), remote, TEST_DEVICE_ID);
+
+  TEST_ASSERT_TRUE(length > 0);
+  // With the topic and the header of the packet
+  TEST_ASSERT_TRUE(length + MAX_MQTT_TOPIC_LENGTH + 8 <= MQTT_BUFFER_SIZE);
+}
+
+void test_METHOD_writeCoverDiscovery_WITH_small_buffer_SHOULD_return_zero(void)
+{
+  Remote remote = { 12, 3, "Living" };
+  char buffer[64];
+
+  size_t length = writeCoverDiscovery(buffer, sizeof(buffer), remote, TEST_DEVICE_ID);
+
+  TEST_ASSERT_EQUAL(0, length);
+  TEST_ASSERT_EQUAL_STRING("", buffer);
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <homeAssistant.h>
+
+void RUN_HOMEASSISTANT_TESTS(void);
+
+void test_METHOD_formatDeviceId_WITH_mac_address_SHOULD_keep_lowercase_digits(void);
+void test_METHOD_formatCoverDiscoveryTopic_WITH_remote_id_SHOULD_format_config_topic(void);
+void test_METHOD_writeCoverDiscovery_WITH_remote_SHOULD_write_compact_config(void);
+void test_METHOD_writeCoverDiscovery_WITH_special_chars_SHOULD_escape_name(void);
+void test_METHOD_writeCoverDiscovery_WITH_longest_remote_SHOULD_fit_in_buffer(void);
+void test_METHOD_writeCoverDiscovery_WITH_small_buffer_SHOULD_return_zero(void);
@@ -1,7 +1,13 @@
 #include <Arduino.h>
+#include <StreamString.h>
 #include <unity.h>
 
 #include <remote.h>
+#include <remoteState.h>
+#include <scene.h>
+#include <event.h>
+#include <command.h>
+#include <schedule.h>
 #include <networks.h>
 #include <mqttConfig.h>
 #include <systemInfos.h>
@@ -17,12 +23,31 @@ void RUN_JSONSERIALIZER_TESTS(void)
   RUN_TEST(test_METHOD_serializeRemote_WITH_remote_SHOULD_return_string);
   RUN_TEST(test_METHOD_serializeRemotes_WITH_two_remotes_SHOULD_return_string);
   RUN_TEST(test_METHOD_serializeRemotes_WITH_one_remote_SHOULD_return_string);
+  RUN_TEST(test_METHOD_serializeRemotes_WITH_print_output_SHOULD_write_array);
+  RUN_TEST(test_METHOD_serializeRemoteState_WITH_state_SHOULD_write_in_buffer);
+  RUN_TEST(test_METHOD_serializeRemoteState_WITH_small_buffer_SHOULD_return_zero);
+  RUN_TEST(test_METHOD_serializeRemotesInventory_WITH_print_output_SHOULD_write_ids_and_names);
   RUN_TEST(test_METHOD_serializeNetworkConfig_WITH_config_SHOULD_return_string);
   RUN_TEST(test_METHOD_serializeSystemInfos_WITH_info_SHOULD_return_string);
   RUN_TEST(test_METHOD_serializeSystemInfos_WITH_info_extended_SHOULD_return_string);
+  RUN_TEST(test_METHOD_serializeLoadStats_WITH_stats_SHOULD_return_string);
+  RUN_TEST(test_METHOD_serializeUpdateProgress_WITH_progress_SHOULD_return_string);
   RUN_TEST(test_METHOD_serializeNetworks_WITH_one_network_SHOULD_return_string);
   RUN_TEST(test_METHOD_serializeNetworks_WITH_two_networks_SHOULD_return_string);
+  RUN_TEST(test_METHOD_serializeNetworkScan_WITH_scan_SHOULD_return_string);
   RUN_TEST(test_METHOD_serializeMQTTConfig_WITH_config_SHOULD_return_string);
+  RUN_TEST(test_METHOD_serializeScene_WITH_scene_SHOULD_return_string);
+  RUN_TEST(test_METHOD_serializeScenes_WITH_one_scene_SHOULD_return_string);
+  RUN_TEST(test_METHOD_serializeBatchReport_WITH_report_SHOULD_return_string);
+  RUN_TEST(test_METHOD_serializeCommand_WITH_command_SHOULD_return_string);
+  RUN_TEST(test_METHOD_serializeCommand_WITH_failed_command_SHOULD_return_error_AND_timings);
+  RUN_TEST(test_METHOD_serializeCommand_WITH_refused_command_SHOULD_return_error_without_timings);
+  RUN_TEST(test_METHOD_deserializeCommandRequest_WITH_json_SHOULD_fill_request);
+  RUN_TEST(test_METHOD_serializeSchedules_WITH_one_schedule_SHOULD_return_string);
+  RUN_TEST(test_METHOD_serializeRemoteChange_WITH_change_SHOULD_return_only_changed_fields);
+  RUN_TEST(test_METHOD_deserializeFields_WITH_json_SHOULD_return_fields_as_strings);
+  RUN_TEST(test_METHOD_deserializeBatchRequests_WITH_json_SHOULD_run_requests_in_order);
+  RUN_TEST(test_METHOD_serializeBatchResponse_WITH_print_output_SHOULD_write_object);
 }
 
 void test_MEHTOD_serializeMessage_WITH_message_SHOULD_return_string(void)
@@ -44,13 +69,13 @@ void test_METHOD_serializeRemote_WITH_remote_SHOULD_return_string(void)
 {
   Remote remoteA = { 1, 0, "foo" };
   String serializedA = serializerTest.serializeRemote(remoteA);
-  String expectedA = "{\"id\":1,\"rolling_code\":0,\"name\":\"foo\"}";
+  String expectedA = "{\"id\":1,\"rolling_code\":0,\"name\":\"foo\",\"dedup_window_ms\":0}";
 
   TEST_ASSERT_EQUAL_STRING(expectedA.c_str(), serializedA.c_str());
 
-  Remote remoteB = { 42, 42, "bar" };
+  Remote remoteB = { 42, 42, "bar", 1000 };
   String serializedB = serializerTest.serializeRemote(remoteB);
-  String expectedB = "{\"id\":42,\"rolling_code\":42,\"name\":\"bar\"}";
+  String expectedB = "{\"id\":42,\"rolling_code\":42,\"name\":\"bar\",\"dedup_window_ms\":1000}";
 
   TEST_ASSERT_EQUAL_STRING(expectedB.c_str(), serializedB.c_str());
 }
@@ -58,13 +83,13 @@ void test_METHOD_serializeRemote_WITH_remote_SHOULD_return_string(void)
 void test_METHOD_serializeRemotes_WITH_two_remotes_SHOULD_return_string(void)
 {
   Remote remoteA = { 1, 0, "foo" };
-  Remote remoteB = { 42, 42, "bar" };
+  Remote remoteB = { 42, 42, "bar", 1000 };
 
   Remote remotes[2] = { remoteA, remoteB };
 
   String serialized = serializerTest.serializeRemotes(remotes, 2);
-  String expected = "[{\"id\":1,\"rolling_code\":0,\"name\":\"foo\"},{\"id\":42,\"rolling_code\":"
-                    "42,\"name\":\"bar\"}]";
+  String expected = "[{\"id\":1,\"rolling_code\":0,\"name\":\"foo\",\"dedup_window_ms\":0},"
+                    "{\"id\":42,\"rolling_code\":42,\"name\":\"bar\",\"dedup_window_ms\":1000}]";
 
   TEST_ASSERT_EQUAL_STRING(expected.c_str(), serialized.c_str());
 }
@@ -76,11 +101,66 @@ void test_METHOD_serializeRemotes_WITH_one_remote_SHOULD_return_string(void)
   Remote remotes[] = { remoteA };
 
   String serialized = serializerTest.serializeRemotes(remotes, 1);
-  String expected = "[{\"id\":1,\"rolling_code\":0,\"name\":\"foo\"}]";
+  String expected = "[{\"id\":1,\"rolling_code\":0,\"name\":\"foo\",\"dedup_window_ms\":0}]";
 
   TEST_ASSERT_EQUAL_STRING(expected.c_str(), serialized.c_str());
 }
 
+void test_METHOD_serializeRemotes_WITH_print_output_SHOULD_write_array(void)
+{
+  Remote remoteA = { 1, 0, "foo" };
+  Remote remoteB = { 0, 0, "" };
+  Remote remoteC = { 42, 42, "bar", 1000 };
+
+  Remote remotes[3] = { remoteA, remoteB, remoteC };
+
+  StreamString output;
+  serializerTest.serializeRemotes(output, remotes, 3);
+  String expected = "[{\"id\":1,\"rolling_code\":0,\"name\":\"foo\",\"dedup_window_ms\":0},"
+                    "{\"id\":42,\"rolling_code\":42,\"name\":\"bar\",\"dedup_window_ms\":1000}]";
+
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), output.c_str());
+}
+
+void test_METHOD_serializeRemoteState_WITH_state_SHOULD_write_in_buffer(void)
+{
+  RemoteState state = { { 1, 43, "foo" }, RemoteAction::UP, 1760000000 };
+  char output[128];
+
+  size_t length = serializerTest.serializeRemoteState(state, output, sizeof(output));
+  const char* expected = "{\"id\":1,\"rolling_code\":43,\"name\":\"foo\",\"last_action\":\"up\","
+                         "\"updated_at\":1760000000}";
+
+  TEST_ASSERT_EQUAL_STRING(expected, output);
+  TEST_ASSERT_EQUAL(strlen(expected), length);
+
+  RemoteState unknown = { { 1, 43, "foo" } };
+  serializerTest.serializeRemoteState(unknown, output, sizeof(output));
+
+  TEST_ASSERT_EQUAL_STRING(
+      "{\"id\":1,\"rolling_code\":43,\"name\":\"foo\",\"last_action\":null,\"updated_at\":null}",
+      output);
+}
+
+void test_METHOD_serializeRemoteState_WITH_small_buffer_SHOULD_return_zero(void)
+{
+  RemoteState state = { { 1, 43, "foo" }, RemoteAction::UP, 1760000000 };
+  char output[32];
+
+  TEST_ASSERT_EQUAL(0, serializerTest.serializeRemoteState(state, output, sizeof(output)));
+}
+
+void test_METHOD_serializeRemotesInventory_WITH_print_output_SHOULD_write_ids_and_names(void)
+{
+  Remote remotes[3] = { { 1, 0, "foo" }, { 0, 0, "" }, { 42, 42, "bar" } };
+
+  StreamString output;
+  serializerTest.serializeRemotesInventory(output, remotes, 3);
+
+  TEST_ASSERT_EQUAL_STRING(
+      "[{\"id\":1,\"name\":\"foo\"},{\"id\":42,\"name\":\"bar\"}]", output.c_str());
+}
+
 void test_METHOD_serializeNetworkConfig_WITH_config_SHOULD_return_string(void)
 {
   NetworkConfiguration config = { "foo", "bar" };
@@ -106,7 +186,39 @@ void test_METHOD_serializeSystemInfos_WITH_info_extended_SHOULD_return_string(vo
   SystemInfosExtended infos = { "1.0.0", "FF:FF:FF:FF:FF:FF", "255.255.255.255" };
 
   String serialized = serializerTest.serializeSystemInfos(infos);
-  String expected = "{\"version\":\"1.0.0\",\"mac\":\"FF:FF:FF:FF:FF:FF\",\"ip\":\"255.255.255.255\"}";
+  String expected = "{\"version\":\"1.0.0\",\"mac\":\"FF:FF:FF:FF:FF:FF\",\"ip\":\"255.255.255.255\","
+                    "\"suppressed_commands\":0}";
+
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), serialized.c_str());
+}
+
+void test_METHOD_serializeLoadStats_WITH_stats_SHOULD_return_string(void)
+{
+  LoadStats stats = { 2, 20480, 3, 1 };
+
+  String serialized = serializerTest.serializeLoadStats(stats);
+  String expected = "{\"in_flight\":2,\"free_heap\":20480,\"shed_limit\":3,\"shed_heap\":1}";
+
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), serialized.c_str());
+}
+
+void test_METHOD_serializeNetworkScan_WITH_scan_SHOULD_return_string(void)
+{
+  NetworkScan scan = { true, true, 42, 5 };
+
+  String serialized = serializerTest.serializeNetworkScan(scan);
+  String expected = "{\"scanning\":true,\"scanned\":true,\"age\":42,\"count\":5}";
+
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), serialized.c_str());
+}
+
+void test_METHOD_serializeUpdateProgress_WITH_progress_SHOULD_return_string(void)
+{
+  UpdateProgress progress = { UpdateTarget::FIRMWARE, UpdateState::RUNNING, 1024, 4096 };
+
+  String serialized = serializerTest.serializeUpdateProgress(progress);
+  String expected
+      = "{\"target\":\"firmware\",\"state\":\"running\",\"written\":1024,\"total\":4096}";
 
   TEST_ASSERT_EQUAL_STRING(expected.c_str(), serialized.c_str());
 }
@@ -145,4 +257,198 @@ void test_METHOD_serializeMQTTConfig_WITH_config_SHOULD_return_string(void)
                     "\"password\":\"bar\"}";
 
   TEST_ASSERT_EQUAL_STRING(expected.c_str(), serialized.c_str());
-}
\ No newline at end of file
+}
+
+void test_METHOD_serializeScene_WITH_scene_SHOULD_return_string(void)
+{
+  Scene scene = { 1, "south", 2, { { 42, RemoteAction::DOWN }, { 43, RemoteAction::UP } } };
+
+  String serialized = serializerTest.serializeScene(scene);
+  String expected = "{\"id\":1,\"name\":\"south\",\"actions\":[{\"remote_id\":42,\"action\":"
+                    "\"down\"},{\"remote_id\":43,\"action\":\"up\"}]}";
+
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), serialized.c_str());
+}
+
+void test_METHOD_serializeScenes_WITH_one_scene_SHOULD_return_string(void)
+{
+  Scene sceneA = { 1, "south", 1, { { 42, RemoteAction::STOP } } };
+  Scene sceneB = { 0, "", 0, {} };
+
+  Scene scenes[] = { sceneA, sceneB };
+
+  String serialized = serializerTest.serializeScenes(scenes, 2);
+  String expected
+      = "[{\"id\":1,\"name\":\"south\",\"actions\":[{\"remote_id\":42,\"action\":\"stop\"}]}]";
+
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), serialized.c_str());
+}
+
+void test_METHOD_serializeBatchReport_WITH_report_SHOULD_return_string(void)
+{
+  BatchReport report
+      = { 2, { { 1, RemoteAction::UP }, { 2, RemoteAction::DOWN } }, { 7, 8 } };
+
+  String serialized = serializerTest.serializeBatchReport(report);
+  String expected = "{\"operations\":2,\"commands\":[{\"request_id\":7,\"remote_id\":1,"
+                    "\"action\":\"up\"},{\"request_id\":8,\"remote_id\":2,\"action\":\"down\"}]}";
+
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), serialized.c_str());
+}
+
+void test_METHOD_serializeCommand_WITH_command_SHOULD_return_string(void)
+{
+  Command commandA = { 7, 1, RemoteAction::DOWN, CommandStatus::PENDING, 0 };
+  String serializedA = serializerTest.serializeCommand(commandA);
+  String expectedA
+      = "{\"request_id\":7,\"remote_id\":1,\"action\":\"down\",\"status\":\"pending\"}";
+
+  TEST_ASSERT_EQUAL_STRING(expectedA.c_str(), serializedA.c_str());
+
+  Command commandB = { 7, 1, RemoteAction::DOWN, CommandStatus::DONE, 43 };
+  String serializedB = serializerTest.serializeCommand(commandB);
+  String expectedB = "{\"request_id\":7,\"remote_id\":1,\"action\":\"down\",\"status\":\"done\","
+                     "\"rolling_code\":43,\"timings\":{\"queue_us\":0,\"transmit_us\":0,"
+                     "\"commit_us\":0,\"total_us\":0}}";
+
+  TEST_ASSERT_EQUAL_STRING(expectedB.c_str(), serializedB.c_str());
+}
+
+void test_METHOD_serializeCommand_WITH_failed_command_SHOULD_return_error_AND_timings(void)
+{
+  Command command = { 7, 1, RemoteAction::UP, CommandStatus::FAILED, 0, 0, "key",
+    CommandError::COMMIT_FAILED, 0, { 1200, 104000, 9000, 114500 } };
+  String serialized = serializerTest.serializeCommand(command);
+  String expected = "{\"request_id\":7,\"remote_id\":1,\"action\":\"up\",\"status\":\"failed\","
+                    "\"error\":\"commit_failed\",\"idempotency_key\":\"key\",\"timings\":{"
+                    "\"queue_us\":1200,\"transmit_us\":104000,\"commit_us\":9000,"
+                    "\"total_us\":114500}}";
+
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), serialized.c_str());
+}
+
+void test_METHOD_serializeCommand_WITH_refused_command_SHOULD_return_error_without_timings(void)
+{
+  Command command = { 0, 1, RemoteAction::UNKNOWN, CommandStatus::FAILED, 0, 0, "",
+    CommandError::INVALID_ACTION };
+  String serialized = serializerTest.serializeCommand(command);
+
+  TEST_ASSERT_EQUAL_STRING("{\"request_id\":null,\"remote_id\":1,\"action\":null,"
+                           "\"status\":\"failed\",\"error\":\"invalid_action\"}",
+      serialized.c_str());
+}
+
+void test_METHOD_deserializeCommandRequest_WITH_json_SHOULD_fill_request(void)
+{
+  CommandRequest requestA = { RemoteAction::UNKNOWN, "" };
+  bool isValidA = serializerTest.deserializeCommandRequest(
+      "{\"action\":\"up\",\"idempotency_key\":\"foo\"}", requestA);
+
+  TEST_ASSERT_TRUE(isValidA);
+  TEST_ASSERT_TRUE(requestA.action == RemoteAction::UP);
+  TEST_ASSERT_EQUAL_STRING("foo", requestA.idempotencyKey);
+
+  CommandRequest requestB = { RemoteAction::UNKNOWN, "" };
+  bool isValidB = serializerTest.deserializeCommandRequest("{\"action\":", requestB);
+
+  TEST_ASSERT_FALSE(isValidB);
+}
+
+void test_METHOD_serializeSchedules_WITH_one_schedule_SHOULD_return_string(void)
+{
+  Schedule scheduleA = { 1, 42, RemoteAction::DOWN, ScheduleTrigger::SUNSET, -15, "* * * * 1-5" };
+  Schedule scheduleB = { 0, 0, RemoteAction::UNKNOWN, ScheduleTrigger::UNKNOWN, 0, "" };
+
+  Schedule schedules[] = { scheduleA, scheduleB };
+
+  String serialized = serializerTest.serializeSchedules(schedules, 2);
+  String expected = "[{\"id\":1,\"remote_id\":42,\"action\":\"down\",\"trigger\":\"sunset\","
+                    "\"offset\":-15,\"cron\":\"* * * * 1-5\"}]";
+
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), serialized.c_str());
+}
+
+void test_METHOD_serializeRemoteChange_WITH_change_SHOULD_return_only_changed_fields(void)
+{
+  RemoteChange changeA = { REMOTE_CHANGE_LAST_ACTION | REMOTE_CHANGE_ROLLING_CODE, RemoteAction::UP,
+    { 1, 43, "foo" } };
+  String serializedA = serializerTest.serializeRemoteChange(changeA);
+
+  TEST_ASSERT_EQUAL_STRING(
+      "{\"id\":1,\"rolling_code\":43,\"last_action\":\"up\"}", serializedA.c_str());
+
+  RemoteChange changeB = { REMOTE_CHANGE_DELETED, RemoteAction::UNKNOWN, { 1, 43, "foo" } };
+  String serializedB = serializerTest.serializeRemoteChange(changeB);
+
+  TEST_ASSERT_EQUAL_STRING("{\"id\":1,\"deleted\":true}", serializedB.c_str());
+
+  RemoteChange changeC
+      = { REMOTE_CHANGE_DEDUP_WINDOW, RemoteAction::UNKNOWN, { 1, 43, "foo", 2500 } };
+  String serializedC = serializerTest.serializeRemoteChange(changeC);
+
+  TEST_ASSERT_EQUAL_STRING("{\"id\":1,\"dedup_window_ms\":2500}", serializedC.c_str());
+}
+void test_METHOD_deserializeFields_WITH_json_SHOULD_return_fields_as_strings(void)
+{
+  BodyFields fields;
+  TEST_ASSERT_TRUE(
+      serializerTest.deserializeFields("{\"name\":\"foo\",\"rolling_code\":42}", fields));
+  TEST_ASSERT_EQUAL(2, fields.size);
+
+  String name;
+  TEST_ASSERT_TRUE(fields.get("name", name));
+  TEST_ASSERT_EQUAL_STRING("foo", name.c_str());
+
+  String rollingCode;
+  TEST_ASSERT_TRUE(fields.get("rolling_code", rollingCode));
+  TEST_ASSERT_EQUAL_STRING("42", rollingCode.c_str());
+
+  String missing;
+  TEST_ASSERT_FALSE(fields.get("action", missing));
+  TEST_ASSERT_FALSE(serializerTest.deserializeFields("[1]", fields));
+  TEST_ASSERT_EQUAL(0, fields.size);
+}
+
+void test_METHOD_deserializeBatchRequests_WITH_json_SHOULD_run_requests_in_order(void)
+{
+  String runs;
+  BatchRequestCallback callback = [&runs](const BatchRequest& request)
+  {
+    String action = "-";
+    request.body.get("action", action);
+    runs += String(request.method) + " " + request.path + " " + action + ";";
+  };
+
+  int sizeA = serializerTest.deserializeBatchRequests(
+      "{\"requests\":[{\"method\":\"POST\",\"path\":\"/api/v1/remotes/1/action\","
+      "\"body\":{\"action\":\"up\"}},{\"method\":\"DELETE\",\"path\":\"/api/v1/remotes/2\"}]}",
+      2, callback);
+
+  TEST_ASSERT_EQUAL(2, sizeA);
+  TEST_ASSERT_EQUAL_STRING(
+      "POST /api/v1/remotes/1/action up;DELETE /api/v1/remotes/2 -;", runs.c_str());
+
+  runs = "";
+  int sizeB = serializerTest.deserializeBatchRequests(
+      "{\"requests\":[{\"method\":\"GET\",\"path\":\"/a\"},{\"method\":\"GET\",\"path\":\"/b\"},"
+      "{\"method\":\"GET\",\"path\":\"/c\"}]}",
+      2, callback);
+
+  TEST_ASSERT_EQUAL(-1, sizeB);
+  TEST_ASSERT_EQUAL_STRING("", runs.c_str());
+
+  // The malformed one is the last, the first one is not run either
+  int sizeC = serializerTest.deserializeBatchRequests(
+      "{\"requests\":[{\"method\":\"GET\",\"path\":\"/a\"},{\"path\":\"/b\"}]}", 2, callback);
+
+  TEST_ASSERT_EQUAL(-1, sizeC);
+  TEST_ASSERT_EQUAL_STRING("", runs.c_str());
+}
+
+void test_METHOD_serializeBatchResponse_WITH_print_output_SHOULD_write_object(void)
+{
+  StreamString output;
+  serializerTest.serializeBatchResponse(output, BatchResponse { 202, "{\"request_id\":7}" });
+
+  TEST_ASSERT_EQUAL_STRING("{\"status\":202,\"body\":{\"request_id\":7}}", output.c_str());
+}
@@ -6,9 +6,27 @@ void test_MEHTOD_serializeMessage_WITH_message_SHOULD_return_string(void);
 void test_METHOD_serializeRemote_WITH_remote_SHOULD_return_string(void);
 void test_METHOD_serializeRemotes_WITH_two_remotes_SHOULD_return_string(void);
 void test_METHOD_serializeRemotes_WITH_one_remote_SHOULD_return_string(void);
+void test_METHOD_serializeRemotes_WITH_print_output_SHOULD_write_array(void);
+void test_METHOD_serializeRemoteState_WITH_state_SHOULD_write_in_buffer(void);
+void test_METHOD_serializeRemoteState_WITH_small_buffer_SHOULD_return_zero(void);
+void test_METHOD_serializeRemotesInventory_WITH_print_output_SHOULD_write_ids_and_names(void);
 void test_METHOD_serializeNetworkConfig_WITH_config_SHOULD_return_string(void);
 void test_METHOD_serializeSystemInfos_WITH_info_SHOULD_return_string(void);
 void test_METHOD_serializeSystemInfos_WITH_info_extended_SHOULD_return_string(void);
+void test_METHOD_serializeLoadStats_WITH_stats_SHOULD_return_string(void);
+void test_METHOD_serializeNetworkScan_WITH_scan_SHOULD_return_string(void);
+void test_METHOD_serializeUpdateProgress_WITH_progress_SHOULD_return_string(void);
 void test_METHOD_serializeNetworks_WITH_one_network_SHOULD_return_string(void);
 void test_METHOD_serializeNetworks_WITH_two_networks_SHOULD_return_string(void);
-void test_METHOD_serializeMQTTConfig_WITH_config_SHOULD_return_string(void);
\ No newline at end of file
+void test_METHOD_serializeMQTTConfig_WITH_config_SHOULD_return_string(void);
+void test_METHOD_serializeScene_WITH_scene_SHOULD_return_string(void);
+void test_METHOD_serializeScenes_WITH_one_scene_SHOULD_return_string(void);
+void test_METHOD_serializeBatchReport_WITH_report_SHOULD_return_string(void);
+void test_METHOD_serializeCommand_WITH_command_SHOULD_return_string(void);
+void test_METHOD_serializeCommand_WITH_failed_command_SHOULD_return_error_AND_timings(void);
+void test_METHOD_serializeCommand_WITH_refused_command_SHOULD_return_error_without_timings(void);
+void test_METHOD_deserializeCommandRequest_WITH_json_SHOULD_fill_request(void);
+void test_METHOD_serializeSchedules_WITH_one_schedule_SHOULD_return_string(void);
+void test_METHOD_serializeRemoteChange_WITH_change_SHOULD_return_only_changed_fields(void);void test_METHOD_deserializeFields_WITH_json_SHOULD_return_fields_as_strings(void);
+void test_METHOD_deserializeBatchRequests_WITH_json_SHOULD_run_requests_in_order(void);
+void test_METHOD_serializeBatchResponse_WITH_print_output_SHOULD_write_object(void);
@@ -0,0 +1,101 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <StreamString.h>
+
+#include <metrics.h>
+#include "./test_metrics.h"
+
+// TEST METRICS
+// ############################################################################
+
+void RUN_METRICS_TESTS(void)
+{
+  RUN_TEST(test_METHOD_observe_WITH_durations_SHOULD_count_them_in_buckets);
+  RUN_TEST(test_METHOD_increment_WITH_counter_SHOULD_increment_only_this_counter);
+  RUN_TEST(test_METHOD_write_WITH_histogram_SHOULD_write_cumulative_buckets);
+  RUN_TEST(test_METHOD_write_WITH_gauge_SHOULD_write_it_after_the_counters);
+  RUN_TEST(test_METHOD_writeHistogram_WITH_labels_SHOULD_label_each_sample);
+}
+
+void test_METHOD_observe_WITH_durations_SHOULD_count_them_in_buckets(void)
+{
+  Metrics::observe(HistogramId::TRANSMIT, 1000); // Bounds are inclusive
+  Metrics::observe(HistogramId::TRANSMIT, 1001);
+  Metrics::observe(HistogramId::TRANSMIT, 2000000);
+
+  const Histogram& histogram = Metrics::getHistogram(HistogramId::TRANSMIT);
+
+  TEST_ASSERT_EQUAL(1, histogram.buckets[0]);
+  TEST_ASSERT_EQUAL(1, histogram.buckets[1]);
+  TEST_ASSERT_EQUAL(1, histogram.buckets[METRIC_BUCKETS - 1]);
+  TEST_ASSERT_EQUAL(3, histogram.count);
+  TEST_ASSERT_TRUE(histogram.sum == 2002001);
+  TEST_ASSERT_EQUAL(0, Metrics::getHistogram(HistogramId::COMMAND).count);
+}
+
+void test_METHOD_increment_WITH_counter_SHOULD_increment_only_this_counter(void)
+{
+  Metrics::increment(CounterId::COMMANDS_FAILED);
+  Metrics::increment(CounterId::COMMANDS_FAILED);
+
+  TEST_ASSERT_EQUAL(2, Metrics::getCounter(CounterId::COMMANDS_FAILED));
+  TEST_ASSERT_EQUAL(0, Metrics::getCounter(CounterId::COMMANDS_DONE));
+}
+
+void test_METHOD_write_WITH_histogram_SHOULD_write_cumulative_buckets(void)
+{
+  Metrics::observe(HistogramId::COMMAND, 800);
+  Metrics::observe(HistogramId::COMMAND, 7000);
+
+  StreamString output;
+  Metrics::write(output, static_cast<uint8_t>(HistogramId::COMMAND));
+  String expected = "# TYPE esprtsomfy_command_duration_seconds histogram\n"
+                    "esprtsomfy_command_duration_seconds_bucket{le=\"0.001\"} 1\n"
+                    "esprtsomfy_command_duration_seconds_bucket{le=\"0.005\"} 1\n"
+                    "esprtsomfy_command_duration_seconds_bucket{le=\"0.01\"} 2\n"
+                    "esprtsomfy_command_duration_seconds_bucket{le=\"0.05\"} 2\n"
+                    "esprtsomfy_command_duration_seconds_bucket{le=\"0.1\"} 2\n"
+                    "esprtsomfy_command_duration_seconds_bucket{le=\"0.5\"} 2\n"
+                    "esprtsomfy_command_duration_seconds_bucket{le=\"+Inf\"} 2\n"
+                    "esprtsomfy_command_duration_seconds_sum 0.007800\n"
+                    "esprtsomfy_command_duration_seconds_count 2\n";
+
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), output.c_str());
+
+  StreamString counter;
+  Metrics::write(counter, static_cast<uint8_t>(HistogramId::COUNT));
+
+  TEST_ASSERT_EQUAL_STRING("# TYPE esprtsomfy_commands_done_total counter\n"
+                           "esprtsomfy_commands_done_total 0\n",
+      counter.c_str());
+}
+
+void test_METHOD_write_WITH_gauge_SHOULD_write_it_after_the_counters(void)
+{
+  Metrics::set(GaugeId::MQTT_OUTBOX_DEPTH, 3);
+  Metrics::set(GaugeId::MQTT_OUTBOX_DEPTH, 2);
+
+  StreamString output;
+  Metrics::write(output,
+      static_cast<uint8_t>(HistogramId::COUNT) + static_cast<uint8_t>(CounterId::COUNT));
+
+  TEST_ASSERT_EQUAL(2, Metrics::getGauge(GaugeId::MQTT_OUTBOX_DEPTH));
+  TEST_ASSERT_EQUAL_STRING("# TYPE esprtsomfy_mqtt_outbox_depth gauge\n"
+                           "esprtsomfy_mqtt_outbox_depth 2\n",
+      output.c_str());
+}
+
+void test_METHOD_writeHistogram_WITH_labels_SHOULD_label_each_sample(void)
+{
+  Histogram histogram;
+  histogram.observe(600000);
+
+  StreamString output;
+  Metrics::writeHistogram(output, "foo", "route=\"/\"", histogram);
+
+  TEST_ASSERT_TRUE(output.startsWith("foo_bucket{route=\"/\",le=\"0.001\"} 0\n"));
+  String end = "foo_bucket{route=\"/\",le=\"+Inf\"} 1\nfoo_sum{route=\"/\"} 0.600000\n"
+               "foo_count{route=\"/\"} 1\n";
+  TEST_ASSERT_EQUAL_STRING(
+      end.c_str(), output.substring(output.length() - end.length()).c_str());
+}
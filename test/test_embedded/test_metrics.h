@@ -0,0 +1,11 @@
+#pragma once
+
+#include <metrics.h>
+
+void RUN_METRICS_TESTS(void);
+
+void test_METHOD_observe_WITH_durations_SHOULD_count_them_in_buckets(void);
+void test_METHOD_increment_WITH_counter_SHOULD_increment_only_this_counter(void);
+void test_METHOD_write_WITH_histogram_SHOULD_write_cumulative_buckets(void);
+void test_METHOD_write_WITH_gauge_SHOULD_write_it_after_the_counters(void);
+void test_METHOD_writeHistogram_WITH_labels_SHOULD_label_each_sample(void);
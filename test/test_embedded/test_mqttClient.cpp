@@ -0,0 +1,348 @@
+#include <unity.h>
+#include <Arduino.h>
+
+#include <config.h>
+#include <event.h>
+#include <remote.h>
+#include <mqttConfig.h>
+#include <mqttTopic.h>
+#include <controller.h>
+#include <mqttClient.h>
+#include <homeAssistant.h>
+#include <jsonSerializer.h>
+#include "./test_controller.h"
+#include "./test_scheduler.h"
+#include "./test_mqttClient.h"
+
+// Fake MQTT connection
+void FakeMQTTConnection::reset()
+{
+  this->brokerUp = true;
+  this->connections = 0;
+  this->restartBroker();
+}
+
+void FakeMQTTConnection::restartBroker()
+{
+  this->m_connected = false;
+  this->subscriptionsCount = 0;
+  this->messagesCount = 0;
+}
+
+int FakeMQTTConnection::findLast(const char* topic) const
+{
+  for (int i = this->messagesCount - 1; i >= 0; i--)
+  {
+    if (this->messages[i].topic == topic)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void FakeMQTTConnection::receive(const char* topic, const char* payload)
+{
+  char topicCopy[MAX_MQTT_TOPIC_LENGTH];
+  strcpy(topicCopy, topic);
+  this->m_callback(topicCopy, (uint8_t*)payload, strlen(payload));
+}
+
+void FakeMQTTConnection::begin(
+    const char* broker, const uint16_t port, MQTTReceiveCallback callback)
+{
+  this->m_callback = callback;
+}
+
+bool FakeMQTTConnection::isNetworkConnected() { return true; }
+
+bool FakeMQTTConnection::connect(const char* clientId, const char* username, const char* password)
+{
+  this->m_connected = this->brokerUp;
+  if (this->m_connected)
+  {
+    this->connections++;
+  }
+  return this->m_connected;
+}
+
+bool FakeMQTTConnection::isConnected() { return this->m_connected; }
+
+int FakeMQTTConnection::getState() { return this->m_connected ? 0 : -1; }
+
+void FakeMQTTConnection::loop() { }
+
+bool FakeMQTTConnection::subscribe(const char* filter)
+{
+  if (!this->m_connected || this->subscriptionsCount == FAKE_MQTT_MAX_SUBSCRIPTIONS)
+  {
+    return false;
+  }
+  this->subscriptions[this->subscriptionsCount++] = filter;
+  return true;
+}
+
+bool FakeMQTTConnection::publish(const char* topic, const char* payload, const bool retained)
+{
+  if (!this->m_connected || this->messagesCount == FAKE_MQTT_MAX_MESSAGES)
+  {
+    return false;
+  }
+  this->messages[this->messagesCount++] = FakeMQTTMessage { topic, payload, retained };
+  return true;
+}
+
+Print* FakeMQTTConnection::beginPublish(const char* topic, const size_t length, const bool retained)
+{
+  if (!this->m_connected)
+  {
+    return nullptr;
+  }
+  this->m_stream.value = "";
+  this->m_streamTopic = topic;
+  this->m_streamRetained = retained;
+  return &this->m_stream;
+}
+
+bool FakeMQTTConnection::endPublish()
+{
+  return this->publish(
+      this->m_streamTopic.c_str(), this->m_stream.value.c_str(), this->m_streamRetained);
+}
+
+// TEST MQTT CLIENT
+// ############################################################################
+
+FakeDatabase mqttDatabaseFake;
+FakeNetworkClient mqttNetworkClientFake;
+FakeTransmitter mqttTransmitterFake;
+FakeSystemManager mqttSystemManagerFake;
+FakeClock mqttClockFake;
+FakeMQTTConnection mqttConnectionFake;
+JSONSerializer mqttSerializer;
+
+Controller mqttController(
+    &mqttDatabaseFake, &mqttNetworkClientFake, &mqttTransmitterFake, &mqttSystemManagerFake);
+// Global, its outbox does not fit on the stack
+MQTTClient mqttClientTested(&mqttController, &mqttSerializer, &mqttClockFake, &mqttConnectionFake);
+
+// The state of the 2 remotes of FakeDatabase, with their discovery configs
+const unsigned short REPUBLISHED_MESSAGES = 3 + 2 * (HOME_ASSISTANT_DISCOVERY ? 3 : 2);
+
+/**
+ * @brief Connect to the fake broker, as main.cpp does once the WiFi is up.
+ *
+ */
+static void connectClient()
+{
+  MQTTConfiguration conf;
+  strcpy(conf.broker, "broker.local");
+  conf.username[0] = '\0';
+  conf.password[0] = '\0';
+  mqttConnectionFake.reset();
+  TEST_ASSERT_TRUE(mqttClientTested.connect(conf));
+}
+
+/**
+ * @brief Run the main loop, a drain interval apart.
+ *
+ * @param loops The number of loops
+ */
+static void runLoops(const unsigned short loops)
+{
+  for (unsigned short i = 0; i < loops; i++)
+  {
+    delay(MQTT_OUTBOX_DRAIN_INTERVAL_MS);
+    mqttClientTested.handleMessages();
+  }
+}
+
+void RUN_MQTTCLIENT_TESTS(void)
+{
+  RUN_TEST(test_METHOD_connect_WITH_broker_up_SHOULD_subscribe_AND_defer_the_state);
+  RUN_TEST(
+      test_METHOD_handleMessages_WITH_connection_SHOULD_republish_one_retained_message_per_drain);
+  RUN_TEST(test_METHOD_handleMessages_WITH_broker_restarted_SHOULD_subscribe_AND_republish_again);
+  RUN_TEST(test_METHOD_notified_WITH_change_during_republish_SHOULD_publish_it_after_the_state);
+  RUN_TEST(test_METHOD_notified_WITH_two_acks_while_disconnected_SHOULD_publish_both_in_order);
+  RUN_TEST(test_METHOD_notified_WITH_rename_while_disconnected_SHOULD_publish_the_discovery_config);
+  RUN_TEST(test_METHOD_receive_WITH_replayed_done_command_SHOULD_ack_it_at_once);
+  RUN_TEST(test_METHOD_receive_WITH_command_merged_with_another_key_SHOULD_ack_it_with_its_key);
+}
+
+void test_METHOD_connect_WITH_broker_up_SHOULD_subscribe_AND_defer_the_state(void)
+{
+  connectClient();
+
+  TEST_ASSERT_EQUAL(1, mqttConnectionFake.connections);
+  TEST_ASSERT_EQUAL(MQTT_SUBSCRIPTIONS_COUNT, mqttConnectionFake.subscriptionsCount);
+  for (uint8_t i = 0; i < MQTT_SUBSCRIPTIONS_COUNT; i++)
+  {
+    TEST_ASSERT_EQUAL_STRING(
+        MQTT_SUBSCRIPTIONS[i].filter, mqttConnectionFake.subscriptions[i].c_str());
+  }
+  // Nothing is published from connect(), the main loop publishes the state
+  TEST_ASSERT_EQUAL(0, mqttConnectionFake.messagesCount);
+}
+
+void test_METHOD_handleMessages_WITH_connection_SHOULD_republish_one_retained_message_per_drain(
+    void)
+{
+  connectClient();
+
+  for (unsigned short i = 1; i <= REPUBLISHED_MESSAGES; i++)
+  {
+    runLoops(1);
+    TEST_ASSERT_EQUAL(i, mqttConnectionFake.messagesCount);
+  }
+  runLoops(5);
+  TEST_ASSERT_EQUAL(REPUBLISHED_MESSAGES, mqttConnectionFake.messagesCount);
+
+  for (unsigned short i = 0; i < mqttConnectionFake.messagesCount; i++)
+  {
+    TEST_ASSERT_TRUE(mqttConnectionFake.messages[i].retained);
+  }
+  TEST_ASSERT_EQUAL_STRING(
+      "esprtsomfy/system/infos/version", mqttConnectionFake.messages[0].topic.c_str());
+  int index = mqttConnectionFake.findLast("esprtsomfy/remotes/1/rolling_code");
+  TEST_ASSERT_GREATER_OR_EQUAL(0, index);
+  TEST_ASSERT_EQUAL_STRING("42", mqttConnectionFake.messages[index].payload.c_str());
+  index = mqttConnectionFake.findLast("esprtsomfy/remotes/2/name");
+  TEST_ASSERT_GREATER_OR_EQUAL(0, index);
+  TEST_ASSERT_EQUAL_STRING("bar", mqttConnectionFake.messages[index].payload.c_str());
+  if (HOME_ASSISTANT_DISCOVERY)
+  {
+    char topic[MAX_MQTT_TOPIC_LENGTH];
+    formatCoverDiscoveryTopic(topic, sizeof(topic), 2);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, mqttConnectionFake.findLast(topic));
+  }
+}
+
+void test_METHOD_handleMessages_WITH_broker_restarted_SHOULD_subscribe_AND_republish_again(void)
+{
+  connectClient();
+  runLoops(REPUBLISHED_MESSAGES);
+
+  mqttConnectionFake.restartBroker();
+  runLoops(1); // Reconnected at once
+  TEST_ASSERT_EQUAL(2, mqttConnectionFake.connections);
+  TEST_ASSERT_EQUAL(MQTT_SUBSCRIPTIONS_COUNT, mqttConnectionFake.subscriptionsCount);
+
+  runLoops(REPUBLISHED_MESSAGES + 5);
+  TEST_ASSERT_EQUAL(REPUBLISHED_MESSAGES, mqttConnectionFake.messagesCount);
+  int index = mqttConnectionFake.findLast("esprtsomfy/remotes/1/name");
+  TEST_ASSERT_GREATER_OR_EQUAL(0, index);
+  TEST_ASSERT_EQUAL_STRING("foo", mqttConnectionFake.messages[index].payload.c_str());
+  TEST_ASSERT_TRUE(mqttConnectionFake.messages[index].retained);
+}
+
+void test_METHOD_notified_WITH_change_during_republish_SHOULD_publish_it_after_the_state(void)
+{
+  connectClient();
+  runLoops(2);
+
+  Event event = { EventType::REMOTE };
+  event.remote
+      = RemoteChange { REMOTE_CHANGE_NAME, RemoteAction::UNKNOWN, Remote { 1, 42, "Desk" } };
+  mqttClientTested.notified(event);
+  runLoops(REPUBLISHED_MESSAGES + 5);
+
+  // The name read from the database first, then the newer one
+  const int index = mqttConnectionFake.findLast("esprtsomfy/remotes/1/name");
+  TEST_ASSERT_GREATER_OR_EQUAL(0, index);
+  TEST_ASSERT_EQUAL_STRING("Desk", mqttConnectionFake.messages[index].payload.c_str());
+  TEST_ASSERT_GREATER_THAN(REPUBLISHED_MESSAGES - 1, index);
+}
+
+void test_METHOD_notified_WITH_two_acks_while_disconnected_SHOULD_publish_both_in_order(void)
+{
+  connectClient();
+  runLoops(REPUBLISHED_MESSAGES);
+  mqttConnectionFake.restartBroker();
+
+  Event event = { EventType::COMMAND };
+  event.command = Command { 1, 1, RemoteAction::UP, CommandStatus::DONE, 43 };
+  mqttClientTested.notified(event);
+  event.command = Command { 2, 1, RemoteAction::DOWN, CommandStatus::DONE, 44 };
+  mqttClientTested.notified(event);
+  runLoops(REPUBLISHED_MESSAGES + 5);
+
+  unsigned short acks = 0;
+  for (unsigned short i = 0; i < mqttConnectionFake.messagesCount; i++)
+  {
+    const FakeMQTTMessage& message = mqttConnectionFake.messages[i];
+    if (message.topic != "esprtsomfy/remotes/1/ack")
+    {
+      continue;
+    }
+    acks++;
+    TEST_ASSERT_FALSE(message.retained);
+    const String requestId = String("\"request_id\":") + acks;
+    TEST_ASSERT_NOT_NULL(strstr(message.payload.c_str(), requestId.c_str()));
+  }
+  TEST_ASSERT_EQUAL(2, acks);
+}
+
+void test_METHOD_notified_WITH_rename_while_disconnected_SHOULD_publish_the_discovery_config(void)
+{
+  if (!HOME_ASSISTANT_DISCOVERY)
+  {
+    return; // Nothing is discovered
+  }
+  connectClient();
+  runLoops(REPUBLISHED_MESSAGES);
+  mqttConnectionFake.restartBroker();
+
+  Event event = { EventType::REMOTE };
+  event.remote
+      = RemoteChange { REMOTE_CHANGE_NAME, RemoteAction::UNKNOWN, Remote { 1, 42, "Desk" } };
+  mqttClientTested.notified(event);
+  runLoops(REPUBLISHED_MESSAGES + 5);
+
+  // The config read from the database first, then the newer one
+  char topic[MAX_MQTT_TOPIC_LENGTH];
+  formatCoverDiscoveryTopic(topic, sizeof(topic), 1);
+  const int index = mqttConnectionFake.findLast(topic);
+  TEST_ASSERT_GREATER_THAN(REPUBLISHED_MESSAGES - 1, index);
+  TEST_ASSERT_NOT_NULL(strstr(mqttConnectionFake.messages[index].payload.c_str(), "Desk"));
+  TEST_ASSERT_TRUE(mqttConnectionFake.messages[index].retained);
+}
+
+void test_METHOD_receive_WITH_replayed_done_command_SHOULD_ack_it_at_once(void)
+{
+  connectClient();
+  runLoops(REPUBLISHED_MESSAGES);
+  const char* payload = "{\"action\":\"up\",\"idempotency_key\":\"retried\"}";
+  mqttConnectionFake.receive("esprtsomfy/remotes/1/set/action", payload);
+  mqttController.handleCommands();
+  const unsigned short published = mqttConnectionFake.messagesCount;
+
+  mqttConnectionFake.receive("esprtsomfy/remotes/1/set/action", payload);
+
+  TEST_ASSERT_EQUAL(published + 1, mqttConnectionFake.messagesCount);
+  const FakeMQTTMessage& ack = mqttConnectionFake.messages[published];
+  TEST_ASSERT_EQUAL_STRING("esprtsomfy/remotes/1/ack", ack.topic.c_str());
+  TEST_ASSERT_NOT_NULL(strstr(ack.payload.c_str(), "\"status\":\"done\""));
+  TEST_ASSERT_NOT_NULL(strstr(ack.payload.c_str(), "\"idempotency_key\":\"retried\""));
+}
+
+void test_METHOD_receive_WITH_command_merged_with_another_key_SHOULD_ack_it_with_its_key(void)
+{
+  connectClient();
+  runLoops(REPUBLISHED_MESSAGES);
+  FakeDatabase::remoteDedupWindow = 60000;
+  mqttConnectionFake.receive(
+      "esprtsomfy/remotes/1/set/action", "{\"action\":\"down\",\"idempotency_key\":\"first\"}");
+  const unsigned short published = mqttConnectionFake.messagesCount;
+
+  mqttConnectionFake.receive(
+      "esprtsomfy/remotes/1/set/action", "{\"action\":\"down\",\"idempotency_key\":\"second\"}");
+  FakeDatabase::remoteDedupWindow = 0;
+  mqttController.handleCommands(); // Drain the queue for the next tests
+
+  TEST_ASSERT_EQUAL(published + 1, mqttConnectionFake.messagesCount);
+  const FakeMQTTMessage& ack = mqttConnectionFake.messages[published];
+  TEST_ASSERT_EQUAL_STRING("esprtsomfy/remotes/1/ack", ack.topic.c_str());
+  TEST_ASSERT_NOT_NULL(strstr(ack.payload.c_str(), "\"status\":\"pending\""));
+  TEST_ASSERT_NOT_NULL(strstr(ack.payload.c_str(), "\"idempotency_key\":\"second\""));
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <mqttClient.h>
+#include <mqttConnectionAbs.h>
+
+const unsigned short FAKE_MQTT_MAX_MESSAGES = 64;
+const unsigned short FAKE_MQTT_MAX_SUBSCRIPTIONS = 8;
+
+struct FakeMQTTMessage
+{
+  String topic;
+  String payload;
+  bool retained;
+};
+
+/**
+ * @brief A payload streamed by the client.
+ *
+ */
+class FakeMQTTPayload : public Print
+{
+  public:
+  String value;
+
+  size_t write(uint8_t character)
+  {
+    this->value += (char)character;
+    return 1;
+  }
+};
+
+/**
+ * @brief A broker in memory, in place of PubSubClient. It keeps what is published and subscribed.
+ *
+ */
+class FakeMQTTConnection : public MQTTConnectionAbstract
+{
+  public:
+  // For tests
+  bool brokerUp = true;
+  unsigned short connections = 0;
+  String subscriptions[FAKE_MQTT_MAX_SUBSCRIPTIONS];
+  unsigned short subscriptionsCount = 0;
+  FakeMQTTMessage messages[FAKE_MQTT_MAX_MESSAGES];
+  unsigned short messagesCount = 0;
+
+  void reset();
+  void restartBroker(); // The connection is closed, the subscriptions and messages are lost
+  int findLast(const char* topic) const; // Index of the last message on the topic, or -1
+  void receive(const char* topic, const char* payload); // A message sent by the broker
+
+  void begin(const char* broker, const uint16_t port, MQTTReceiveCallback callback);
+  bool isNetworkConnected();
+  bool connect(const char* clientId, const char* username, const char* password);
+  bool isConnected();
+  int getState();
+  void loop();
+  bool subscribe(const char* filter);
+  bool publish(const char* topic, const char* payload, const bool retained);
+  Print* beginPublish(const char* topic, const size_t length, const bool retained);
+  bool endPublish();
+
+  private:
+  bool m_connected = false;
+  MQTTReceiveCallback m_callback = nullptr;
+  FakeMQTTPayload m_stream;
+  String m_streamTopic;
+  bool m_streamRetained = false;
+};
+
+void RUN_MQTTCLIENT_TESTS(void);
+
+void test_METHOD_connect_WITH_broker_up_SHOULD_subscribe_AND_defer_the_state(void);
+void test_METHOD_handleMessages_WITH_connection_SHOULD_republish_one_retained_message_per_drain(
+    void);
+void test_METHOD_handleMessages_WITH_broker_restarted_SHOULD_subscribe_AND_republish_again(void);
+void test_METHOD_notified_WITH_change_during_republish_SHOULD_publish_it_after_the_state(void);
+void test_METHOD_notified_WITH_two_acks_while_disconnected_SHOULD_publish_both_in_order(void);
+void test_METHOD_notified_WITH_rename_while_disconnected_SHOULD_publish_the_discovery_config(void);
+void test_METHOD_receive_WITH_replayed_done_command_SHOULD_ack_it_at_once(void);
+void test_METHOD_receive_WITH_command_merged_with_another_key_SHOULD_ack_it_with_its_key(void);
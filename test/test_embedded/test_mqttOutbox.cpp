@@ -0,0 +1,150 @@
+#include <unity.h>
+#include <Arduino.h>
+
+#include <config.h>
+#include <metrics.h>
+#include <mqttOutbox.h>
+#include "./test_mqttOutbox.h"
+
+// TEST MQTT OUTBOX
+// ############################################################################
+
+void RUN_MQTTOUTBOX_TESTS(void)
+{
+  RUN_TEST(test_METHOD_push_WITH_messages_SHOULD_publish_the_events_first_in_order);
+  RUN_TEST(test_METHOD_push_WITH_same_topic_SHOULD_keep_the_latest_value);
+  RUN_TEST(test_METHOD_push_WITH_two_acks_on_same_remote_SHOULD_keep_both);
+  RUN_TEST(test_METHOD_push_WITH_full_outbox_SHOULD_drop_the_oldest);
+  RUN_TEST(test_METHOD_push_WITH_full_outbox_and_drop_newest_SHOULD_refuse_the_message);
+  RUN_TEST(test_METHOD_push_WITH_too_long_payload_SHOULD_drop_it);
+}
+
+void test_METHOD_push_WITH_messages_SHOULD_publish_the_events_first_in_order(void)
+{
+  MQTTOutbox outbox(true);
+  MQTTMessage message;
+
+  TEST_ASSERT_TRUE(outbox.push("esprtsomfy/remotes/1/name", "foo", true));
+  TEST_ASSERT_TRUE(outbox.push("esprtsomfy/remotes/1/last_action", "up", false));
+  TEST_ASSERT_TRUE(outbox.push("esprtsomfy/remotes/2/name", "bar", true));
+
+  TEST_ASSERT_EQUAL(3, outbox.size());
+  TEST_ASSERT_EQUAL(3, Metrics::getGauge(GaugeId::MQTT_OUTBOX_DEPTH));
+  TEST_ASSERT_TRUE(outbox.peek(message));
+  TEST_ASSERT_EQUAL_STRING("esprtsomfy/remotes/1/last_action", message.topic);
+  TEST_ASSERT_EQUAL_STRING("up", message.payload);
+  TEST_ASSERT_FALSE(message.retained);
+  outbox.pop();
+  TEST_ASSERT_TRUE(outbox.peek(message));
+  TEST_ASSERT_EQUAL_STRING("esprtsomfy/remotes/1/name", message.topic);
+  TEST_ASSERT_EQUAL_STRING("foo", message.payload);
+  TEST_ASSERT_TRUE(message.retained);
+  outbox.pop();
+  TEST_ASSERT_TRUE(outbox.peek(message));
+  TEST_ASSERT_EQUAL_STRING("esprtsomfy/remotes/2/name", message.topic);
+  outbox.pop();
+  TEST_ASSERT_FALSE(outbox.peek(message));
+  TEST_ASSERT_EQUAL(0, Metrics::getGauge(GaugeId::MQTT_OUTBOX_DEPTH));
+}
+
+void test_METHOD_push_WITH_same_topic_SHOULD_keep_the_latest_value(void)
+{
+  MQTTOutbox outbox(true);
+  MQTTMessage message;
+
+  outbox.push("esprtsomfy/remotes/1/rolling_code", "1", true);
+  outbox.push("esprtsomfy/remotes/2/rolling_code", "7", true);
+  for (unsigned short i = 2; i <= 100; i++)
+  {
+    outbox.push("esprtsomfy/remotes/1/rolling_code", String(i).c_str(), true);
+  }
+
+  // The newer value is queued after the other topics
+  TEST_ASSERT_EQUAL(2, outbox.size());
+  TEST_ASSERT_TRUE(outbox.peek(message));
+  TEST_ASSERT_EQUAL_STRING("esprtsomfy/remotes/2/rolling_code", message.topic);
+  outbox.pop();
+  TEST_ASSERT_TRUE(outbox.peek(message));
+  TEST_ASSERT_EQUAL_STRING("100", message.payload);
+  TEST_ASSERT_EQUAL(99, Metrics::getCounter(CounterId::MQTT_OUTBOX_COMPACTED));
+  TEST_ASSERT_EQUAL(0, Metrics::getCounter(CounterId::MQTT_OUTBOX_DROPPED));
+}
+
+void test_METHOD_push_WITH_two_acks_on_same_remote_SHOULD_keep_both(void)
+{
+  MQTTOutbox outbox(true);
+  MQTTMessage message;
+
+  TEST_ASSERT_TRUE(outbox.push("esprtsomfy/remotes/1/ack", "{\"request_id\":1}", false));
+  TEST_ASSERT_TRUE(outbox.push("esprtsomfy/remotes/1/ack", "{\"request_id\":2}", false));
+
+  TEST_ASSERT_EQUAL(2, outbox.size());
+  TEST_ASSERT_TRUE(outbox.peek(message));
+  TEST_ASSERT_EQUAL_STRING("{\"request_id\":1}", message.payload);
+  outbox.pop();
+  TEST_ASSERT_TRUE(outbox.peek(message));
+  TEST_ASSERT_EQUAL_STRING("{\"request_id\":2}", message.payload);
+  TEST_ASSERT_EQUAL(0, Metrics::getCounter(CounterId::MQTT_OUTBOX_COMPACTED));
+}
+
+void test_METHOD_push_WITH_full_outbox_SHOULD_drop_the_oldest(void)
+{
+  MQTTOutbox outbox(true);
+  MQTTMessage message;
+  char topic[MAX_MQTT_TOPIC_LENGTH];
+
+  // About 32 bytes each, more than the states fit
+  for (unsigned short i = 100; i < 200; i++)
+  {
+    sprintf(topic, "esprtsomfy/remotes/%u/name", i);
+    TEST_ASSERT_TRUE(outbox.push(topic, "foo", true));
+  }
+
+  const unsigned short size = outbox.size();
+  const unsigned short dropped = 100 - size;
+  TEST_ASSERT_EQUAL(MQTT_OUTBOX_STATES_SIZE / 32, size);
+  TEST_ASSERT_EQUAL(dropped, Metrics::getCounter(CounterId::MQTT_OUTBOX_DROPPED));
+  TEST_ASSERT_EQUAL(size, Metrics::getGauge(GaugeId::MQTT_OUTBOX_DEPTH));
+  TEST_ASSERT_TRUE(outbox.peek(message));
+  sprintf(topic, "esprtsomfy/remotes/%u/name", 200 - size);
+  TEST_ASSERT_EQUAL_STRING(topic, message.topic);
+
+  // The events have their own room
+  TEST_ASSERT_TRUE(outbox.push("esprtsomfy/remotes/1/ack", "{}", false));
+  TEST_ASSERT_EQUAL(size + 1, outbox.size());
+}
+
+void test_METHOD_push_WITH_full_outbox_and_drop_newest_SHOULD_refuse_the_message(void)
+{
+  MQTTOutbox outbox(false);
+  MQTTMessage message;
+  char payload[MAX_MQTT_OUTBOX_PAYLOAD_LENGTH];
+  memset(payload, 'a', sizeof(payload) - 1);
+  payload[sizeof(payload) - 1] = '\0';
+
+  unsigned short pushed = 0;
+  while (outbox.push("esprtsomfy/remotes/1/ack", payload, false))
+  {
+    pushed++;
+  }
+
+  TEST_ASSERT_EQUAL(MQTT_OUTBOX_EVENTS_SIZE / (25 + sizeof(payload)), pushed);
+  TEST_ASSERT_EQUAL(pushed, outbox.size());
+  TEST_ASSERT_EQUAL(1, Metrics::getCounter(CounterId::MQTT_OUTBOX_DROPPED));
+  TEST_ASSERT_TRUE(outbox.peek(message));
+  TEST_ASSERT_EQUAL_STRING("esprtsomfy/remotes/1/ack", message.topic);
+}
+
+void test_METHOD_push_WITH_too_long_payload_SHOULD_drop_it(void)
+{
+  MQTTOutbox outbox(true);
+  MQTTMessage message;
+  char payload[MAX_MQTT_OUTBOX_PAYLOAD_LENGTH + 1];
+  memset(payload, 'a', MAX_MQTT_OUTBOX_PAYLOAD_LENGTH);
+  payload[MAX_MQTT_OUTBOX_PAYLOAD_LENGTH] = '\0';
+
+  TEST_ASSERT_FALSE(outbox.push("esprtsomfy/remotes/1/ack", payload, false));
+  TEST_ASSERT_EQUAL(0, outbox.size());
+  TEST_ASSERT_FALSE(outbox.peek(message));
+  TEST_ASSERT_EQUAL(1, Metrics::getCounter(CounterId::MQTT_OUTBOX_DROPPED));
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <mqttOutbox.h>
+
+void RUN_MQTTOUTBOX_TESTS(void);
+
+void test_METHOD_push_WITH_messages_SHOULD_publish_the_events_first_in_order(void);
+void test_METHOD_push_WITH_same_topic_SHOULD_keep_the_latest_value(void);
+void test_METHOD_push_WITH_two_acks_on_same_remote_SHOULD_keep_both(void);
+void test_METHOD_push_WITH_full_outbox_SHOULD_drop_the_oldest(void);
+void test_METHOD_push_WITH_full_outbox_and_drop_newest_SHOULD_refuse_the_message(void);
+void test_METHOD_push_WITH_too_long_payload_SHOULD_drop_it(void);
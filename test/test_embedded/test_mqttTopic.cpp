@@ -0,0 +1,67 @@
+#include <unity.h>
+
+#include <mqttTopic.h>
+#include "./test_mqttTopic.h"
+
+// TEST MQTT TOPIC
+// ############################################################################
+
+void RUN_MQTTTOPIC_TESTS(void)
+{
+  RUN_TEST(test_METHOD_parseMQTTTopic_WITH_remote_topics_SHOULD_return_type_and_id);
+  RUN_TEST(test_METHOD_parseMQTTTopic_WITH_batch_OR_scene_topic_SHOULD_return_type);
+  RUN_TEST(test_METHOD_parseMQTTTopic_WITH_unknown_topic_SHOULD_return_false);
+  RUN_TEST(test_METHOD_parseMQTTTopic_WITH_invalid_id_SHOULD_return_false);
+}
+
+void test_METHOD_parseMQTTTopic_WITH_remote_topics_SHOULD_return_type_and_id(void)
+{
+  MQTTTopic parsed;
+
+  TEST_ASSERT_TRUE(parseMQTTTopic("esprtsomfy/remotes/1234567/set/action", parsed));
+  TEST_ASSERT_TRUE(parsed.type == MQTTTopicType::REMOTE_ACTION);
+  TEST_ASSERT_EQUAL(1234567, parsed.id);
+
+  TEST_ASSERT_TRUE(parseMQTTTopic("esprtsomfy/remotes/42/set/name", parsed));
+  TEST_ASSERT_TRUE(parsed.type == MQTTTopicType::REMOTE_NAME);
+  TEST_ASSERT_EQUAL(42, parsed.id);
+}
+
+void test_METHOD_parseMQTTTopic_WITH_batch_OR_scene_topic_SHOULD_return_type(void)
+{
+  MQTTTopic parsed;
+
+  // "set" is a literal level here, not an id
+  TEST_ASSERT_TRUE(parseMQTTTopic("esprtsomfy/remotes/set/actions", parsed));
+  TEST_ASSERT_TRUE(parsed.type == MQTTTopicType::REMOTES_ACTIONS);
+  TEST_ASSERT_EQUAL(0, parsed.id);
+
+  TEST_ASSERT_TRUE(parseMQTTTopic("esprtsomfy/scenes/3/set/run", parsed));
+  TEST_ASSERT_TRUE(parsed.type == MQTTTopicType::SCENE_RUN);
+  TEST_ASSERT_EQUAL(3, parsed.id);
+}
+
+void test_METHOD_parseMQTTTopic_WITH_unknown_topic_SHOULD_return_false(void)
+{
+  MQTTTopic parsed;
+
+  TEST_ASSERT_FALSE(parseMQTTTopic("esprtsomfy/remotes/12/set", parsed));
+  TEST_ASSERT_FALSE(parseMQTTTopic("esprtsomfy/remotes/12/set/action/", parsed));
+  TEST_ASSERT_FALSE(parseMQTTTopic("esprtsomfy/remotes/12/set/actionx", parsed));
+  TEST_ASSERT_FALSE(parseMQTTTopic("esprtsomfy/remotes/12/ack", parsed));
+  TEST_ASSERT_FALSE(parseMQTTTopic("other/remotes/12/set/action", parsed));
+  TEST_ASSERT_FALSE(parseMQTTTopic("a/b/c/d/e/f/g/h/i", parsed));
+  TEST_ASSERT_FALSE(parseMQTTTopic("", parsed));
+  TEST_ASSERT_FALSE(parseMQTTTopic(nullptr, parsed));
+  TEST_ASSERT_TRUE(parsed.type == MQTTTopicType::UNKNOWN);
+}
+
+void test_METHOD_parseMQTTTopic_WITH_invalid_id_SHOULD_return_false(void)
+{
+  MQTTTopic parsed;
+
+  TEST_ASSERT_FALSE(parseMQTTTopic("esprtsomfy/remotes/12a/set/action", parsed));
+  TEST_ASSERT_FALSE(parseMQTTTopic("esprtsomfy/remotes//set/action", parsed));
+  TEST_ASSERT_FALSE(parseMQTTTopic("esprtsomfy/remotes/4294967296/set/action", parsed));
+  TEST_ASSERT_TRUE(parseMQTTTopic("esprtsomfy/remotes/4294967295/set/action", parsed));
+}
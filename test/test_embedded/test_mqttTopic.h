@@ -0,0 +1,10 @@
+#pragma once
+
+#include <mqttTopic.h>
+
+void RUN_MQTTTOPIC_TESTS(void);
+
+void test_METHOD_parseMQTTTopic_WITH_remote_topics_SHOULD_return_type_and_id(void);
+void test_METHOD_parseMQTTTopic_WITH_batch_OR_scene_topic_SHOULD_return_type(void);
+void test_METHOD_parseMQTTTopic_WITH_unknown_topic_SHOULD_return_false(void);
+void test_METHOD_parseMQTTTopic_WITH_invalid_id_SHOULD_return_false(void);
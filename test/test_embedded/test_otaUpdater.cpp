@@ -0,0 +1,181 @@
+#include <unity.h>
+#include <Arduino.h>
+
+#include <sha256.h>
+#include <otaUpdater.h>
+#include "./test_otaUpdater.h"
+
+const size_t TEST_IMAGE_SIZE = 300;
+// sha256 of the bytes i * 7 for i in [0, 300[
+const char* TEST_IMAGE_SHA256 = "9A76B8AF8F16F19D60DE2B3999C22F9D10BE4395C90EA3BFC5EB6CD6254243AF";
+
+void fillImage(uint8_t image[TEST_IMAGE_SIZE])
+{
+  for (size_t i = 0; i < TEST_IMAGE_SIZE; i++)
+  {
+    image[i] = i * 7;
+  }
+}
+
+// FAKE PARTITION
+// ############################################################################
+
+bool FakePartition::begin(const UpdateTarget target, const size_t size)
+{
+  this->written = 0;
+  this->ended = false;
+  this->aborted = false;
+  return size <= FAKE_PARTITION_SIZE;
+}
+
+size_t FakePartition::write(const uint8_t* data, const size_t length)
+{
+  if (this->written + length > FAKE_PARTITION_SIZE)
+  {
+    return 0;
+  }
+  memcpy(this->flash + this->written, data, length);
+  this->written += length;
+  return length;
+}
+
+bool FakePartition::end()
+{
+  this->ended = true;
+  return true;
+}
+
+void FakePartition::abort() { this->aborted = true; }
+
+// TEST OTA UPDATER
+// ############################################################################
+
+void RUN_OTAUPDATER_TESTS(void)
+{
+  RUN_TEST(test_METHOD_finishHex_WITH_known_vectors_SHOULD_return_digest);
+  RUN_TEST(test_METHOD_end_WITH_chunked_image_and_right_sha_SHOULD_install_image);
+  RUN_TEST(test_METHOD_end_WITH_wrong_sha_SHOULD_abort_update);
+  RUN_TEST(test_METHOD_write_WITH_image_larger_than_announced_SHOULD_abort_update);
+  RUN_TEST(test_METHOD_begin_WITH_invalid_sha_SHOULD_return_error);
+  RUN_TEST(test_METHOD_begin_WITH_running_update_SHOULD_return_error);
+}
+
+void test_METHOD_finishHex_WITH_known_vectors_SHOULD_return_digest(void)
+{
+  Sha256 sha256;
+  char hex[SHA256_HEX_LENGTH];
+
+  sha256.update(reinterpret_cast<const uint8_t*>("abc"), 3);
+  sha256.finishHex(hex);
+  TEST_ASSERT_EQUAL_STRING(
+      "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", hex);
+
+  // Two blocks, fed in uneven chunks
+  const char* message = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+  sha256.reset();
+  sha256.update(reinterpret_cast<const uint8_t*>(message), 5);
+  sha256.update(reinterpret_cast<const uint8_t*>(message) + 5, strlen(message) - 5);
+  sha256.finishHex(hex);
+  TEST_ASSERT_EQUAL_STRING(
+      "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1", hex);
+}
+
+void test_METHOD_end_WITH_chunked_image_and_right_sha_SHOULD_install_image(void)
+{
+  uint8_t image[TEST_IMAGE_SIZE];
+  fillImage(image);
+  FakePartition partition;
+  OtaUpdater updater(&partition);
+
+  TEST_ASSERT_TRUE(
+      updater.begin(UpdateTarget::FIRMWARE, TEST_IMAGE_SHA256, TEST_IMAGE_SIZE).isSuccess);
+  for (size_t offset = 0; offset < TEST_IMAGE_SIZE; offset += 64)
+  {
+    const size_t length = TEST_IMAGE_SIZE - offset < 64 ? TEST_IMAGE_SIZE - offset : 64;
+    Result<UpdateProgress> result = updater.write(image + offset, length);
+    TEST_ASSERT_TRUE(result.isSuccess);
+    TEST_ASSERT_EQUAL(offset + length, result.data.written);
+  }
+  Result<UpdateProgress> result = updater.end();
+
+  TEST_ASSERT_TRUE(result.isSuccess);
+  TEST_ASSERT_TRUE(result.data.state == UpdateState::DONE);
+  TEST_ASSERT_EQUAL(TEST_IMAGE_SIZE, result.data.total);
+  TEST_ASSERT_TRUE(partition.ended);
+  TEST_ASSERT_FALSE(partition.aborted);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(image, partition.flash, TEST_IMAGE_SIZE);
+}
+
+void test_METHOD_end_WITH_wrong_sha_SHOULD_abort_update(void)
+{
+  uint8_t image[TEST_IMAGE_SIZE];
+  fillImage(image);
+  image[TEST_IMAGE_SIZE - 1] ^= 0x01; // One bit flipped during the transfer
+  FakePartition partition;
+  OtaUpdater updater(&partition);
+
+  updater.begin(UpdateTarget::FILESYSTEM, TEST_IMAGE_SHA256, TEST_IMAGE_SIZE);
+  updater.write(image, TEST_IMAGE_SIZE);
+  Result<UpdateProgress> result = updater.end();
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_TRUE(result.data.state == UpdateState::FAILED);
+  TEST_ASSERT_FALSE(partition.ended);
+  TEST_ASSERT_TRUE(partition.aborted);
+  TEST_ASSERT_EQUAL_STRING(result.errorMsg.c_str(), updater.getError().c_str());
+}
+
+void test_METHOD_write_WITH_image_larger_than_announced_SHOULD_abort_update(void)
+{
+  uint8_t image[TEST_IMAGE_SIZE];
+  fillImage(image);
+  FakePartition partition;
+  OtaUpdater updater(&partition);
+
+  updater.begin(UpdateTarget::FIRMWARE, TEST_IMAGE_SHA256, 100);
+  TEST_ASSERT_TRUE(updater.write(image, 100).isSuccess);
+  Result<UpdateProgress> result = updater.write(image + 100, 1);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_TRUE(updater.getProgress().state == UpdateState::FAILED);
+  TEST_ASSERT_TRUE(partition.aborted);
+  TEST_ASSERT_FALSE(updater.write(image, 1).isSuccess);
+}
+
+void test_METHOD_begin_WITH_invalid_sha_SHOULD_return_error(void)
+{
+  FakePartition partition;
+  OtaUpdater updater(&partition);
+
+  TEST_ASSERT_FALSE(updater.begin(UpdateTarget::FIRMWARE, "", TEST_IMAGE_SIZE).isSuccess);
+  TEST_ASSERT_FALSE(updater.begin(UpdateTarget::FIRMWARE, nullptr, TEST_IMAGE_SIZE).isSuccess);
+  TEST_ASSERT_FALSE(updater
+                        .begin(UpdateTarget::FIRMWARE,
+                            "za76b8af8f16f19d60de2b3999c22f9d10be4395c90ea3bfc5eb6cd6254243af",
+                            TEST_IMAGE_SIZE)
+                        .isSuccess);
+  TEST_ASSERT_FALSE(
+      updater.begin(UpdateTarget::FIRMWARE, TEST_IMAGE_SHA256, FAKE_PARTITION_SIZE + 1)
+          .isSuccess);
+  TEST_ASSERT_TRUE(updater.getProgress().state == UpdateState::FAILED);
+  TEST_ASSERT_FALSE(partition.aborted);
+}
+
+void test_METHOD_begin_WITH_running_update_SHOULD_return_error(void)
+{
+  FakePartition partition;
+  OtaUpdater updater(&partition);
+
+  updater.begin(UpdateTarget::FIRMWARE, TEST_IMAGE_SHA256, TEST_IMAGE_SIZE);
+  Result<UpdateProgress> result
+      = updater.begin(UpdateTarget::FILESYSTEM, TEST_IMAGE_SHA256, TEST_IMAGE_SIZE);
+
+  TEST_ASSERT_FALSE(result.isSuccess);
+  TEST_ASSERT_TRUE(result.data.state == UpdateState::RUNNING);
+  TEST_ASSERT_TRUE(result.data.target == UpdateTarget::FIRMWARE);
+
+  updater.abort();
+  TEST_ASSERT_TRUE(partition.aborted);
+  TEST_ASSERT_TRUE(
+      updater.begin(UpdateTarget::FILESYSTEM, TEST_IMAGE_SHA256, TEST_IMAGE_SIZE).isSuccess);
+}
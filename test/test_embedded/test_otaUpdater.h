@@ -0,0 +1,29 @@
+#pragma once
+
+#include <update.h>
+#include <updatePartitionAbs.h>
+
+const size_t FAKE_PARTITION_SIZE = 512;
+
+class FakePartition : public UpdatePartitionAbstract
+{
+  public:
+  uint8_t flash[FAKE_PARTITION_SIZE];
+  size_t written = 0;
+  bool ended = false;
+  bool aborted = false;
+
+  bool begin(const UpdateTarget target, const size_t size);
+  size_t write(const uint8_t* data, const size_t length);
+  bool end();
+  void abort();
+};
+
+void RUN_OTAUPDATER_TESTS(void);
+
+void test_METHOD_finishHex_WITH_known_vectors_SHOULD_return_digest(void);
+void test_METHOD_end_WITH_chunked_image_and_right_sha_SHOULD_install_image(void);
+void test_METHOD_end_WITH_wrong_sha_SHOULD_abort_update(void);
+void test_METHOD_write_WITH_image_larger_than_announced_SHOULD_abort_update(void);
+void test_METHOD_begin_WITH_invalid_sha_SHOULD_return_error(void);
+void test_METHOD_begin_WITH_running_update_SHOULD_return_error(void);
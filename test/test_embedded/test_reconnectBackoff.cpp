@@ -0,0 +1,163 @@
+#include <unity.h>
+#include <Arduino.h>
+
+#include <metrics.h>
+#include <reconnectBackoff.h>
+#include "./test_reconnectBackoff.h"
+
+const uint32_t TEST_MIN_DELAY = 1000;
+const uint32_t TEST_MAX_DELAY = 60000;
+
+/**
+ * @brief A broker reachable outside of its outage
+ *
+ */
+struct MockBroker
+{
+  uint32_t downFrom;
+  uint32_t downUntil;
+  uint32_t connections = 0;
+
+  bool connect(const uint32_t now)
+  {
+    if (now >= this->downFrom && now < this->downUntil)
+    {
+      return false;
+    }
+    this->connections++;
+    return true;
+  }
+  bool isUp(const uint32_t now) const { return now < this->downFrom || now >= this->downUntil; }
+};
+
+// TEST RECONNECT BACKOFF
+// ############################################################################
+
+void RUN_RECONNECTBACKOFF_TESTS(void)
+{
+  RUN_TEST(test_METHOD_isDue_WITH_begin_SHOULD_attempt_at_once);
+  RUN_TEST(test_METHOD_failed_WITH_broker_down_SHOULD_double_wait_up_to_max);
+  RUN_TEST(test_METHOD_failed_WITH_jitter_SHOULD_wait_in_upper_half);
+  RUN_TEST(test_METHOD_succeeded_WITH_first_connection_SHOULD_not_count_reconnect);
+  RUN_TEST(test_METHOD_succeeded_WITH_lost_connection_SHOULD_count_time_to_recover);
+  RUN_TEST(test_METHOD_isDue_WITH_broker_restarted_SHOULD_reconnect_within_max_delay);
+}
+
+void test_METHOD_isDue_WITH_begin_SHOULD_attempt_at_once(void)
+{
+  ReconnectBackoff backoff(TEST_MIN_DELAY, TEST_MAX_DELAY);
+
+  backoff.begin(5000);
+
+  TEST_ASSERT_TRUE(backoff.isDue(5000));
+  TEST_ASSERT_FALSE(backoff.isConnected());
+}
+
+void test_METHOD_failed_WITH_broker_down_SHOULD_double_wait_up_to_max(void)
+{
+  const uint32_t expected[] = { 1000, 2000, 4000, 8000, 16000, 32000, 60000, 60000 };
+  ReconnectBackoff backoff(TEST_MIN_DELAY, TEST_MAX_DELAY);
+  backoff.begin(0);
+
+  uint32_t now = 0;
+  for (uint32_t wait : expected)
+  {
+    backoff.failed(now, 1000);
+    TEST_ASSERT_EQUAL(wait, backoff.getWait());
+    TEST_ASSERT_FALSE(backoff.isDue(now + wait - 1));
+    TEST_ASSERT_TRUE(backoff.isDue(now + wait));
+    now += wait;
+  }
+  TEST_ASSERT_EQUAL(8, backoff.getFailures());
+  TEST_ASSERT_EQUAL(8, Metrics::getCounter(CounterId::MQTT_CONNECT_FAILURES));
+}
+
+void test_METHOD_failed_WITH_jitter_SHOULD_wait_in_upper_half(void)
+{
+  ReconnectBackoff backoff(TEST_MIN_DELAY, TEST_MAX_DELAY);
+  backoff.begin(0);
+
+  backoff.failed(0, 0);
+  TEST_ASSERT_EQUAL(500, backoff.getWait());
+  backoff.failed(0, 500);
+  TEST_ASSERT_EQUAL(1500, backoff.getWait());
+  backoff.failed(0, 1000);
+  TEST_ASSERT_EQUAL(4000, backoff.getWait());
+}
+
+void test_METHOD_succeeded_WITH_first_connection_SHOULD_not_count_reconnect(void)
+{
+  ReconnectBackoff backoff(TEST_MIN_DELAY, TEST_MAX_DELAY);
+  backoff.begin(0);
+  backoff.failed(0, 1000);
+  backoff.failed(1000, 1000);
+
+  backoff.succeeded(3000);
+
+  TEST_ASSERT_TRUE(backoff.isConnected());
+  TEST_ASSERT_FALSE(backoff.isDue(100000));
+  TEST_ASSERT_EQUAL(0, backoff.getFailures());
+  TEST_ASSERT_EQUAL(0, Metrics::getCounter(CounterId::MQTT_RECONNECTS));
+  TEST_ASSERT_EQUAL(0, Metrics::getCounter(CounterId::MQTT_DISCONNECTED_SECONDS));
+}
+
+void test_METHOD_succeeded_WITH_lost_connection_SHOULD_count_time_to_recover(void)
+{
+  ReconnectBackoff backoff(TEST_MIN_DELAY, TEST_MAX_DELAY);
+  backoff.begin(0);
+  backoff.succeeded(0);
+
+  backoff.lost(10000);
+  TEST_ASSERT_TRUE(backoff.isDue(10000));
+  backoff.failed(10000, 1000);
+  backoff.failed(11000, 1000);
+  backoff.succeeded(13000);
+
+  TEST_ASSERT_EQUAL(1, Metrics::getCounter(CounterId::MQTT_RECONNECTS));
+  TEST_ASSERT_EQUAL(3, Metrics::getCounter(CounterId::MQTT_DISCONNECTED_SECONDS));
+
+  // The backoff starts over from the min delay
+  backoff.lost(20000);
+  backoff.failed(20000, 1000);
+  TEST_ASSERT_EQUAL(TEST_MIN_DELAY, backoff.getWait());
+}
+
+void test_METHOD_isDue_WITH_broker_restarted_SHOULD_reconnect_within_max_delay(void)
+{
+  // The broker is down 5 minutes, the loop runs every 10 ms
+  MockBroker broker = { 60000, 360000 };
+  ReconnectBackoff backoff(TEST_MIN_DELAY, TEST_MAX_DELAY);
+  backoff.begin(0);
+  uint32_t attempts = 0;
+  uint32_t reconnectedAt = 0;
+
+  for (uint32_t now = 0; now < 600000; now += 10)
+  {
+    if (backoff.isConnected() && !broker.isUp(now))
+    {
+      backoff.lost(now);
+    }
+    if (!backoff.isDue(now))
+    {
+      continue;
+    }
+    attempts++;
+    if (broker.connect(now))
+    {
+      backoff.succeeded(now);
+      reconnectedAt = now;
+      continue;
+    }
+    backoff.failed(now, (now * 7) % 1001);
+  }
+
+  TEST_ASSERT_TRUE(backoff.isConnected());
+  TEST_ASSERT_EQUAL(2, broker.connections);
+  TEST_ASSERT_TRUE(reconnectedAt >= 360000);
+  TEST_ASSERT_TRUE(reconnectedAt <= 360000 + TEST_MAX_DELAY);
+  // Spaced out by the backoff, not once per loop
+  TEST_ASSERT_TRUE(attempts < 20);
+  TEST_ASSERT_EQUAL(1, Metrics::getCounter(CounterId::MQTT_RECONNECTS));
+  TEST_ASSERT_EQUAL((reconnectedAt - 60000 + 500) / 1000,
+      Metrics::getCounter(CounterId::MQTT_DISCONNECTED_SECONDS));
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <reconnectBackoff.h>
+
+void RUN_RECONNECTBACKOFF_TESTS(void);
+
+void test_METHOD_isDue_WITH_begin_SHOULD_attempt_at_once(void);
+void test_METHOD_failed_WITH_broker_down_SHOULD_double_wait_up_to_max(void);
+void test_METHOD_failed_WITH_jitter_SHOULD_wait_in_upper_half(void);
+void test_METHOD_succeeded_WITH_first_connection_SHOULD_not_count_reconnect(void);
+void test_METHOD_succeeded_WITH_lost_connection_SHOULD_count_time_to_recover(void);
+void test_METHOD_isDue_WITH_broker_restarted_SHOULD_reconnect_within_max_delay(void);
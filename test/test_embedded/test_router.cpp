@@ -0,0 +1,128 @@
+#include <unity.h>
+#include <Arduino.h>
+
+#include <router.h>
+#include "./test_router.h"
+
+// Same bits as the methods of ESPAsyncWebServer
+const uint8_t TEST_GET = 0b00000001;
+const uint8_t TEST_POST = 0b00000010;
+const uint8_t TEST_DELETE = 0b00000100;
+
+// TEST ROUTER
+// ############################################################################
+
+void RUN_ROUTER_TESTS(void)
+{
+  RUN_TEST(test_METHOD_match_WITH_literal_path_SHOULD_return_route);
+  RUN_TEST(test_METHOD_match_WITH_numbers_SHOULD_capture_them_in_order);
+  RUN_TEST(test_METHOD_match_WITH_other_method_SHOULD_return_false);
+  RUN_TEST(test_METHOD_match_WITH_invalid_number_OR_extra_slash_SHOULD_return_false);
+  RUN_TEST(test_METHOD_match_WITH_literal_AND_capture_SHOULD_prefer_literal);
+  RUN_TEST(test_METHOD_addRoute_WITH_full_table_SHOULD_return_not_found);
+  RUN_TEST(test_METHOD_ROUTE_HEADERS_SHOULD_keep_the_headers_read_by_the_handlers);
+}
+
+void test_METHOD_match_WITH_literal_path_SHOULD_return_route(void)
+{
+  Router router;
+  int8_t remotes = router.addRoute("/api/v1/remotes", TEST_GET);
+  int8_t infos = router.addRoute("/api/v1/system/infos", TEST_GET);
+  RouteMatch match;
+
+  TEST_ASSERT_TRUE(router.match("/api/v1/system/infos", TEST_GET, match));
+  TEST_ASSERT_EQUAL(infos, match.route);
+  TEST_ASSERT_EQUAL(0, match.paramsCount);
+
+  TEST_ASSERT_TRUE(router.match("/api/v1/remotes", TEST_GET, match));
+  TEST_ASSERT_EQUAL(remotes, match.route);
+
+  TEST_ASSERT_FALSE(router.match("/api/v1/system", TEST_GET, match));
+  TEST_ASSERT_FALSE(router.match("/api/v1/remotess", TEST_GET, match));
+  TEST_ASSERT_EQUAL(ROUTE_NOT_FOUND, match.route);
+}
+
+void test_METHOD_match_WITH_numbers_SHOULD_capture_them_in_order(void)
+{
+  Router router;
+  router.addRoute("/api/v1/remotes/{id}", TEST_GET);
+  int8_t route = router.addRoute("/api/v1/scenes/{sceneId}/remotes/{remoteId}", TEST_DELETE);
+  RouteMatch match;
+
+  TEST_ASSERT_TRUE(router.match("/api/v1/scenes/3/remotes/4294967295", TEST_DELETE, match));
+  TEST_ASSERT_EQUAL(route, match.route);
+  TEST_ASSERT_EQUAL(2, match.paramsCount);
+  TEST_ASSERT_EQUAL(3, match.params[0]);
+  TEST_ASSERT_EQUAL_UINT32(4294967295, match.params[1]);
+}
+
+void test_METHOD_match_WITH_other_method_SHOULD_return_false(void)
+{
+  Router router;
+  int8_t fetch = router.addRoute("/api/v1/remotes/{id}", TEST_GET);
+  int8_t remove = router.addRoute("/api/v1/remotes/{id}", TEST_DELETE);
+  RouteMatch match;
+
+  TEST_ASSERT_TRUE(router.match("/api/v1/remotes/1", TEST_DELETE, match));
+  TEST_ASSERT_EQUAL(remove, match.route);
+  TEST_ASSERT_TRUE(router.match("/api/v1/remotes/1", TEST_GET, match));
+  TEST_ASSERT_EQUAL(fetch, match.route);
+  TEST_ASSERT_FALSE(router.match("/api/v1/remotes/1", TEST_POST, match));
+}
+
+void test_METHOD_match_WITH_invalid_number_OR_extra_slash_SHOULD_return_false(void)
+{
+  Router router;
+  router.addRoute("/api/v1/remotes/{id}/action", TEST_POST);
+  RouteMatch match;
+
+  TEST_ASSERT_FALSE(router.match("/api/v1/remotes/abc/action", TEST_POST, match));
+  TEST_ASSERT_FALSE(router.match("/api/v1/remotes/-1/action", TEST_POST, match));
+  TEST_ASSERT_FALSE(router.match("/api/v1/remotes/4294967296/action", TEST_POST, match));
+  TEST_ASSERT_FALSE(router.match("/api/v1/remotes//action", TEST_POST, match));
+  TEST_ASSERT_FALSE(router.match("/api/v1/remotes/1/action/", TEST_POST, match));
+  TEST_ASSERT_FALSE(router.match("api/v1/remotes/1/action", TEST_POST, match));
+}
+
+void test_METHOD_match_WITH_literal_AND_capture_SHOULD_prefer_literal(void)
+{
+  Router router;
+  int8_t capture = router.addRoute("/api/v1/commands/{id}", TEST_GET);
+  int8_t literal = router.addRoute("/api/v1/commands/1", TEST_GET);
+  RouteMatch match;
+
+  TEST_ASSERT_TRUE(router.match("/api/v1/commands/1", TEST_GET, match));
+  TEST_ASSERT_EQUAL(literal, match.route);
+  TEST_ASSERT_EQUAL(0, match.paramsCount);
+
+  TEST_ASSERT_TRUE(router.match("/api/v1/commands/12", TEST_GET, match));
+  TEST_ASSERT_EQUAL(capture, match.route);
+  TEST_ASSERT_EQUAL(12, match.params[0]);
+}
+
+void test_METHOD_addRoute_WITH_full_table_SHOULD_return_not_found(void)
+{
+  Router router;
+  for (uint8_t i = 0; i < MAX_ROUTES; i++)
+  {
+    TEST_ASSERT_NOT_EQUAL(ROUTE_NOT_FOUND, router.addRoute("/api/v1/remotes", TEST_GET));
+  }
+
+  TEST_ASSERT_EQUAL(ROUTE_NOT_FOUND, router.addRoute("/api/v1/remotes", TEST_POST));
+  TEST_ASSERT_EQUAL(ROUTE_NOT_FOUND, router.addRoute("api/v1/scenes", TEST_GET));
+}
+
+void test_METHOD_ROUTE_HEADERS_SHOULD_keep_the_headers_read_by_the_handlers(void)
+{
+  // Idempotency-Key was dropped by the server before it was listed, the retries were sent again.
+  const char* expected[] = { "Idempotency-Key", "If-None-Match" };
+  for (const char* header : expected)
+  {
+    bool kept = false;
+    for (uint8_t i = 0; i < ROUTE_HEADERS_COUNT; i++)
+    {
+      kept = kept || strcasecmp(ROUTE_HEADERS[i], header) == 0;
+    }
+    TEST_ASSERT_TRUE_MESSAGE(kept, header);
+  }
+}
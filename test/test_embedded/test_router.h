@@ -0,0 +1,13 @@
+#pragma once
+
+#include <router.h>
+
+void RUN_ROUTER_TESTS(void);
+
+void test_METHOD_match_WITH_literal_path_SHOULD_return_route(void);
+void test_METHOD_match_WITH_numbers_SHOULD_capture_them_in_order(void);
+void test_METHOD_match_WITH_other_method_SHOULD_return_false(void);
+void test_METHOD_match_WITH_invalid_number_OR_extra_slash_SHOULD_return_false(void);
+void test_METHOD_match_WITH_literal_AND_capture_SHOULD_prefer_literal(void);
+void test_METHOD_addRoute_WITH_full_table_SHOULD_return_not_found(void);
+void test_METHOD_ROUTE_HEADERS_SHOULD_keep_the_headers_read_by_the_handlers(void);
@@ -0,0 +1,190 @@
+#include <time.h>
+#include <unity.h>
+#include <Arduino.h>
+
+#include <cron.h>
+#include <schedule.h>
+#include <scheduler.h>
+#include <controller.h>
+#include <timerWheel.h>
+#include <remoteAction.h>
+#include "./test_controller.h"
+#include "./test_scheduler.h"
+
+// Fake Clock, always in UTC
+time_t FakeClock::now() { return this->currentTime; }
+
+void FakeClock::setTimezone(const char* timezone) { }
+
+void FakeClock::toLocalTime(const time_t& time, struct tm& local) { gmtime_r(&time, &local); }
+
+time_t FakeClock::fromLocalTime(struct tm& local)
+{
+  long days = daysFromCivil(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday);
+  return static_cast<time_t>(days) * 24 * 3600 + local.tm_hour * 3600 + local.tm_min * 60
+      + local.tm_sec;
+}
+
+// TEST SCHEDULER
+// ############################################################################
+
+// 2024-06-21 is a friday
+const time_t SOLSTICE_MIDNIGHT = 1718928000;
+
+FakeDatabase schedulerDatabaseFake;
+FakeNetworkClient schedulerNetworkClientFake;
+FakeTransmitter schedulerTransmitterFake;
+FakeSystemManager schedulerSystemManagerFake;
+FakeClock clockFake;
+
+Controller schedulerController(&schedulerDatabaseFake, &schedulerNetworkClientFake,
+    &schedulerTransmitterFake, &schedulerSystemManagerFake);
+Scheduler schedulerTest(&schedulerController, &clockFake);
+
+void RUN_SCHEDULER_TESTS(void)
+{
+  RUN_TEST(test_METHOD_parseCronExpression_WITH_valid_expression_SHOULD_return_true_AND_fill_masks);
+  RUN_TEST(test_METHOD_parseCronExpression_WITH_invalid_expression_SHOULD_return_false);
+  RUN_TEST(
+      test_METHOD_computeSunEvent_WITH_paris_at_summer_solstice_SHOULD_return_sunrise_AND_sunset);
+  RUN_TEST(test_METHOD_computeSunEvent_WITH_polar_day_SHOULD_return_false);
+  RUN_TEST(test_METHOD_computeNextRun_WITH_weekdays_expression_SHOULD_skip_the_weekend);
+  RUN_TEST(test_METHOD_computeNextRun_WITH_sunset_trigger_SHOULD_apply_the_offset);
+  RUN_TEST(test_METHOD_advance_WITH_timers_on_several_levels_SHOULD_expire_them_at_their_tick);
+  RUN_TEST(test_METHOD_advance_WITH_cancelled_timer_SHOULD_not_expire_it);
+  RUN_TEST(test_METHOD_handleSchedules_WITH_clock_not_synced_SHOULD_do_nothing);
+  RUN_TEST(test_METHOD_handleSchedules_WITH_due_schedule_SHOULD_operate_the_remote);
+}
+
+void test_METHOD_parseCronExpression_WITH_valid_expression_SHOULD_return_true_AND_fill_masks(void)
+{
+  CronMasks masks;
+  bool result = parseCronExpression("0,30 7-9 */10 * 1-5", masks);
+
+  TEST_ASSERT_TRUE(result);
+  TEST_ASSERT_TRUE(masks.minutes == ((1ULL << 0) | (1ULL << 30)));
+  TEST_ASSERT_EQUAL(0x380, masks.hours);
+  TEST_ASSERT_EQUAL((1UL << 1) | (1UL << 11) | (1UL << 21) | (1UL << 31), masks.days);
+  TEST_ASSERT_EQUAL(0x1FFE, masks.months);
+  TEST_ASSERT_EQUAL(0x3E, masks.weekdays);
+}
+
+void test_METHOD_parseCronExpression_WITH_invalid_expression_SHOULD_return_false(void)
+{
+  CronMasks masks;
+
+  TEST_ASSERT_FALSE(parseCronExpression("", masks));
+  TEST_ASSERT_FALSE(parseCronExpression("0 8 * *", masks));
+  TEST_ASSERT_FALSE(parseCronExpression("60 8 * * *", masks));
+  TEST_ASSERT_FALSE(parseCronExpression("0 8 0 * *", masks));
+  TEST_ASSERT_FALSE(parseCronExpression("0 8 * * 5-1", masks));
+  TEST_ASSERT_FALSE(parseCronExpression("0 8 * * * *", masks));
+}
+
+void test_METHOD_computeSunEvent_WITH_paris_at_summer_solstice_SHOULD_return_sunrise_AND_sunset(
+    void)
+{
+  int sunrise;
+  int sunset;
+
+  TEST_ASSERT_TRUE(computeSunEvent(2024, 6, 21, 48.8566, 2.3522, true, sunrise));
+  TEST_ASSERT_TRUE(computeSunEvent(2024, 6, 21, 48.8566, 2.3522, false, sunset));
+
+  // 03:47 and 19:58 UTC
+  TEST_ASSERT_INT_WITHIN(3, 227, sunrise);
+  TEST_ASSERT_INT_WITHIN(3, 1198, sunset);
+}
+
+void test_METHOD_computeSunEvent_WITH_polar_day_SHOULD_return_false(void)
+{
+  int minutes;
+
+  TEST_ASSERT_FALSE(computeSunEvent(2024, 6, 21, 78.22, 15.65, true, minutes));
+}
+
+void test_METHOD_computeNextRun_WITH_weekdays_expression_SHOULD_skip_the_weekend(void)
+{
+  Schedule schedule = { 1, 1, RemoteAction::UP, ScheduleTrigger::TIME, 0, "30 7 * * 1-5" };
+  Location location = { 0, 0, "UTC0" };
+  CronMasks masks;
+  parseCronExpression(schedule.cron, masks);
+
+  time_t next = computeNextRun(schedule, masks, location, &clockFake, SOLSTICE_MIDNIGHT + 8 * 3600);
+
+  // Monday 2024-06-24 at 07:30
+  TEST_ASSERT_EQUAL(SOLSTICE_MIDNIGHT + 3 * 24 * 3600 + 7 * 3600 + 30 * 60, next);
+}
+
+void test_METHOD_computeNextRun_WITH_sunset_trigger_SHOULD_apply_the_offset(void)
+{
+  Schedule schedule = { 1, 1, RemoteAction::DOWN, ScheduleTrigger::SUNSET, -30, "* * * * *" };
+  Location location = { 48.8566, 2.3522, "UTC0" };
+  CronMasks masks;
+  parseCronExpression(schedule.cron, masks);
+
+  time_t next
+      = computeNextRun(schedule, masks, location, &clockFake, SOLSTICE_MIDNIGHT + 12 * 3600);
+
+  TEST_ASSERT_INT_WITHIN(180, SOLSTICE_MIDNIGHT + (1198 - 30) * 60, next);
+}
+
+void test_METHOD_advance_WITH_timers_on_several_levels_SHOULD_expire_them_at_their_tick(void)
+{
+  TimerWheel wheel;
+  TimerNode timers[4];
+  const uint32_t expires[4] = { 1005, 1070, 6000, 300000 };
+  uint32_t expired[4] = {};
+
+  wheel.begin(1000);
+  for (unsigned short i = 0; i < 4; ++i)
+  {
+    timers[i].id = i;
+    wheel.schedule(&timers[i], expires[i]);
+  }
+
+  for (uint32_t tick = 1000; tick <= 300000; ++tick)
+  {
+    for (TimerNode* node = wheel.advance(tick); node != nullptr; node = node->next)
+    {
+      expired[node->id] = tick;
+    }
+  }
+
+  TEST_ASSERT_EQUAL_UINT32_ARRAY(expires, expired, 4);
+}
+
+void test_METHOD_advance_WITH_cancelled_timer_SHOULD_not_expire_it(void)
+{
+  TimerWheel wheel;
+  TimerNode timer;
+
+  wheel.begin(1000);
+  wheel.schedule(&timer, 1100);
+  wheel.cancel(&timer);
+
+  TEST_ASSERT_NULL(wheel.advance(1100));
+  TEST_ASSERT_NULL(timer.pprev);
+}
+
+void test_METHOD_handleSchedules_WITH_clock_not_synced_SHOULD_do_nothing(void)
+{
+  clockFake.currentTime = 8 * 3600;
+
+  schedulerTest.handleSchedules();
+
+  TEST_ASSERT_FALSE(FakeTransmitter::sendDOWNCommandCalled);
+}
+
+void test_METHOD_handleSchedules_WITH_due_schedule_SHOULD_operate_the_remote(void)
+{
+  // The fake database has a schedule to close the remote 1 at 08:00
+  clockFake.currentTime = SOLSTICE_MIDNIGHT + 8 * 3600 - 1;
+  schedulerTest.handleSchedules();
+
+  TEST_ASSERT_FALSE(FakeTransmitter::sendDOWNCommandCalled);
+
+  clockFake.currentTime = SOLSTICE_MIDNIGHT + 8 * 3600;
+  schedulerTest.handleSchedules();
+
+  TEST_ASSERT_TRUE(FakeTransmitter::sendDOWNCommandCalled);
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <time.h>
+
+#include <clockAbs.h>
+
+class FakeClock : public ClockAbstract
+{
+  public:
+  // For tests
+  time_t currentTime = 0;
+
+  time_t now();
+  void setTimezone(const char* timezone);
+  void toLocalTime(const time_t& time, struct tm& local);
+  time_t fromLocalTime(struct tm& local);
+};
+
+void RUN_SCHEDULER_TESTS(void);
+
+void test_METHOD_parseCronExpression_WITH_valid_expression_SHOULD_return_true_AND_fill_masks(void);
+void test_METHOD_parseCronExpression_WITH_invalid_expression_SHOULD_return_false(void);
+void test_METHOD_computeSunEvent_WITH_paris_at_summer_solstice_SHOULD_return_sunrise_AND_sunset(
+    void);
+void test_METHOD_computeSunEvent_WITH_polar_day_SHOULD_return_false(void);
+void test_METHOD_computeNextRun_WITH_weekdays_expression_SHOULD_skip_the_weekend(void);
+void test_METHOD_computeNextRun_WITH_sunset_trigger_SHOULD_apply_the_offset(void);
+void test_METHOD_advance_WITH_timers_on_several_levels_SHOULD_expire_them_at_their_tick(void);
+void test_METHOD_advance_WITH_cancelled_timer_SHOULD_not_expire_it(void);
+void test_METHOD_handleSchedules_WITH_clock_not_synced_SHOULD_do_nothing(void);
+void test_METHOD_handleSchedules_WITH_due_schedule_SHOULD_operate_the_remote(void);
@@ -0,0 +1,79 @@
+#include <new>
+#include <malloc.h>
+#include <stdlib.h>
+#include <algorithm>
+
+#include "./allocations.h"
+
+static size_t allocated = 0;
+static size_t peakAllocated = 0;
+
+size_t getAllocation() { return allocated; }
+
+size_t getPeakAllocation() { return peakAllocated; }
+
+size_t resetPeakAllocation()
+{
+  peakAllocated = allocated;
+  return allocated;
+}
+
+extern "C"
+{
+  void* __real_malloc(size_t size);
+  void* __real_calloc(size_t count, size_t size);
+  void* __real_realloc(void* pointer, size_t size);
+  void __real_free(void* pointer);
+
+  static void* track(void* pointer)
+  {
+    if (pointer != nullptr)
+    {
+      allocated += malloc_usable_size(pointer);
+      peakAllocated = std::max(peakAllocated, allocated);
+    }
+    return pointer;
+  }
+
+  void* __wrap_malloc(size_t size) { return track(__real_malloc(size)); }
+
+  void* __wrap_calloc(size_t count, size_t size) { return track(__real_calloc(count, size)); }
+
+  void* __wrap_realloc(void* pointer, size_t size)
+  {
+    const size_t previous = pointer != nullptr ? malloc_usable_size(pointer) : 0;
+    void* reallocated = __real_realloc(pointer, size);
+    if (reallocated == nullptr)
+    {
+      return nullptr; // The previous block is kept
+    }
+    allocated -= previous;
+    return track(reallocated);
+  }
+
+  void __wrap_free(void* pointer)
+  {
+    if (pointer != nullptr)
+    {
+      allocated -= malloc_usable_size(pointer);
+    }
+    __real_free(pointer);
+  }
+}
+
+// The allocations of libstdc++ do not go through the wrapped symbols
+void* operator new(size_t size)
+{
+  void* pointer = malloc(size == 0 ? 1 : size);
+  if (pointer == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* pointer) noexcept { free(pointer); }
+void operator delete[](void* pointer) noexcept { free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { free(pointer); }
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <stddef.h>
+
+// The native build links with --wrap for malloc, calloc, realloc and free: every allocation of
+// the process, including the documents of ArduinoJson, is counted.
+
+size_t getAllocation(); // Bytes allocated now
+size_t getPeakAllocation(); // Most bytes allocated since the last reset
+size_t resetPeakAllocation(); // Returns the bytes allocated now
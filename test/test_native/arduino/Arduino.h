@@ -0,0 +1,289 @@
+#pragma once
+
+// Host stand-in of the parts of the Arduino core used by the controller, the serializer and the
+// database, so they build in the native environment. Not a full core.
+
+#include <chrono>
+#include <string>
+#include <ctype.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef uint8_t byte;
+
+#define DEC 10
+#define HEX 16
+#define BIN 2
+#define PROGMEM
+#define F(string) (string)
+
+inline unsigned long micros()
+{
+  static const auto start = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+inline unsigned long millis() { return micros() / 1000; }
+inline void delay(unsigned long) { }
+inline void yield() { }
+inline long random(long max) { return max > 0 ? rand() % max : 0; }
+inline long random(long min, long max) { return max > min ? min + rand() % (max - min) : min; }
+inline bool isAscii(int c) { return c >= 0 && c < 128; }
+
+class Print
+{
+  public:
+  virtual ~Print() { }
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* buffer, size_t size)
+  {
+    size_t written = 0;
+    while (written < size && this->write(buffer[written]))
+    {
+      written++;
+    }
+    return written;
+  }
+  size_t write(const char* string) { return this->write((const uint8_t*)string, strlen(string)); }
+
+  size_t print(const char* string) { return this->write(string); }
+  size_t print(char c) { return this->write((uint8_t)c); }
+  size_t print(int value) { return this->print((long)value); }
+  size_t print(unsigned int value) { return this->print((unsigned long)value); }
+  size_t print(long value) { return this->printFormat("%ld", value); }
+  size_t print(unsigned long value) { return this->printFormat("%lu", value); }
+  size_t print(unsigned long long value) { return this->printFormat("%llu", value); }
+  size_t print(double value, int digits = 2)
+  {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.*f", digits, value);
+    return this->write(buffer);
+  }
+  size_t println(const char* string) { return this->print(string) + this->print('\n'); }
+
+  private:
+  template <typename T> size_t printFormat(const char* format, T value)
+  {
+    char buffer[24];
+    snprintf(buffer, sizeof(buffer), format, value);
+    return this->write(buffer);
+  }
+};
+
+class String
+{
+  public:
+  String(const char* string = "")
+      : m_string(string == nullptr ? "" : string)
+  {
+  }
+  String(const std::string& string)
+      : m_string(string)
+  {
+  }
+  explicit String(char c)
+      : m_string(1, c)
+  {
+  }
+  explicit String(unsigned char value, unsigned char base = DEC)
+      : String((unsigned long)value, base)
+  {
+  }
+  explicit String(int value, unsigned char base = DEC)
+      : String((long)value, base)
+  {
+  }
+  explicit String(unsigned int value, unsigned char base = DEC)
+      : String((unsigned long)value, base)
+  {
+  }
+  explicit String(long value, unsigned char base = DEC)
+      : m_string(value < 0 && base == DEC ? "-" : "")
+  {
+    this->m_string += toBase(value < 0 && base == DEC ? -(unsigned long)value : value, base);
+  }
+  explicit String(unsigned long value, unsigned char base = DEC)
+      : m_string(toBase(value, base))
+  {
+  }
+  explicit String(float value, unsigned char decimals = 2)
+      : String((double)value, decimals)
+  {
+  }
+  explicit String(double value, unsigned char decimals = 2)
+  {
+    char buffer[48];
+    snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+    this->m_string = buffer;
+  }
+
+  String& operator=(const char* string)
+  {
+    this->m_string = string == nullptr ? "" : string;
+    return *this;
+  }
+
+  const char* c_str() const { return this->m_string.c_str(); }
+  unsigned int length() const { return this->m_string.length(); }
+  bool isEmpty() const { return this->m_string.empty(); }
+  bool reserve(unsigned int size)
+  {
+    this->m_string.reserve(size);
+    return true;
+  }
+
+  bool concat(const char* string)
+  {
+    this->m_string += string == nullptr ? "" : string;
+    return true;
+  }
+  bool concat(const char* string, unsigned int length)
+  {
+    this->m_string.append(string, length);
+    return true;
+  }
+  bool concat(const String& string) { return this->concat(string.c_str()); }
+  bool concat(char c)
+  {
+    this->m_string += c;
+    return true;
+  }
+  String& operator+=(const String& string) { return this->append(string.c_str()); }
+  String& operator+=(const char* string) { return this->append(string); }
+  String& operator+=(char c)
+  {
+    this->m_string += c;
+    return *this;
+  }
+
+  bool equals(const String& string) const { return this->m_string == string.m_string; }
+  bool operator==(const String& string) const { return this->equals(string); }
+  bool operator==(const char* string) const { return this->m_string == string; }
+  bool operator!=(const String& string) const { return !this->equals(string); }
+  bool operator!=(const char* string) const { return this->m_string != string; }
+  bool operator<(const String& string) const { return this->m_string < string.m_string; }
+  char operator[](unsigned int index) const { return this->charAt(index); }
+  char charAt(unsigned int index) const
+  {
+    return index < this->m_string.length() ? this->m_string[index] : '\0';
+  }
+
+  bool startsWith(const String& prefix) const { return this->m_string.rfind(prefix.m_string, 0) == 0; }
+  bool endsWith(const String& suffix) const
+  {
+    return this->m_string.length() >= suffix.m_string.length()
+        && this->m_string.compare(this->m_string.length() - suffix.m_string.length(),
+               suffix.m_string.length(), suffix.m_string)
+        == 0;
+  }
+  int indexOf(char c, unsigned int from = 0) const { return toIndex(this->m_string.find(c, from)); }
+  int indexOf(const String& string, unsigned int from = 0) const
+  {
+    return toIndex(this->m_string.find(string.m_string, from));
+  }
+  int lastIndexOf(char c) const { return toIndex(this->m_string.rfind(c)); }
+  String substring(unsigned int from) const { return this->substring(from, this->length()); }
+  String substring(unsigned int from, unsigned int to) const
+  {
+    if (from > to)
+    {
+      std::swap(from, to);
+    }
+    if (from >= this->m_string.length())
+    {
+      return String();
+    }
+    return String(this->m_string.substr(from, to - from));
+  }
+
+  void toUpperCase()
+  {
+    for (char& c : this->m_string)
+    {
+      c = toupper(c);
+    }
+  }
+  void toLowerCase()
+  {
+    for (char& c : this->m_string)
+    {
+      c = tolower(c);
+    }
+  }
+  void trim()
+  {
+    const size_t first = this->m_string.find_first_not_of(" \t\r\n");
+    const size_t last = this->m_string.find_last_not_of(" \t\r\n");
+    this->m_string = first == std::string::npos ? "" : this->m_string.substr(first, last - first + 1);
+  }
+  long toInt() const { return atol(this->m_string.c_str()); }
+  float toFloat() const { return atof(this->m_string.c_str()); }
+
+  private:
+  std::string m_string;
+
+  String& append(const char* string)
+  {
+    this->concat(string);
+    return *this;
+  }
+
+  static int toIndex(size_t position) { return position == std::string::npos ? -1 : position; }
+
+  static std::string toBase(unsigned long value, unsigned char base)
+  {
+    if (base < 2 || base > 16)
+    {
+      base = DEC;
+    }
+    std::string digits;
+    do
+    {
+      digits.insert(digits.begin(), "0123456789abcdef"[value % base]);
+      value /= base;
+    } while (value > 0);
+    return digits;
+  }
+};
+
+// Result of a concatenation, as in the Arduino core
+class StringSumHelper : public String
+{
+  public:
+  StringSumHelper(const String& string)
+      : String(string)
+  {
+  }
+};
+
+inline StringSumHelper operator+(const String& left, const String& right)
+{
+  StringSumHelper sum(left);
+  sum += right;
+  return sum;
+}
+
+inline StringSumHelper operator+(const String& left, const char* right)
+{
+  StringSumHelper sum(left);
+  sum += right;
+  return sum;
+}
+
+inline StringSumHelper operator+(const char* left, const String& right)
+{
+  StringSumHelper sum(left);
+  sum += right;
+  return sum;
+}
+
+inline StringSumHelper operator+(const String& left, char right)
+{
+  StringSumHelper sum(left);
+  sum += right;
+  return sum;
+}
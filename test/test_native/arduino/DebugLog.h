@@ -0,0 +1,8 @@
+#pragma once
+
+// Logs are left out of the native build, writing them would be most of what is measured.
+#define LOG_ERROR(...) ((void)0)
+#define LOG_WARN(...) ((void)0)
+#define LOG_INFO(...) ((void)0)
+#define LOG_DEBUG(...) ((void)0)
+#define LOG_TRACE(...) ((void)0)
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string.h>
+#include <stdint.h>
+
+// The EEPROM emulated in RAM. A commit copies the buffer into the "flash", as the ESP8266 core
+// does with its sector.
+class EEPROMClass
+{
+  public:
+  static const size_t CAPACITY = 4096;
+
+  EEPROMClass()
+  {
+    // Erased, as a new chip
+    memset(this->m_buffer, 0xFF, CAPACITY);
+    memset(this->m_flash, 0xFF, CAPACITY);
+  }
+
+  void begin(size_t size) { this->m_size = size < CAPACITY ? size : CAPACITY; }
+  size_t length() const { return this->m_size; }
+  uint8_t read(int address) const { return this->m_buffer[address]; }
+  void write(int address, uint8_t value) { this->m_buffer[address] = value; }
+
+  template <typename T> T& get(int address, T& value) const
+  {
+    memcpy(&value, this->m_buffer + address, sizeof(T));
+    return value;
+  }
+
+  template <typename T> const T& put(int address, const T& value)
+  {
+    memcpy(this->m_buffer + address, &value, sizeof(T));
+    return value;
+  }
+
+  bool commit()
+  {
+    memcpy(this->m_flash, this->m_buffer, this->m_size);
+    return true;
+  }
+
+  private:
+  size_t m_size = 0;
+  uint8_t m_buffer[CAPACITY];
+  uint8_t m_flash[CAPACITY];
+};
+
+inline EEPROMClass EEPROM;
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <Arduino.h>
+
+// A String written through Print, as in the ESP8266 core
+class StreamString : public String, public Print
+{
+  public:
+  size_t write(uint8_t c) override
+  {
+    this->concat((char)c);
+    return 1;
+  }
+  size_t write(const uint8_t* buffer, size_t size) override
+  {
+    this->concat((const char*)buffer, size);
+    return size;
+  }
+};
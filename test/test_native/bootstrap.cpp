@@ -0,0 +1,39 @@
+#include <unity.h>
+
+#include "./test_apiLoad.h"
+#include "./test_discoveryBenchmark.h"
+#include "./test_listingBenchmark.h"
+#include "./test_mqttTopicBenchmark.h"
+#include "./test_routerBenchmark.h"
+
+void setUp(void)
+{
+  // set stuff up here
+}
+
+void tearDown(void)
+{
+  // clean stuff up here
+}
+
+void RUN_UNITY_TESTS()
+{
+  UNITY_BEGIN();
+  // Router benchmarks
+  RUN_ROUTER_BENCHMARKS();
+  // REST API load
+  RUN_API_LOAD_BENCHMARKS();
+  // Listings of the REST API
+  RUN_LISTING_BENCHMARKS();
+  // MQTT topic parser
+  RUN_MQTT_TOPIC_BENCHMARKS();
+  // Home Assistant discovery
+  RUN_DISCOVERY_BENCHMARKS();
+  UNITY_END();
+}
+
+int main(int argc, char** argv)
+{
+  RUN_UNITY_TESTS();
+  return 0;
+}
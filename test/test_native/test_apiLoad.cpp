@@ -0,0 +1,347 @@
+#include <unity.h>
+
+#include <chrono>
+#include <vector>
+#include <stdio.h>
+#include <stdint.h>
+#include <algorithm>
+
+#include <Arduino.h>
+#include <StreamString.h>
+
+#include <batch.h>
+#include <router.h>
+#include <controller.h>
+#include <eepromDatabase.h>
+#include <jsonSerializer.h>
+#include <restApi.h>
+#include <chunkedWriter.h>
+#include "./allocations.h"
+#include "./test_apiLoad.h"
+
+// Same bits as the methods of ESPAsyncWebServer
+const uint8_t LOAD_GET = 0b00000001;
+const uint8_t LOAD_POST = 0b00000010;
+const uint8_t LOAD_DELETE = 0b00000100;
+const uint8_t LOAD_PATCH = 0b00010000;
+
+const unsigned long LOAD_ITERATIONS = 2000; // Replays of the whole mix
+const unsigned short LOAD_REMOTES = 4;
+// Host allocations are about twice those of the ESP8266, pointers are 8 bytes.
+const size_t LOAD_MAX_PEAK_ALLOCATION = 16384;
+
+// FAKES
+// ############################################################################
+
+class LoadNetworkClient : public NetworkClientAbstract
+{
+  public:
+  bool connect(const NetworkConfiguration& conf) { return true; }
+  bool connect(const char* ssid, const char* password) { return true; }
+  String getIP() { return "192.168.1.20"; }
+  String getMacAddress() { return "AA:BB:CC:DD:EE:FF"; }
+  bool isConnected() { return true; }
+  void scanNetworks() { }
+  NetworkScan startScan() { return this->getScan(); }
+  bool handleScan() { return false; }
+  NetworkScan getScan() { return NetworkScan { false, true, 0, 0 }; }
+  void getNetworks(Network networks[]) { }
+};
+
+class LoadTransmitter : public TransmitterAbstract
+{
+  public:
+  bool sendUpCmd(const unsigned long remoteId, const unsigned int rollingCode) { return true; }
+  bool sendStopCmd(const unsigned long remoteId, const unsigned int rollingCode) { return true; }
+  bool sendDownCmd(const unsigned long remoteId, const unsigned int rollingCode) { return true; }
+  bool sendProgCmd(const unsigned long remoteId, const unsigned int rollingCode) { return true; }
+};
+
+class LoadSystemManager : public SystemManagerAbstract
+{
+  public:
+  void handleActions() { }
+  void requestRestart() { }
+};
+
+// SERVER SHIM
+// ############################################################################
+
+// The routes of RestApi, called as WebServer does minus ESPAsyncWebServer: the JSON body is parsed
+// once into its fields, the response is a status and a body. The conditional GETs are not
+// emulated, every response is complete.
+typedef Result<ChunkedWriter> (RestApi::*LoadListing)();
+
+struct LoadRoute
+{
+  const char* name;
+  const char* pattern;
+  uint8_t method;
+  ApiHandler handler;
+  LoadListing listing; // Instead of the handler, sent in chunks
+};
+
+// Substituted for "%lu" in the path of a request
+enum class LoadId
+{
+  NONE,
+  REMOTE, // A remote created before the load
+  CREATED, // The last remote created by the load
+  COMMAND, // The last command submitted by the load
+};
+
+struct LoadRequest
+{
+  uint8_t method;
+  const char* path;
+  const char* body;
+  LoadId id;
+  unsigned short status; // Expected
+};
+
+const size_t LOAD_CHUNK_SIZE = 1460; // A TCP segment, as asked by the server
+
+const LoadRoute LOAD_ROUTES[] = {
+  { "GET system/infos", "/api/v1/system/infos", LOAD_GET, &RestApi::fetchSystemInfos, nullptr },
+  { "GET remotes", "/api/v1/remotes", LOAD_GET, nullptr, &RestApi::fetchAllRemotes },
+  { "POST remotes", "/api/v1/remotes", LOAD_POST, &RestApi::createRemote, nullptr },
+  { "GET remotes/{id}", "/api/v1/remotes/{id}", LOAD_GET, &RestApi::fetchRemote, nullptr },
+  { "PATCH remotes/{id}", "/api/v1/remotes/{id}", LOAD_PATCH, &RestApi::updateRemote, nullptr },
+  { "DELETE remotes/{id}", "/api/v1/remotes/{id}", LOAD_DELETE, &RestApi::deleteRemote,
+    nullptr },
+  { "POST remotes/{id}/action", "/api/v1/remotes/{id}/action", LOAD_POST,
+    &RestApi::actionRemote, nullptr },
+  { "GET commands/{id}", "/api/v1/commands/{id}", LOAD_GET, &RestApi::fetchCommand, nullptr },
+  { "GET schedules", "/api/v1/schedules", LOAD_GET, nullptr, &RestApi::fetchAllSchedules },
+  { "GET location", "/api/v1/location", LOAD_GET, &RestApi::fetchLocation, nullptr },
+};
+const uint8_t LOAD_ROUTES_COUNT = sizeof(LOAD_ROUTES) / sizeof(LOAD_ROUTES[0]);
+
+// A dashboard: polling of the remotes and of the commands sent, and a few changes.
+const LoadRequest LOAD_MIX[] = {
+  { LOAD_GET, "/api/v1/remotes", nullptr, LoadId::NONE, 200 },
+  { LOAD_POST, "/api/v1/remotes/%lu/action", "{\"action\":\"up\"}", LoadId::REMOTE, 202 },
+  { LOAD_GET, "/api/v1/commands/%lu", nullptr, LoadId::COMMAND, 200 },
+  { LOAD_GET, "/api/v1/commands/%lu", nullptr, LoadId::COMMAND, 200 },
+  { LOAD_GET, "/api/v1/remotes", nullptr, LoadId::NONE, 200 },
+  { LOAD_GET, "/api/v1/system/infos", nullptr, LoadId::NONE, 200 },
+  { LOAD_POST, "/api/v1/remotes/%lu/action", "{\"action\":\"down\"}", LoadId::REMOTE, 202 },
+  { LOAD_GET, "/api/v1/commands/%lu", nullptr, LoadId::COMMAND, 200 },
+  { LOAD_GET, "/api/v1/remotes/%lu", nullptr, LoadId::REMOTE, 200 },
+  { LOAD_PATCH, "/api/v1/remotes/%lu", "{\"name\":\"Living room\"}", LoadId::REMOTE, 200 },
+  { LOAD_GET, "/api/v1/schedules", nullptr, LoadId::NONE, 200 },
+  { LOAD_POST, "/api/v1/remotes", "{\"name\":\"Load\"}", LoadId::NONE, 200 },
+  { LOAD_DELETE, "/api/v1/remotes/%lu", nullptr, LoadId::CREATED, 200 },
+  { LOAD_GET, "/api/v1/location", nullptr, LoadId::NONE, 200 },
+};
+const uint8_t LOAD_MIX_COUNT = sizeof(LOAD_MIX) / sizeof(LOAD_MIX[0]);
+
+struct LoadSample
+{
+  int8_t route;
+  BatchResponse response;
+  double microseconds;
+  size_t peakAllocation; // Bytes above what was allocated before the request
+};
+
+/**
+ * @brief Read a listing as the server sends it, chunk by chunk.
+ *
+ * @param result The listing
+ * @return The response, its body is the concatenation of the chunks
+ */
+static BatchResponse readListing(Result<ChunkedWriter>& result)
+{
+  if (!result.isSuccess)
+  {
+    return BatchResponse { 400, result.errorMsg };
+  }
+  BatchResponse response = { 200, "" };
+  uint8_t chunk[LOAD_CHUNK_SIZE];
+  size_t length;
+  while ((length = result.data.fill(chunk, sizeof(chunk))) > 0)
+  {
+    response.body.concat((const char*)chunk, length);
+  }
+  return response;
+}
+
+/**
+ * @brief The controller and its database, set up as on a device with a few remotes.
+ *
+ */
+struct LoadFixture
+{
+  EEPROMDatabase database;
+  LoadNetworkClient networkClient;
+  LoadTransmitter transmitter;
+  LoadSystemManager systemManager;
+  Controller controller;
+  JSONSerializer serializer;
+  RestApi api;
+  Router router;
+  unsigned long remote = 0;
+  unsigned long created = 0; // The last remote created by the load
+  unsigned long command = 0; // The last command submitted by the load
+
+  LoadFixture()
+      : database(0x100000)
+      , controller(&database, &networkClient, &transmitter, &systemManager)
+      , api(&controller, &serializer)
+  {
+    this->database.init();
+    for (uint8_t i = 0; i < LOAD_ROUTES_COUNT; i++)
+    {
+      this->router.addRoute(LOAD_ROUTES[i].pattern, LOAD_ROUTES[i].method);
+    }
+    for (unsigned short i = 0; i < LOAD_REMOTES; i++)
+    {
+      this->remote = this->controller.createRemote("Bedroom").data.id;
+    }
+  }
+
+  LoadSample send(const LoadRequest& request)
+  {
+    unsigned long id = 0;
+    switch (request.id)
+    {
+    case LoadId::REMOTE:
+      id = this->remote;
+      break;
+    case LoadId::CREATED:
+      id = this->created;
+      break;
+    case LoadId::COMMAND:
+      id = this->command;
+      break;
+    default:
+      break;
+    }
+    char path[MAX_BATCH_PATH_LENGTH];
+    snprintf(path, sizeof(path), request.path, id);
+    const String body = request.body == nullptr ? "{}" : request.body;
+
+    LoadSample sample;
+    const size_t before = resetPeakAllocation();
+    const auto start = std::chrono::steady_clock::now();
+
+    RouteMatch match;
+    if (this->router.match(path, request.method, match))
+    {
+      const LoadRoute& route = LOAD_ROUTES[match.route];
+      if (route.listing != nullptr)
+      {
+        Result<ChunkedWriter> listing = (this->api.*route.listing)();
+        sample.response = readListing(listing);
+      }
+      else
+      {
+        BodyFields fields;
+        this->serializer.deserializeFields(body.c_str(), fields);
+        sample.response = (this->api.*route.handler)(match, fields);
+      }
+    }
+    else
+    {
+      sample.response = BatchResponse { 404, "" };
+    }
+
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    sample.route = match.route;
+    sample.microseconds = std::chrono::duration<double, std::micro>(elapsed).count();
+    sample.peakAllocation = getPeakAllocation() - before;
+
+    // The ids for the next requests, as a client reads them
+    if (sample.response.location.startsWith("/api/v1/commands/"))
+    {
+      this->command = strtoul(sample.response.location.c_str() + 17, nullptr, 10);
+    }
+    const int created = sample.response.body.indexOf("\"id\":");
+    if (match.route >= 0 && LOAD_ROUTES[match.route].handler == &RestApi::createRemote
+        && created >= 0)
+    {
+      this->created = strtoul(sample.response.body.c_str() + created + 5, nullptr, 10);
+    }
+
+    // The main loop, between two requests
+    this->controller.handleCommands();
+    return sample;
+  }
+};
+
+static double percentile(std::vector<double>& values, const double rank)
+{
+  std::sort(values.begin(), values.end());
+  return values[std::min(values.size() - 1, (size_t)(rank * values.size()))];
+}
+
+// BENCHMARK API LOAD
+// ############################################################################
+
+void RUN_API_LOAD_BENCHMARKS(void)
+{
+  RUN_TEST(test_BENCHMARK_api_WITH_request_mix_SHOULD_answer_as_the_web_server);
+  RUN_TEST(test_BENCHMARK_api_WITH_request_mix_SHOULD_report_latency_and_allocation);
+}
+
+void test_BENCHMARK_api_WITH_request_mix_SHOULD_answer_as_the_web_server(void)
+{
+  LoadFixture fixture;
+
+  for (uint8_t i = 0; i < LOAD_MIX_COUNT; i++)
+  {
+    LoadSample sample = fixture.send(LOAD_MIX[i]);
+
+    TEST_ASSERT_EQUAL_MESSAGE(LOAD_MIX[i].status, sample.response.status, LOAD_MIX[i].path);
+    TEST_ASSERT_TRUE_MESSAGE(sample.response.body.length() > 0, LOAD_MIX[i].path);
+  }
+}
+
+void test_BENCHMARK_api_WITH_request_mix_SHOULD_report_latency_and_allocation(void)
+{
+  LoadFixture fixture;
+  std::vector<double> durations[LOAD_ROUTES_COUNT];
+  size_t peaks[LOAD_ROUTES_COUNT] = {};
+  for (uint8_t i = 0; i < LOAD_ROUTES_COUNT; i++)
+  {
+    durations[i].reserve(LOAD_ITERATIONS * LOAD_MIX_COUNT);
+  }
+
+  double total = 0;
+  for (unsigned long iteration = 0; iteration < LOAD_ITERATIONS; iteration++)
+  {
+    for (uint8_t i = 0; i < LOAD_MIX_COUNT; i++)
+    {
+      LoadSample sample = fixture.send(LOAD_MIX[i]);
+      TEST_ASSERT_EQUAL_MESSAGE(LOAD_MIX[i].status, sample.response.status, LOAD_MIX[i].path);
+
+      durations[sample.route].push_back(sample.microseconds);
+      peaks[sample.route] = std::max(peaks[sample.route], sample.peakAllocation);
+      total += sample.microseconds;
+    }
+  }
+
+  char message[160];
+  for (uint8_t i = 0; i < LOAD_ROUTES_COUNT; i++)
+  {
+    if (durations[i].empty())
+    {
+      continue;
+    }
+    double sum = 0;
+    for (double duration : durations[i])
+    {
+      sum += duration;
+    }
+    snprintf(message, sizeof(message),
+        "%-26s p50: %7.2f us, p99: %7.2f us, %9.0f req/s, peak allocation: %6zu B",
+        LOAD_ROUTES[i].name, percentile(durations[i], 0.50), percentile(durations[i], 0.99),
+        durations[i].size() / sum * 1e6, peaks[i]);
+    TEST_MESSAGE(message);
+
+    TEST_ASSERT_LESS_THAN_MESSAGE(LOAD_MAX_PEAK_ALLOCATION, peaks[i], LOAD_ROUTES[i].name);
+  }
+  snprintf(message, sizeof(message), "mix: %.0f req/s",
+      LOAD_ITERATIONS * LOAD_MIX_COUNT / total * 1e6);
+  TEST_MESSAGE(message);
+}
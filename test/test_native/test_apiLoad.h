@@ -0,0 +1,6 @@
+#pragma once
+
+void RUN_API_LOAD_BENCHMARKS(void);
+
+void test_BENCHMARK_api_WITH_request_mix_SHOULD_answer_as_the_web_server(void);
+void test_BENCHMARK_api_WITH_request_mix_SHOULD_report_latency_and_allocation(void);
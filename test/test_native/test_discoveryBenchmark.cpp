@@ -0,0 +1,67 @@
+#include <unity.h>
+
+#include <chrono>
+#include <stdio.h>
+#include <algorithm>
+
+#include <Arduino.h>
+
+#include <config.h>
+#include <remote.h>
+#include <homeAssistant.h>
+#include "./allocations.h"
+#include "./test_discoveryBenchmark.h"
+
+const unsigned long DISCOVERY_BENCH_ITERATIONS = 2000;
+
+// BENCHMARK HOME ASSISTANT DISCOVERY
+// ############################################################################
+
+void RUN_DISCOVERY_BENCHMARKS(void)
+{
+  RUN_TEST(test_BENCHMARK_writeCoverDiscovery_WITH_all_remotes_SHOULD_not_allocate);
+}
+
+void test_BENCHMARK_writeCoverDiscovery_WITH_all_remotes_SHOULD_not_allocate(void)
+{
+  // A full database, as published on each connection
+  Remote remotes[MAX_REMOTES];
+  for (unsigned short i = 0; i < MAX_REMOTES; i++)
+  {
+    remotes[i].id = 1234567 + i;
+    remotes[i].rollingCode = i;
+    snprintf(remotes[i].name, MAX_REMOTE_NAME_LENGTH, "Shutter \"%u\"", i);
+  }
+  char deviceId[MAX_DEVICE_ID_LENGTH];
+  formatDeviceId(deviceId, "5C:CF:7F:0A:1B:2C");
+  char topic[MAX_MQTT_TOPIC_LENGTH];
+  char buffer[MAX_DISCOVERY_PAYLOAD_LENGTH];
+
+  volatile size_t sink = 0;
+  size_t peakAllocation = 0;
+  size_t longest = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (unsigned long i = 0; i < DISCOVERY_BENCH_ITERATIONS; i++)
+  {
+    const size_t before = resetPeakAllocation();
+    for (const Remote& remote : remotes)
+    {
+      sink = formatCoverDiscoveryTopic(topic, sizeof(topic), remote.id);
+      const size_t length = writeCoverDiscovery(buffer, sizeof(buffer), remote, deviceId);
+      TEST_ASSERT_TRUE(length > 0);
+      longest = std::max(longest, length);
+    }
+    peakAllocation = std::max(peakAllocation, getPeakAllocation() - before);
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  const double perConfig = std::chrono::duration<double, std::nano>(elapsed).count()
+      / (DISCOVERY_BENCH_ITERATIONS * MAX_REMOTES);
+
+  char message[120];
+  snprintf(message, sizeof(message),
+      "discovery: %.0f ns/config, longest payload: %zu B, heap: %zu B", perConfig, longest,
+      peakAllocation);
+  TEST_MESSAGE(message);
+
+  TEST_ASSERT_EQUAL(0, peakAllocation);
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+void RUN_DISCOVERY_BENCHMARKS(void);
+
+void test_BENCHMARK_writeCoverDiscovery_WITH_all_remotes_SHOULD_not_allocate(void);
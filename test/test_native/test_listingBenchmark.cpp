@@ -0,0 +1,168 @@
+#include <unity.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+
+#include <Arduino.h>
+#include <StreamString.h>
+
+#include <config.h>
+#include <remote.h>
+#include <scene.h>
+#include <schedule.h>
+#include <chunkedWriter.h>
+#include <jsonSerializer.h>
+#include "./allocations.h"
+#include "./test_listingBenchmark.h"
+
+// The chunks asked by ESPAsyncWebServer are at most a TCP segment
+const size_t LISTING_CHUNK_SIZE = 1460;
+
+static JSONSerializer listingSerializer;
+
+// HELPERS
+// ############################################################################
+
+struct ListingPeaks
+{
+  size_t buffered;
+  size_t chunked;
+  size_t length;
+};
+
+/**
+ * @brief Peak heap of a listing sent from a stream buffer, as the AsyncResponseStream, and sent
+ * in chunks, as the chunked responses. Both bodies should be the same. The chunked writer holds
+ * a copy of the table, made in the measure.
+ */
+static ListingPeaks measureListing(
+    std::function<void(Print& output)> buffered, std::function<ChunkedWriter()> chunked)
+{
+  ListingPeaks peaks = { 0, 0, 0 };
+
+  size_t before = resetPeakAllocation();
+  String expected;
+  {
+    StreamString output;
+    buffered(output);
+    peaks.buffered = getPeakAllocation() - before;
+    expected = output;
+  }
+
+  String sent;
+  before = resetPeakAllocation();
+  ChunkedWriter writer = chunked();
+  size_t chunkedPeak = getPeakAllocation() - before;
+  const size_t snapshot = getAllocation() - before;
+  while (true)
+  {
+    before = resetPeakAllocation() - snapshot;
+    uint8_t* buffer = (uint8_t*)malloc(LISTING_CHUNK_SIZE); // As the server, for each chunk
+    const size_t length = writer.fill(buffer, LISTING_CHUNK_SIZE);
+    chunkedPeak = std::max(chunkedPeak, getPeakAllocation() - before);
+    // Out of the measure, the client side
+    sent.concat((const char*)buffer, length);
+    free(buffer);
+    if (length == 0)
+    {
+      break;
+    }
+  }
+  peaks.chunked = chunkedPeak;
+  peaks.length = expected.length();
+
+  TEST_ASSERT_EQUAL_STRING(expected.c_str(), sent.c_str());
+  return peaks;
+}
+
+static void reportListing(const char* name, const ListingPeaks& peaks)
+{
+  char message[120];
+  snprintf(message, sizeof(message), "%s: %zu B body, heap: %zu B buffered, %zu B chunked", name,
+      peaks.length, peaks.buffered, peaks.chunked);
+  TEST_MESSAGE(message);
+}
+
+// BENCHMARK LISTINGS
+// ############################################################################
+
+void RUN_LISTING_BENCHMARKS(void)
+{
+  RUN_TEST(test_BENCHMARK_remotes_listing_WITH_full_table_SHOULD_hold_less_in_chunks);
+  RUN_TEST(test_BENCHMARK_scenes_listing_WITH_full_table_SHOULD_hold_less_in_chunks);
+  RUN_TEST(test_BENCHMARK_schedules_listing_WITH_full_table_SHOULD_hold_less_in_chunks);
+}
+
+void test_BENCHMARK_remotes_listing_WITH_full_table_SHOULD_hold_less_in_chunks(void)
+{
+  Remote remotes[MAX_REMOTES];
+  for (unsigned short i = 0; i < MAX_REMOTES; i++)
+  {
+    remotes[i] = { 1234567ul + i, 65000u + i, "", DEFAULT_DEDUP_WINDOW_MS };
+    snprintf(remotes[i].name, MAX_REMOTE_NAME_LENGTH, "Living room %02u", i);
+  }
+
+  ListingPeaks peaks = measureListing(
+      [&](Print& output) { listingSerializer.serializeRemotes(output, remotes, MAX_REMOTES); },
+      [&]()
+      {
+        return ChunkedWriter::jsonArray(MAX_REMOTES,
+            [remotes](const uint8_t index) -> String
+            { return listingSerializer.serializeRemote(remotes[index]); });
+      });
+  reportListing("remotes", peaks);
+
+  TEST_ASSERT_TRUE(peaks.chunked < peaks.buffered);
+}
+
+void test_BENCHMARK_scenes_listing_WITH_full_table_SHOULD_hold_less_in_chunks(void)
+{
+  Scene scenes[MAX_SCENES];
+  for (unsigned short i = 0; i < MAX_SCENES; i++)
+  {
+    scenes[i].id = i + 1;
+    snprintf(scenes[i].name, MAX_SCENE_NAME_LENGTH, "Evening %02u", i);
+    scenes[i].size = MAX_BATCH_OPERATIONS;
+    for (unsigned short j = 0; j < MAX_BATCH_OPERATIONS; j++)
+    {
+      scenes[i].operations[j] = { 1234567ul + j, RemoteAction::DOWN };
+    }
+  }
+
+  ListingPeaks peaks = measureListing(
+      [&](Print& output) { listingSerializer.serializeScenes(output, scenes, MAX_SCENES); },
+      [&]()
+      {
+        return ChunkedWriter::jsonArray(MAX_SCENES,
+            [scenes](const uint8_t index) -> String
+            { return listingSerializer.serializeScene(scenes[index]); });
+      });
+  reportListing("scenes", peaks);
+
+  TEST_ASSERT_TRUE(peaks.chunked < peaks.buffered);
+}
+
+void test_BENCHMARK_schedules_listing_WITH_full_table_SHOULD_hold_less_in_chunks(void)
+{
+  Schedule schedules[MAX_SCHEDULES];
+  for (unsigned short i = 0; i < MAX_SCHEDULES; i++)
+  {
+    schedules[i] = { (unsigned short)(i + 1), 1234567ul + i % MAX_REMOTES, RemoteAction::UP,
+      ScheduleTrigger::SUNRISE, -30, "" };
+    snprintf(schedules[i].cron, MAX_CRON_LENGTH, "0 %u * * 1-5", i % 24);
+  }
+
+  ListingPeaks peaks = measureListing(
+      [&](Print& output)
+      { listingSerializer.serializeSchedules(output, schedules, MAX_SCHEDULES); },
+      [&]()
+      {
+        return ChunkedWriter::jsonArray(MAX_SCHEDULES,
+            [schedules](const uint8_t index) -> String
+            { return listingSerializer.serializeSchedule(schedules[index]); });
+      });
+  reportListing("schedules", peaks);
+
+  TEST_ASSERT_TRUE(peaks.chunked < peaks.buffered);
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+void RUN_LISTING_BENCHMARKS(void);
+
+void test_BENCHMARK_remotes_listing_WITH_full_table_SHOULD_hold_less_in_chunks(void);
+void test_BENCHMARK_scenes_listing_WITH_full_table_SHOULD_hold_less_in_chunks(void);
+void test_BENCHMARK_schedules_listing_WITH_full_table_SHOULD_hold_less_in_chunks(void);
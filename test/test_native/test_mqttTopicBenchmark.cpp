@@ -0,0 +1,155 @@
+#include <unity.h>
+
+#include <regex>
+#include <chrono>
+#include <string>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+
+#include <Arduino.h>
+
+#include <config.h>
+#include <mqttTopic.h>
+#include "./allocations.h"
+#include "./test_mqttTopicBenchmark.h"
+
+const unsigned long MQTT_BENCH_ITERATIONS = 20000;
+
+struct MQTTBenchMessage
+{
+  const char* topic;
+  const char* payload;
+};
+
+// Mostly actions, as sent by a home automation
+const MQTTBenchMessage MQTT_BENCH_MESSAGES[] = {
+  { "esprtsomfy/remotes/1234567/set/action", "up" },
+  { "esprtsomfy/remotes/1234568/set/action", "{\"action\":\"down\",\"idempotency_key\":\"k1\"}" },
+  { "esprtsomfy/remotes/1234567/set/action", "stop" },
+  { "esprtsomfy/remotes/1234569/set/name", "Living room" },
+  { "esprtsomfy/remotes/1234570/set/action", "down" },
+};
+const uint8_t MQTT_BENCH_MESSAGES_COUNT
+    = sizeof(MQTT_BENCH_MESSAGES) / sizeof(MQTT_BENCH_MESSAGES[0]);
+
+struct MQTTBenchResult
+{
+  unsigned long id;
+  bool isAction; // Otherwise a name
+  size_t payloadLength;
+};
+
+/**
+ * @brief The parsing of MQTTClient::receive before the topic parser: a regex compiled for each
+ * message, the topic copied in a std::string and the payload rebuilt char by char.
+ *
+ */
+static MQTTBenchResult parseRegex(const MQTTBenchMessage& message)
+{
+  MQTTBenchResult result = { 0, false, 0 };
+  std::regex remoteIdPattern(R"(/(\d+)/)");
+  std::smatch matches;
+  std::string s(message.topic);
+  if (!std::regex_search(s, matches, remoteIdPattern))
+  {
+    return result;
+  }
+  result.id = strtoul(matches[1].str().c_str(), nullptr, 10);
+
+  const uint8_t* payloadByte = reinterpret_cast<const uint8_t*>(message.payload);
+  String payload = "";
+  for (unsigned int i = 0; i < strlen(message.payload); i++)
+  {
+    payload += (char)payloadByte[i];
+  }
+
+  String endpoint = String(message.topic);
+  int lastSlashPos = endpoint.lastIndexOf('/');
+  String lastElement = endpoint.substring(lastSlashPos + 1);
+  result.isAction = lastElement == "action";
+  result.payloadLength = payload.length();
+  return result;
+}
+
+/**
+ * @brief The parsing of MQTTClient::receive: the topic read in place, the payload copied once on
+ * the stack.
+ *
+ */
+static MQTTBenchResult parseTopic(const MQTTBenchMessage& message)
+{
+  MQTTBenchResult result = { 0, false, 0 };
+  MQTTTopic parsed;
+  if (!parseMQTTTopic(message.topic, parsed))
+  {
+    return result;
+  }
+  result.id = parsed.id;
+  result.isAction = parsed.type == MQTTTopicType::REMOTE_ACTION;
+
+  const size_t length = strlen(message.payload);
+  char payload[MAX_MQTT_PAYLOAD_LENGTH];
+  memcpy(payload, message.payload, length);
+  payload[length] = '\0';
+  result.payloadLength = strlen(payload);
+  return result;
+}
+
+template <typename Function>
+static double nanosecondsPerMessage(Function function, size_t& peakAllocation)
+{
+  volatile unsigned long sink = 0;
+  peakAllocation = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (unsigned long i = 0; i < MQTT_BENCH_ITERATIONS; i++)
+  {
+    const size_t before = resetPeakAllocation();
+    sink = function(MQTT_BENCH_MESSAGES[i % MQTT_BENCH_MESSAGES_COUNT]).id;
+    peakAllocation = std::max(peakAllocation, getPeakAllocation() - before);
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() / MQTT_BENCH_ITERATIONS;
+}
+
+// BENCHMARK MQTT TOPIC
+// ############################################################################
+
+void RUN_MQTT_TOPIC_BENCHMARKS(void)
+{
+  RUN_TEST(test_BENCHMARK_parseMQTTTopic_WITH_messages_SHOULD_agree_with_regex_parsing);
+  RUN_TEST(test_BENCHMARK_parseMQTTTopic_WITH_messages_SHOULD_report_throughput_and_heap);
+}
+
+void test_BENCHMARK_parseMQTTTopic_WITH_messages_SHOULD_agree_with_regex_parsing(void)
+{
+  for (uint8_t i = 0; i < MQTT_BENCH_MESSAGES_COUNT; i++)
+  {
+    MQTTBenchResult expected = parseRegex(MQTT_BENCH_MESSAGES[i]);
+    MQTTBenchResult result = parseTopic(MQTT_BENCH_MESSAGES[i]);
+
+    TEST_ASSERT_EQUAL_MESSAGE(expected.id, result.id, MQTT_BENCH_MESSAGES[i].topic);
+    TEST_ASSERT_EQUAL_MESSAGE(expected.isAction, result.isAction, MQTT_BENCH_MESSAGES[i].topic);
+    TEST_ASSERT_EQUAL_MESSAGE(
+        expected.payloadLength, result.payloadLength, MQTT_BENCH_MESSAGES[i].topic);
+  }
+}
+
+void test_BENCHMARK_parseMQTTTopic_WITH_messages_SHOULD_report_throughput_and_heap(void)
+{
+  size_t topicHeap = 0;
+  size_t regexHeap = 0;
+  const double topic = nanosecondsPerMessage(parseTopic, topicHeap);
+  const double regex = nanosecondsPerMessage(parseRegex, regexHeap);
+
+  char message[160];
+  snprintf(message, sizeof(message),
+      "topic parser: %.0f ns/message (%.0f messages/s, heap: %zu B), regex: %.0f ns/message "
+      "(heap: %zu B)",
+      topic, 1e9 / topic, topicHeap, regex, regexHeap);
+  TEST_MESSAGE(message);
+
+  TEST_ASSERT_EQUAL(0, topicHeap);
+  TEST_ASSERT_TRUE(topic < regex);
+}
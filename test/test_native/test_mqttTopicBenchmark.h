@@ -0,0 +1,6 @@
+#pragma once
+
+void RUN_MQTT_TOPIC_BENCHMARKS(void);
+
+void test_BENCHMARK_parseMQTTTopic_WITH_messages_SHOULD_agree_with_regex_parsing(void);
+void test_BENCHMARK_parseMQTTTopic_WITH_messages_SHOULD_report_throughput_and_heap(void);
@@ -0,0 +1,168 @@
+#include <unity.h>
+
+#include <regex>
+#include <chrono>
+#include <stdio.h>
+#include <stdint.h>
+
+#include <router.h>
+#include "./test_routerBenchmark.h"
+
+// Same bits as the methods of ESPAsyncWebServer
+const uint8_t BENCH_GET = 0b00000001;
+const uint8_t BENCH_POST = 0b00000010;
+const uint8_t BENCH_DELETE = 0b00000100;
+const uint8_t BENCH_PATCH = 0b00010000;
+
+const unsigned long BENCH_ITERATIONS = 20000;
+
+struct BenchRoute
+{
+  const char* pattern;
+  const char* regex; // As registered before the router, nullptr for a plain path
+  uint8_t methods;
+};
+
+struct BenchRequest
+{
+  const char* path;
+  uint8_t method;
+};
+
+// The routes of WebServer::setup, in the same order.
+const BenchRoute BENCH_ROUTES[] = {
+  { "/api/v1/system/restart", nullptr, BENCH_POST },
+  { "/api/v1/system/infos", nullptr, BENCH_GET },
+  { "/api/v1/wifi/networks", nullptr, BENCH_GET },
+  { "/api/v1/wifi/config", nullptr, BENCH_GET },
+  { "/api/v1/wifi/config", nullptr, BENCH_POST },
+  { "/api/v1/mqtt/config", nullptr, BENCH_GET },
+  { "/api/v1/mqtt/config", nullptr, BENCH_POST },
+  { "/api/v1/remotes", "^\\/api/v1/remotes$", BENCH_GET },
+  { "/api/v1/remotes", "^\\/api/v1/remotes$", BENCH_POST },
+  { "/api/v1/remotes/{id}", "^\\/api/v1/remotes\\/([0-9]+)$", BENCH_GET },
+  { "/api/v1/remotes/{id}", "^\\/api/v1/remotes\\/([0-9]+)$", BENCH_PATCH },
+  { "/api/v1/remotes/{id}", "^\\/api/v1/remotes\\/([0-9]+)$", BENCH_DELETE },
+  { "/api/v1/remotes/{id}/action", "^\\/api/v1/remotes\\/([0-9]+)\\/action$", BENCH_POST },
+  { "/api/v1/actions", nullptr, BENCH_POST },
+  { "/api/v1/commands/{id}", "^\\/api/v1/commands\\/([0-9]+)$", BENCH_GET },
+  { "/api/v1/scenes", "^\\/api/v1/scenes$", BENCH_GET },
+  { "/api/v1/scenes", "^\\/api/v1/scenes$", BENCH_POST },
+  { "/api/v1/scenes/{id}", "^\\/api/v1/scenes\\/([0-9]+)$", BENCH_DELETE },
+  { "/api/v1/schedules", "^\\/api/v1/schedules$", BENCH_GET },
+  { "/api/v1/schedules", "^\\/api/v1/schedules$", BENCH_POST },
+  { "/api/v1/schedules/{id}", "^\\/api/v1/schedules\\/([0-9]+)$", BENCH_DELETE },
+  { "/api/v1/location", nullptr, BENCH_GET },
+  { "/api/v1/location", nullptr, BENCH_POST },
+};
+const uint8_t BENCH_ROUTES_COUNT = sizeof(BENCH_ROUTES) / sizeof(BENCH_ROUTES[0]);
+
+// A dashboard mix: mostly polling and actions, a few misses.
+const BenchRequest BENCH_REQUESTS[] = {
+  { "/api/v1/remotes", BENCH_GET },
+  { "/api/v1/remotes/3/action", BENCH_POST },
+  { "/api/v1/commands/1542", BENCH_GET },
+  { "/api/v1/system/infos", BENCH_GET },
+  { "/api/v1/remotes/12", BENCH_PATCH },
+  { "/api/v1/location", BENCH_POST },
+  { "/api/v1/schedules/7", BENCH_DELETE },
+  { "/api/v1/remotes/abc", BENCH_GET },
+  { "/static/js/esprtsomfy.js", BENCH_GET },
+};
+const uint8_t BENCH_REQUESTS_COUNT = sizeof(BENCH_REQUESTS) / sizeof(BENCH_REQUESTS[0]);
+
+/**
+ * @brief Route as the handlers did before the router: each handler in turn checks the method,
+ * then compiles its regex and searches the path, or compares the plain path.
+ *
+ */
+static int8_t matchRegex(const BenchRequest& request)
+{
+  const std::string path(request.path);
+  for (uint8_t i = 0; i < BENCH_ROUTES_COUNT; i++)
+  {
+    if (!(BENCH_ROUTES[i].methods & request.method))
+    {
+      continue;
+    }
+    if (BENCH_ROUTES[i].regex == nullptr)
+    {
+      if (path == BENCH_ROUTES[i].pattern)
+      {
+        return i;
+      }
+      continue;
+    }
+    std::regex pattern(BENCH_ROUTES[i].regex);
+    std::smatch matches;
+    if (std::regex_search(path, matches, pattern))
+    {
+      return i;
+    }
+  }
+  return ROUTE_NOT_FOUND;
+}
+
+static void addRoutes(Router& router)
+{
+  for (uint8_t i = 0; i < BENCH_ROUTES_COUNT; i++)
+  {
+    router.addRoute(BENCH_ROUTES[i].pattern, BENCH_ROUTES[i].methods);
+  }
+}
+
+template <typename Function> static double nanosecondsPerRequest(Function function)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (unsigned long i = 0; i < BENCH_ITERATIONS; i++)
+  {
+    function(BENCH_REQUESTS[i % BENCH_REQUESTS_COUNT]);
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() / BENCH_ITERATIONS;
+}
+
+// BENCHMARK ROUTER
+// ############################################################################
+
+void RUN_ROUTER_BENCHMARKS(void)
+{
+  RUN_TEST(test_BENCHMARK_match_WITH_api_requests_SHOULD_agree_with_regex_routes);
+  RUN_TEST(test_BENCHMARK_match_WITH_api_requests_SHOULD_report_throughput);
+}
+
+void test_BENCHMARK_match_WITH_api_requests_SHOULD_agree_with_regex_routes(void)
+{
+  Router router;
+  addRoutes(router);
+
+  for (uint8_t i = 0; i < BENCH_REQUESTS_COUNT; i++)
+  {
+    RouteMatch match;
+    router.match(BENCH_REQUESTS[i].path, BENCH_REQUESTS[i].method, match);
+
+    TEST_ASSERT_EQUAL_MESSAGE(matchRegex(BENCH_REQUESTS[i]), match.route, BENCH_REQUESTS[i].path);
+  }
+}
+
+void test_BENCHMARK_match_WITH_api_requests_SHOULD_report_throughput(void)
+{
+  Router router;
+  addRoutes(router);
+
+  volatile int8_t sink = 0;
+  const double trie = nanosecondsPerRequest([&](const BenchRequest& request) {
+    RouteMatch match;
+    router.match(request.path, request.method, match);
+    sink = match.route;
+  });
+  const double regex = nanosecondsPerRequest(
+      [&](const BenchRequest& request) { sink = matchRegex(request); });
+
+  char message[128];
+  snprintf(message, sizeof(message), "trie: %.0f ns/request (%.0f req/s), regex: %.0f ns/request",
+      trie, 1e9 / trie, regex);
+  TEST_MESSAGE(message);
+
+  TEST_ASSERT_TRUE(trie < regex);
+}
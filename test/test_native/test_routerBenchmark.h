@@ -0,0 +1,6 @@
+#pragma once
+
+void RUN_ROUTER_BENCHMARKS(void);
+
+void test_BENCHMARK_match_WITH_api_requests_SHOULD_agree_with_regex_routes(void);
+void test_BENCHMARK_match_WITH_api_requests_SHOULD_report_throughput(void);